@@ -0,0 +1,212 @@
+/**
+ * @file BoundaryQuadtree.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the BoundaryQuadtree Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cassert>
+#include "BoundaryQuadtree.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def LEAF_SIZE 16
+ * @brief A Macro that sets the maximal number of boundary pixels in a leaf.
+ */
+#define LEAF_SIZE 16
+
+/**
+ * @def MAX_DEPTH 32
+ * @brief A Macro that sets the maximal depth of the tree.
+ */
+#define MAX_DEPTH 32
+
+/**
+ * @def NO_CHILD -1
+ * @brief A Macro that sets the index of a missing child.
+ */
+#define NO_CHILD (-1)
+
+/**
+ * @def ROOT_NODE 0
+ * @brief A Macro that sets the index of the root node.
+ */
+#define ROOT_NODE 0
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the BoundaryQuadtree.
+ * @param boundary The boundary of the hole.
+ * @param tolerance The ratio between the size of a node and its distance from the
+ *        filled pixel, under which the node is approximated.
+ */
+BoundaryQuadtree::BoundaryQuadtree(const BoundaryArrays &boundary, const float tolerance) :
+        _squaredTolerance(tolerance * tolerance)
+{
+    std::vector<size_t> order(boundary.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    if (!order.empty())
+    {
+        buildNode(boundary, order, 0, order.size(), 0);
+    }
+    _boundary.assign(boundary, order);
+}
+
+/**
+ * @brief Builds the node covering the given range of the order and its subtree.
+ * @param source The boundary in its original order.
+ * @param order The boundary indices, reordered in place so every node is contiguous.
+ * @param begin The index of the first pixel of the node.
+ * @param end The index after the last pixel of the node.
+ * @param depth The depth of the node.
+ * @return The index of the new node.
+ */
+int BoundaryQuadtree::buildNode(const BoundaryArrays &source, std::vector<size_t> &order,
+                                const size_t begin, const size_t end, const int depth)
+{
+    const float *x = source.getX();
+    const float *y = source.getY();
+    const float *values = source.getValues();
+
+    // Compute the aggregated data of the node.
+    Node node;
+    float minX = x[order[begin]];
+    float maxX = minX;
+    float minY = y[order[begin]];
+    float maxY = minY;
+    double sumX = 0;
+    double sumY = 0;
+    double valueSum = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const size_t index = order[i];
+        minX = std::min(minX, x[index]);
+        maxX = std::max(maxX, x[index]);
+        minY = std::min(minY, y[index]);
+        maxY = std::max(maxY, y[index]);
+        sumX += x[index];
+        sumY += y[index];
+        valueSum += values[index];
+    }
+    const double count = (double) (end - begin);
+    const float size = std::max(maxX - minX, maxY - minY);
+    node.centroidX = (float) (sumX / count);
+    node.centroidY = (float) (sumY / count);
+    node.valueSum = (float) valueSum;
+    node.squaredSize = size * size;
+    node.begin = begin;
+    node.end = end;
+    std::fill(node.children, node.children + 4, NO_CHILD);
+
+    const int nodeIndex = (int) _nodes.size();
+    _nodes.push_back(node);
+    if (end - begin <= LEAF_SIZE || depth == MAX_DEPTH || size == 0)
+    {
+        // A leaf, its pixels are summed exactly.
+        return nodeIndex;
+    }
+
+    // Split the range to the 4 quadrants around the center of the bounding box.
+    const float middleX = (minX + maxX) / 2;
+    const float middleY = (minY + maxY) / 2;
+    std::vector<size_t>::iterator first = order.begin() + begin;
+    std::vector<size_t>::iterator last = order.begin() + end;
+    std::vector<size_t>::iterator splitX = std::partition(first, last, [&](const size_t index)
+    {
+        return x[index] < middleX;
+    });
+    std::vector<size_t>::iterator bounds[5];
+    bounds[0] = first;
+    bounds[1] = std::partition(first, splitX, [&](const size_t index)
+    {
+        return y[index] < middleY;
+    });
+    bounds[2] = splitX;
+    bounds[3] = std::partition(splitX, last, [&](const size_t index)
+    {
+        return y[index] < middleY;
+    });
+    bounds[4] = last;
+
+    for (int quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        if (bounds[quadrant] != bounds[quadrant + 1])
+        {
+            const int child = buildNode(source, order, (size_t) (bounds[quadrant] - order.begin()),
+                                        (size_t) (bounds[quadrant + 1] - order.begin()),
+                                        depth + 1);
+            _nodes[nodeIndex].children[quadrant] = child;
+        }
+    }
+    return nodeIndex;
+}
+
+/**
+ * @brief Computes the approximated filled value of the given pixel.
+ * @param kernel The fill kernel of the weighted function.
+ * @param pixel The pixel to fill.
+ * @return The approximated filled value of the pixel.
+ */
+float BoundaryQuadtree::fill(const FillKernel &kernel, const Pixel &pixel) const
+{
+    float numerator = 0;
+    float denominator = 0;
+    if (_nodes.empty())
+    {
+        return numerator;
+    }
+
+    const float x = (float) pixel.getX();
+    const float y = (float) pixel.getY();
+    int nodeStack[4 * MAX_DEPTH + 1];
+    int stackSize = 0;
+    nodeStack[stackSize++] = ROOT_NODE;
+    while (stackSize > 0)
+    {
+        const Node &node = _nodes[nodeStack[--stackSize]];
+        const float dx = node.centroidX - x;
+        const float dy = node.centroidY - y;
+        const float squaredDistance = dx * dx + dy * dy;
+        const bool isLeaf = node.children[0] == NO_CHILD && node.children[1] == NO_CHILD &&
+                            node.children[2] == NO_CHILD && node.children[3] == NO_CHILD;
+
+        if (node.squaredSize < _squaredTolerance * squaredDistance)
+        {
+            // The node is far enough, approximate all of its pixels by its centroid.
+            const float weight = kernel.weight(squaredDistance);
+            numerator += weight * node.valueSum;
+            denominator += weight * (float) (node.end - node.begin);
+        }
+        else if (isLeaf)
+        {
+            kernel.accumulate(_boundary, node.begin, node.end, pixel, numerator, denominator);
+        }
+        else
+        {
+            for (int child : node.children)
+            {
+                if (child != NO_CHILD)
+                {
+                    nodeStack[stackSize++] = child;
+                }
+            }
+        }
+    }
+
+    assert(denominator != 0);
+    return numerator / denominator;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file BoundaryQuadtree.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the BoundaryQuadtree Class.
+ */
+
+
+#ifndef BOUNDARYQUADTREE_H
+#define BOUNDARYQUADTREE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Pixel.h"
+#include "FillKernel.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a quadtree over the boundary pixels of a hole, which
+ *        approximates the fill of a pixel in the manner of Barnes-Hut.
+ *        Every node keeps the number of its boundary pixels, the sum of their values and
+ *        their centroid. Since the weight decays with the distance, a node which is far
+ *        enough from the filled pixel, i.e. its size is smaller than the tolerance times its
+ *        distance, is replaced by a single weight at its centroid for all of its pixels.
+ *        Leaves and near nodes are summed exactly with the fill kernel, so a tolerance of 0
+ *        gives the exact fill, and each pixel costs about O(log m) for a positive tolerance.
+ */
+class BoundaryQuadtree
+{
+public:
+    /**
+     * @brief A Constructor for the BoundaryQuadtree.
+     * @param boundary The boundary of the hole.
+     * @param tolerance The ratio between the size of a node and its distance from the
+     *        filled pixel, under which the node is approximated.
+     */
+    BoundaryQuadtree(const BoundaryArrays &boundary, const float tolerance);
+
+    /**
+     * @brief Computes the approximated filled value of the given pixel.
+     * @param kernel The fill kernel of the weighted function.
+     * @param pixel The pixel to fill.
+     * @return The approximated filled value of the pixel.
+     */
+    float fill(const FillKernel &kernel, const Pixel &pixel) const;
+
+    /**
+     * @brief Returns the number of nodes in the tree.
+     * @return The number of nodes in the tree.
+     */
+    size_t getNodeCount() const { return _nodes.size(); }
+
+private:
+    /**
+     * @brief A node of the tree, which covers a contiguous range of the reordered boundary.
+     */
+    struct Node
+    {
+        float centroidX;  // The X coordinate of the centroid of the node's pixels.
+        float centroidY;  // The Y coordinate of the centroid of the node's pixels.
+        float valueSum;  // The sum of the values of the node's pixels.
+        float squaredSize;  // The squared side of the bounding box of the node's pixels.
+        size_t begin;  // The index of the first pixel of the node.
+        size_t end;  // The index after the last pixel of the node.
+        int children[4];  // The indices of the node's children, negative if missing.
+    };
+
+    /**
+     * @brief Builds the node covering the given range of the order and its subtree.
+     * @param source The boundary in its original order.
+     * @param order The boundary indices, reordered in place so every node is contiguous.
+     * @param begin The index of the first pixel of the node.
+     * @param end The index after the last pixel of the node.
+     * @param depth The depth of the node.
+     * @return The index of the new node.
+     */
+    int buildNode(const BoundaryArrays &source, std::vector<size_t> &order, const size_t begin,
+                  const size_t end, const int depth);
+
+    std::vector<Node> _nodes;  // The nodes of the tree, the root is the first node.
+    BoundaryArrays _boundary;  // The boundary, ordered so every node is a contiguous range.
+    float _squaredTolerance;  // The squared tolerance.
+
+};
+
+
+#endif
\ No newline at end of file
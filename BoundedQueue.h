@@ -0,0 +1,110 @@
+/**
+ * @file BoundedQueue.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the BoundedQueue Class.
+ */
+
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a first-in first-out queue of a bounded size, which passes items
+ *        between the threads of a pipeline. A push blocks while the queue is full, so a fast
+ *        stage can't run ahead of a slow stage by more than the capacity of the queue between
+ *        them, and a pop blocks while the queue is empty until it is closed by the producer.
+ * @tparam T The type of the items, which are moved through the queue.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * @brief A Constructor for the BoundedQueue.
+     * @param capacity The maximal number of items in the queue, at least 1.
+     */
+    explicit BoundedQueue(const size_t capacity) : _capacity(capacity), _closed(false)
+    {
+
+    }
+
+    /**
+     * @brief The queue owns its synchronization, so it can't be copied.
+     */
+    BoundedQueue(const BoundedQueue &other) = delete;
+
+    /**
+     * @brief The queue owns its synchronization, so it can't be copied.
+     */
+    BoundedQueue& operator=(const BoundedQueue &other) = delete;
+
+    /**
+     * @brief Pushes the given item to the back of the queue, and waits while the queue is full.
+     * @param item The item to push.
+     */
+    void push(T &&item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock, [this] { return _items.size() < _capacity; });
+        _items.push_back(std::move(item));
+        _notEmpty.notify_one();
+    }
+
+    /**
+     * @brief Pops the item at the front of the queue, and waits while the queue is empty and
+     *        not closed.
+     * @param item Set to the popped item.
+     * @return true if an item was popped, false if the queue is closed and empty.
+     */
+    bool pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [this] { return !_items.empty() || _closed; });
+        if (_items.empty())
+        {
+            return false;
+        }
+        item = std::move(_items.front());
+        _items.pop_front();
+        _notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Closes the queue, i.e. no more items will be pushed. The items in the queue can
+     *        still be popped.
+     */
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+        _notEmpty.notify_all();
+    }
+
+private:
+    std::deque<T> _items;  // The items in the queue, from the front to the back.
+    size_t _capacity;  // The maximal number of items in the queue.
+    bool _closed;  // Whether no more items will be pushed.
+    std::mutex _mutex;  // Protects the items and the closed flag.
+    std::condition_variable _notFull;  // Notified when an item is popped.
+    std::condition_variable _notEmpty;  // Notified when an item is pushed or the queue closes.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+/**
+ * @file ColorImage.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the ColorImage Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include "ColorImage.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Default Constructor for the ColorImage which creates an empty image.
+ */
+template <typename T>
+BasicColorImage<T>::BasicColorImage() : _data(nullptr), _rows(0), _cols(0), _channels(1),
+                                        _stride(0)
+{
+
+}
+
+/**
+ * @brief A Constructor for the ColorImage, which allocates a new zero initialized buffer
+ *        of the given size owned by this image.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ * @param channels The number of channels, at most MAX_CHANNELS.
+ */
+template <typename T>
+BasicColorImage<T>::BasicColorImage(const int rows, const int cols, const int channels) :
+        _buffer((size_t) rows * cols * channels, 0), _data(_buffer.data()), _rows(rows),
+        _cols(cols), _channels(channels), _stride((size_t) cols * channels)
+{
+    assert(channels >= 1 && channels <= MAX_CHANNELS);
+}
+
+/**
+ * @brief A Constructor for the ColorImage, which wraps a given external buffer without
+ *        copying it.
+ * @param data The external buffer of the image.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ * @param channels The number of channels, at most MAX_CHANNELS.
+ * @param stride The number of values between the beginning of two consecutive rows.
+ */
+template <typename T>
+BasicColorImage<T>::BasicColorImage(T *data, const int rows, const int cols, const int channels,
+                                    const size_t stride) :
+        _data(data), _rows(rows), _cols(cols), _channels(channels), _stride(stride)
+{
+    assert(channels >= 1 && channels <= MAX_CHANNELS);
+}
+
+/**
+ * @brief A Move Constructor for the ColorImage.
+ * @param other The image to move from.
+ */
+template <typename T>
+BasicColorImage<T>::BasicColorImage(BasicColorImage &&other) :
+        _buffer(std::move(other._buffer)), _data(other._data), _rows(other._rows),
+        _cols(other._cols), _channels(other._channels), _stride(other._stride)
+{
+    other._data = nullptr;
+    other._rows = 0;
+    other._cols = 0;
+    other._stride = 0;
+}
+
+/**
+ * @brief Move assignment operator for the ColorImage.
+ * @param other The image to move from.
+ * @return A reference to this image.
+ */
+template <typename T>
+BasicColorImage<T>& BasicColorImage<T>::operator=(BasicColorImage &&other)
+{
+    if (this != &other)
+    {
+        _buffer = std::move(other._buffer);
+        _data = other._data;
+        _rows = other._rows;
+        _cols = other._cols;
+        _channels = other._channels;
+        _stride = other._stride;
+        other._data = nullptr;
+        other._rows = 0;
+        other._cols = 0;
+        other._stride = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Creates a deep copy of this image, which owns a contiguous buffer.
+ * @return The copied image.
+ */
+template <typename T>
+BasicColorImage<T> BasicColorImage<T>::clone() const
+{
+    BasicColorImage copiedImage(_rows, _cols, _channels);
+    for (int x = 0; x < _rows; ++x)
+    {
+        const T *sourceRow = getRow(x);
+        std::copy(sourceRow, sourceRow + (size_t) _cols * _channels, copiedImage.getRow(x));
+    }
+    return copiedImage;
+}
+
+
+/*-----=  Explicit Instantiations  =-----*/
+
+
+template class BasicColorImage<float>;
+template class BasicColorImage<unsigned char>;
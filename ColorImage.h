@@ -0,0 +1,196 @@
+/**
+ * @file ColorImage.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the ColorImage Class.
+ */
+
+
+#ifndef COLORIMAGE_H
+#define COLORIMAGE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Pixel.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MAX_CHANNELS 4
+ * @brief A Macro that sets the maximal number of channels of a multi-channel image.
+ */
+#define MAX_CHANNELS 4
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a multi-channel image of values of the given type, whose
+ *        channels are interleaved (e.g. BGR BGR ...) in one contiguous row-major buffer with a
+ *        stride (the number of values between two consecutive rows), like the data of a
+ *        multi-channel CV Mat object. The image either owns its buffer, or wraps an external
+ *        buffer without copying it, in which case the external buffer must outlive the image.
+ *        The missing pixels of a multi-channel image are always given by a mask.
+ * @tparam T The type of the pixel values, float or unsigned char.
+ */
+template <typename T>
+class BasicColorImage
+{
+public:
+    /**
+     * @brief A Default Constructor for the ColorImage which creates an empty image.
+     */
+    BasicColorImage();
+
+    /**
+     * @brief A Constructor for the ColorImage, which allocates a new zero initialized buffer
+     *        of the given size owned by this image.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     * @param channels The number of channels, at most MAX_CHANNELS.
+     */
+    BasicColorImage(const int rows, const int cols, const int channels);
+
+    /**
+     * @brief A Constructor for the ColorImage, which wraps a given external buffer without
+     *        copying it.
+     * @param data The external buffer of the image.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     * @param channels The number of channels, at most MAX_CHANNELS.
+     * @param stride The number of values between the beginning of two consecutive rows.
+     */
+    BasicColorImage(T *data, const int rows, const int cols, const int channels,
+                    const size_t stride);
+
+    /**
+     * @brief A Move Constructor for the ColorImage.
+     * @param other The image to move from.
+     */
+    BasicColorImage(BasicColorImage &&other);
+
+    /**
+     * @brief Move assignment operator for the ColorImage.
+     * @param other The image to move from.
+     * @return A reference to this image.
+     */
+    BasicColorImage& operator=(BasicColorImage &&other);
+
+    /**
+     * @brief Images are not copied implicitly, use clone() for an explicit deep copy.
+     */
+    BasicColorImage(const BasicColorImage &other) = delete;
+
+    /**
+     * @brief Images are not copied implicitly, use clone() for an explicit deep copy.
+     */
+    BasicColorImage& operator=(const BasicColorImage &other) = delete;
+
+    /**
+     * @brief Creates a deep copy of this image, which owns a contiguous buffer.
+     * @return The copied image.
+     */
+    BasicColorImage clone() const;
+
+    /**
+     * @brief Returns the number of rows in the image.
+     * @return The number of rows in the image.
+     */
+    int getRows() const { return _rows; }
+
+    /**
+     * @brief Returns the number of columns in the image.
+     * @return The number of columns in the image.
+     */
+    int getCols() const { return _cols; }
+
+    /**
+     * @brief Returns the number of channels of every pixel.
+     * @return The number of channels of the image.
+     */
+    int getChannels() const { return _channels; }
+
+    /**
+     * @brief Returns the number of values between the beginning of two consecutive rows.
+     * @return The stride of the image.
+     */
+    size_t getStride() const { return _stride; }
+
+    /**
+     * @brief Returns a pointer to the beginning of the given row.
+     * @param x The row number.
+     * @return A pointer to the first channel of the first pixel in the row.
+     */
+    T *getRow(const int x) { return _data + x * _stride; }
+
+    /**
+     * @brief Returns a pointer to the beginning of the given row.
+     * @param x The row number.
+     * @return A pointer to the first channel of the first pixel in the row.
+     */
+    const T *getRow(const int x) const { return _data + x * _stride; }
+
+    /**
+     * @brief Returns the channels of the pixel at the given coordinates.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     * @return A pointer to the first channel of the pixel.
+     */
+    T *at(const int x, const int y) { return _data + x * _stride + y * _channels; }
+
+    /**
+     * @brief Returns the channels of the pixel at the given coordinates.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     * @return A pointer to the first channel of the pixel.
+     */
+    const T *at(const int x, const int y) const { return _data + x * _stride + y * _channels; }
+
+    /**
+     * @brief Returns the channels of the given pixel.
+     * @param pixel The pixel in the image.
+     * @return A pointer to the first channel of the pixel.
+     */
+    T *at(const Pixel &pixel) { return at(pixel.getX(), pixel.getY()); }
+
+    /**
+     * @brief Returns the channels of the given pixel.
+     * @param pixel The pixel in the image.
+     * @return A pointer to the first channel of the pixel.
+     */
+    const T *at(const Pixel &pixel) const { return at(pixel.getX(), pixel.getY()); }
+
+private:
+    std::vector<T> _buffer;  // The owned buffer, empty when wrapping an external buffer.
+    T *_data;  // The first channel of the first pixel of the image.
+    int _rows;  // The number of rows in the image.
+    int _cols;  // The number of columns in the image.
+    int _channels;  // The number of channels of every pixel.
+    size_t _stride;  // The number of values between two consecutive rows.
+
+};
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A Type Definition for a multi-channel image of floats.
+ */
+typedef BasicColorImage<float> ColorImage;
+
+/**
+ * @brief A Type Definition for a multi-channel image of bytes, e.g. the native data of a
+ *        CV_8UC3 Mat object.
+ */
+typedef BasicColorImage<unsigned char> ByteColorImage;
+
+
+#endif
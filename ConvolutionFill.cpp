@@ -0,0 +1,271 @@
+/**
+ * @file ConvolutionFill.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the ConvolutionFill Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cmath>
+#include "ConvolutionFill.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def TRANSFORM_COUNT 3
+ * @brief A Macro that sets the number of transforms of a fill, the kernel, the boundary image
+ *        and the inverse of their product.
+ */
+#define TRANSFORM_COUNT 3
+
+/**
+ * @def LINE_CHUNK_SIZE 8
+ * @brief A Macro that sets the number of rows or columns transformed by a single task.
+ */
+#define LINE_CHUNK_SIZE 8
+
+/**
+ * @def CONVOLUTION_MIN_WEIGHT_SUM 1e-12
+ * @brief A Macro that sets the smallest sum of the weights of a pixel, relative to the sum of
+ *        the kernel, which the convolution divides by. A smaller sum is lost in the rounding
+ *        errors of the transforms, so the pixel is computed directly.
+ */
+#define CONVOLUTION_MIN_WEIGHT_SUM 1e-12
+
+/**
+ * @def PRODUCT_CHUNK_SIZE 16384
+ * @brief A Macro that sets the number of frequencies multiplied by a single task.
+ */
+#define PRODUCT_CHUNK_SIZE 16384
+
+
+/*-----=  Transform Functions  =-----*/
+
+
+/**
+ * @brief Returns the smallest power of 2 which is at least the given size.
+ * @param size The size.
+ * @return The smallest power of 2 which is at least the size.
+ */
+static size_t nextPowerOfTwo(const size_t size)
+{
+    size_t power = 1;
+    while (power < size)
+    {
+        power *= 2;
+    }
+    return power;
+}
+
+/**
+ * @brief Computes the roots of unity of a transform, exp(-2 * pi * i * k / size) for
+ *        every k in [0,size/2).
+ * @param size The size of the transform, a power of 2.
+ * @return The roots of unity of the transform.
+ */
+static std::vector<Complex> computeTwiddles(const size_t size)
+{
+    const double pi = std::acos(-1.0);
+    std::vector<Complex> twiddles(size / 2);
+    for (size_t k = 0; k < twiddles.size(); ++k)
+    {
+        twiddles[k] = std::polar(1.0, -2 * pi * (double) k / (double) size);
+    }
+    return twiddles;
+}
+
+/**
+ * @brief Computes the FFT of the given line in place, by the iterative radix-2 algorithm.
+ * @param line The line to transform.
+ * @param size The size of the line, a power of 2.
+ * @param twiddles The roots of unity of the transform, see computeTwiddles.
+ * @param inverse Whether to compute the inverse transform (without the 1/size scaling).
+ */
+static void transformLine(Complex *line, const size_t size, const std::vector<Complex> &twiddles,
+                          const bool inverse)
+{
+    // Reorder the line by the bit reversal of the indices.
+    for (size_t i = 1, j = 0; i < size; ++i)
+    {
+        size_t bit = size / 2;
+        for (; j & bit; bit /= 2)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(line[i], line[j]);
+        }
+    }
+
+    // Merge the transforms of the halves, from pairs to the entire line.
+    for (size_t length = 2; length <= size; length *= 2)
+    {
+        const size_t half = length / 2;
+        const size_t twiddleStep = size / length;
+        for (size_t begin = 0; begin < size; begin += length)
+        {
+            for (size_t k = 0; k < half; ++k)
+            {
+                const Complex twiddle = inverse ? std::conj(twiddles[k * twiddleStep]) :
+                                                  twiddles[k * twiddleStep];
+                const Complex even = line[begin + k];
+                const Complex odd = line[begin + k + half] * twiddle;
+                line[begin + k] = even + odd;
+                line[begin + k + half] = even - odd;
+            }
+        }
+    }
+}
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the ConvolutionFill, which sets the box of the given hole.
+ * @param hole The hole to fill.
+ */
+ConvolutionFill::ConvolutionFill(const Hole &hole) : _minX(0), _minY(0), _rows(1), _cols(1)
+{
+    if (hole.getHoleSize() != 0)
+    {
+        const HoleBox box = hole.getHoleBox();
+        int maxX = box.lastRow;
+        int maxY = box.lastCol;
+        _minX = box.firstRow;
+        _minY = box.firstCol;
+        for (const Pixel &x : hole.getHoleBoundary())
+        {
+            _minX = std::min(_minX, x.getX());
+            maxX = std::max(maxX, x.getX());
+            _minY = std::min(_minY, x.getY());
+            maxY = std::max(maxY, x.getY());
+        }
+        _rows = maxX - _minX + 1;
+        _cols = maxY - _minY + 1;
+    }
+    // The offsets within the box are in (-size,size), so the padded box doesn't wrap around.
+    _paddedRows = nextPowerOfTwo(2 * (size_t) _rows - 1);
+    _paddedCols = nextPowerOfTwo(2 * (size_t) _cols - 1);
+}
+
+/**
+ * @brief Returns the estimated cost of the fill, in operations of the transforms.
+ * @return The estimated cost of the fill.
+ */
+double ConvolutionFill::getCost() const
+{
+    const double size = (double) _paddedRows * _paddedCols;
+    return TRANSFORM_COUNT * size * std::max(std::log2(size), 1.0);
+}
+
+/**
+ * @brief Returns the memory used by the transforms.
+ * @return The number of bytes of the transforms.
+ */
+size_t ConvolutionFill::getMemorySize() const
+{
+    return (2 * _paddedRows * _paddedCols + (_paddedRows + _paddedCols) / 2) * sizeof(Complex);
+}
+
+/**
+ * @brief Computes the 2D FFT of the given padded image in place, rows then columns.
+ * @param data The padded image.
+ * @param inverse Whether to compute the inverse transform (without the 1/B scaling).
+ * @param threadPool The threads used in the transform.
+ */
+void ConvolutionFill::transform(std::vector<Complex> &data, const bool inverse,
+                                ThreadPool &threadPool) const
+{
+    threadPool.parallelFor(_paddedRows, LINE_CHUNK_SIZE, [&](const size_t begin, const size_t end)
+    {
+        for (size_t row = begin; row < end; ++row)
+        {
+            transformLine(data.data() + row * _paddedCols, _paddedCols, _rowTwiddles, inverse);
+        }
+    });
+    threadPool.parallelFor(_paddedCols, LINE_CHUNK_SIZE, [&](const size_t begin, const size_t end)
+    {
+        // The columns are strided, so every column is transformed in a contiguous copy.
+        std::vector<Complex> column(_paddedRows);
+        for (size_t col = begin; col < end; ++col)
+        {
+            for (size_t row = 0; row < _paddedRows; ++row)
+            {
+                column[row] = data[row * _paddedCols + col];
+            }
+            transformLine(column.data(), _paddedRows, _colTwiddles, inverse);
+            for (size_t row = 0; row < _paddedRows; ++row)
+            {
+                data[row * _paddedCols + col] = column[row];
+            }
+        }
+    });
+}
+
+/**
+ * @brief Convolves the boundary of the hole with the kernel and computes the hole pixels.
+ * @param hole The hole in the image.
+ * @param boundaryValues The values of the boundary pixels.
+ * @param values Set to the values of the hole pixels.
+ * @param unresolved Set to the indices of the hole pixels whose sum of weights is lost in the
+ *        rounding errors of the transforms, see CONVOLUTION_MIN_WEIGHT_SUM.
+ * @param threadPool The threads used in the transforms.
+ */
+void ConvolutionFill::convolve(const Hole &hole, const std::vector<float> &boundaryValues,
+                               std::vector<float> &values, std::vector<size_t> &unresolved,
+                               ThreadPool &threadPool)
+{
+    _rowTwiddles = computeTwiddles(_paddedCols);
+    _colTwiddles = computeTwiddles(_paddedRows);
+
+    // The real part is the boundary values image, the imaginary part is the indicator image.
+    const holeSet &boundaryPixels = hole.getHoleBoundary();
+    _signal.assign(_paddedRows * _paddedCols, Complex());
+    for (size_t j = 0; j < boundaryPixels.size(); ++j)
+    {
+        const Pixel &y = boundaryPixels[j];
+        const size_t index = (size_t) (y.getX() - _minX) * _paddedCols + (y.getY() - _minY);
+        _signal[index] = Complex(boundaryValues[j], 1);
+    }
+
+    // The kernel is real, so the product keeps the two convolutions apart.
+    transform(_kernel, false, threadPool);
+    transform(_signal, false, threadPool);
+    // The first frequency of the kernel is the sum of it's weights, and the sums of the
+    // inverse transform are scaled by B.
+    const double minWeightSum = CONVOLUTION_MIN_WEIGHT_SUM * _kernel[0].real() *
+                                (double) _signal.size();
+    threadPool.parallelFor(_signal.size(), PRODUCT_CHUNK_SIZE, [&](const size_t begin,
+                                                                  const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            _signal[i] *= _kernel[i];
+        }
+    });
+    transform(_signal, true, threadPool);
+
+    // The 1/B scaling of the inverse transform cancels out in the fill.
+    values.resize(hole.getHoleSize());
+    unresolved.clear();
+    hole.forEachHolePixel([&](const size_t i, const Pixel &x)
+    {
+        const Complex &sums = _signal[(size_t) (x.getX() - _minX) * _paddedCols +
+                                      (x.getY() - _minY)];
+        if (sums.imag() < minWeightSum)
+        {
+            unresolved.push_back(i);
+            return;
+        }
+        values[i] = (float) (sums.real() / sums.imag());
+    });
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+/**
+ * @file ConvolutionFill.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the ConvolutionFill Class.
+ */
+
+
+#ifndef CONVOLUTIONFILL_H
+#define CONVOLUTIONFILL_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "Hole.h"
+#include "ThreadPool.h"
+#include "WeightFunctions.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def UNRESOLVED_CHUNK_SIZE 64
+ * @brief A Macro that sets the number of pixels which the transforms can't resolve computed
+ *        directly by a single task.
+ */
+#define UNRESOLVED_CHUNK_SIZE 64
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A Type Definition for a complex number of the transforms.
+ */
+typedef std::complex<double> Complex;
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class which computes the exact fill of a hole as a convolution.
+ *        The numerator of the fill, sum of w(x-y) * I(y), is the convolution of the
+ *        boundary values image with the weight kernel w, and the denominator, sum of
+ *        w(x-y), is the convolution of the boundary indicator image with w. Both images are
+ *        packed into one complex image (values + i * indicator) over the bounding box of the
+ *        hole, zero padded to a power of 2 of at least twice its size so the circular
+ *        convolution doesn't wrap around, and the convolution is computed by a radix-2 FFT
+ *        of the image and of the kernel, a product and an inverse FFT. The transforms are
+ *        computed in double, since the far weights are much smaller than the near ones.
+ *        This costs O(B * log(B)) for a padded box of B pixels instead of O(n * m). A pixel
+ *        whose weights are lost in the rounding errors of the transforms, which happens far
+ *        from the boundary with a weighted function which decays fast like the gaussian, is
+ *        computed directly instead.
+ */
+class ConvolutionFill
+{
+public:
+    /**
+     * @brief A Constructor for the ConvolutionFill, which sets the box of the given hole.
+     * @param hole The hole to fill.
+     */
+    explicit ConvolutionFill(const Hole &hole);
+
+    /**
+     * @brief Returns the estimated cost of the fill, in operations of the transforms.
+     * @return The estimated cost of the fill.
+     */
+    double getCost() const;
+
+    /**
+     * @brief Returns the memory used by the transforms.
+     * @return The number of bytes of the transforms.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Fill the hole of the given image with the given weighted function.
+     * @tparam T The type of the pixel values of the image.
+     * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+     * @param image The image to fix.
+     * @param hole The hole in the image, the same hole given to the constructor.
+     * @param weightedFunction The weighted function used in the fill process.
+     * @param threadPool The threads used in the transforms.
+     */
+    template <typename T, typename WeightFunction>
+    void fill(BasicImage<T> &image, const Hole &hole, const WeightFunction &weightedFunction,
+              ThreadPool &threadPool)
+    {
+        // Set the kernel at every offset x-y within the box, negative offsets wrap around.
+        _kernel.assign(_paddedRows * _paddedCols, Complex());
+        for (int dx = 1 - _rows; dx < _rows; ++dx)
+        {
+            const size_t kernelRow = (size_t) ((dx + (int) _paddedRows) % (int) _paddedRows);
+            for (int dy = 1 - _cols; dy < _cols; ++dy)
+            {
+                const size_t kernelCol = (size_t) ((dy + (int) _paddedCols) % (int) _paddedCols);
+                _kernel[kernelRow * _paddedCols + kernelCol] = weightedFunction(Pixel(dx, dy),
+                                                                                Pixel());
+            }
+        }
+        const holeSet &boundaryPixels = hole.getHoleBoundary();
+        std::vector<float> boundaryValues;
+        boundaryValues.reserve(boundaryPixels.size());
+        for (const Pixel &y : boundaryPixels)
+        {
+            boundaryValues.push_back(image.at(y));
+        }
+        std::vector<float> values;
+        std::vector<size_t> unresolved;
+        convolve(hole, boundaryValues, values, unresolved, threadPool);
+
+        // The pixels the transforms can't resolve are computed directly.
+        threadPool.parallelFor(unresolved.size(), UNRESOLVED_CHUNK_SIZE, [&](const size_t begin,
+                                                                             const size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+                const Pixel x = hole.getHolePixel(unresolved[k]);
+                float numerator = 0;
+                float denominator = 0;
+                for (size_t j = 0; j < boundaryPixels.size(); ++j)
+                {
+                    const float weightedValue = weightedFunction(x, boundaryPixels[j]);
+                    numerator += weightedValue * boundaryValues[j];
+                    denominator += weightedValue;
+                }
+                if (denominator < MIN_WEIGHT_SUM)
+                {
+                    // All the weights underflowed, so the pixel takes the limit of the fill.
+                    numerator = 0;
+                    denominator = 0;
+                    forEachNearestPixel(x, boundaryPixels, [&](const size_t j)
+                    {
+                        numerator += boundaryValues[j];
+                        ++denominator;
+                    });
+                }
+                values[unresolved[k]] = numerator / denominator;
+            }
+        });
+        hole.forEachHolePixel([&](const size_t i, const Pixel &x)
+        {
+            image.at(x) = toPixelValue<T>(values[i]);
+        });
+    }
+
+private:
+    /**
+     * @brief Convolves the boundary of the hole with the kernel and computes the hole pixels.
+     * @param hole The hole in the image.
+     * @param boundaryValues The values of the boundary pixels.
+     * @param values Set to the values of the hole pixels.
+     * @param unresolved Set to the indices of the hole pixels whose sum of weights is lost in
+     *        the rounding errors of the transforms, see CONVOLUTION_MIN_WEIGHT_SUM.
+     * @param threadPool The threads used in the transforms.
+     */
+    void convolve(const Hole &hole, const std::vector<float> &boundaryValues,
+                  std::vector<float> &values, std::vector<size_t> &unresolved,
+                  ThreadPool &threadPool);
+
+    /**
+     * @brief Computes the 2D FFT of the given padded image in place, rows then columns.
+     * @param data The padded image.
+     * @param inverse Whether to compute the inverse transform (without the 1/B scaling).
+     * @param threadPool The threads used in the transform.
+     */
+    void transform(std::vector<Complex> &data, const bool inverse, ThreadPool &threadPool) const;
+
+    int _minX;  // The first row of the box.
+    int _minY;  // The first column of the box.
+    int _rows;  // The number of rows in the box.
+    int _cols;  // The number of columns in the box.
+    size_t _paddedRows;  // The number of rows in the padded box.
+    size_t _paddedCols;  // The number of columns in the padded box.
+    std::vector<Complex> _rowTwiddles;  // The roots of unity of the transforms of the rows.
+    std::vector<Complex> _colTwiddles;  // The roots of unity of the transforms of the columns.
+    std::vector<Complex> _kernel;  // The padded kernel, and then its transform.
+    std::vector<Complex> _signal;  // The padded boundary image, and then its convolution.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @file FillConfig.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the parameters of a hole fill.
+ */
+
+
+#ifndef FILLCONFIG_H
+#define FILLCONFIG_H
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def DEFAULT_EPSILON 1e-6
+ * @brief A Macro that sets the default epsilon value of the inverse power weighted function.
+ */
+#define DEFAULT_EPSILON 1e-6f
+
+/**
+ * @def DEFAULT_Z 2
+ * @brief A Macro that sets the default z value of the inverse power weighted function.
+ */
+#define DEFAULT_Z 2.0f
+
+/**
+ * @def DEFAULT_SIGMA 1
+ * @brief A Macro that sets the default standard deviation of the gaussian weighted function.
+ */
+#define DEFAULT_SIGMA 1.0f
+
+/**
+ * @def MIN_SIGMA 0.25
+ * @brief A Macro that sets the smallest standard deviation of the gaussian weighted function,
+ *        for which the weights of the neighbours of a pixel don't underflow. A smaller sigma is
+ *        raised to it.
+ */
+#define MIN_SIGMA 0.25f
+
+/**
+ * @def DEFAULT_CONNECTIVITY 8
+ * @brief A Macro that sets the default pixel connectivity value.
+ */
+#define DEFAULT_CONNECTIVITY 8
+
+/**
+ * @def DEFAULT_TOLERANCE 0.5
+ * @brief A Macro that sets the default error tolerance of the approximate fill.
+ */
+#define DEFAULT_TOLERANCE 0.5f
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The strategies which can be used to fill the holes.
+ */
+enum FillStrategy
+{
+    EXACT_FILL,  // The exact fill, using all the pixels in the boundary.
+    NEIGHBOURS_FILL,  // The approximate fill, using only the neighbours of every pixel.
+    APPROXIMATE_FILL,  // The approximate fill, using a quadtree over the boundary.
+    PYRAMID_FILL,  // The approximate fill, from a coarse exact fill refined level by level.
+    AUTO_FILL  // The exact fill, or the quadtree fill for a hole whose exact fill costs too much.
+};
+
+/**
+ * @brief The weighted functions which can be used to fill the holes, see WeightFunctions.h.
+ */
+enum WeightType
+{
+    INVERSE_POWER_WEIGHT,  // w(x,y) = 1 / (|x-y|^z + epsilon).
+    GAUSSIAN_WEIGHT  // w(x,y) = exp(-|x-y|^2 / (2 * sigma^2)).
+};
+
+/**
+ * @brief Whether the holes of the exact fill are filled as convolutions, see ConvolutionFill.
+ */
+enum ConvolutionMode
+{
+    AUTO_CONVOLUTION,  // A hole is filled as a convolution if it is estimated to be faster.
+    ALWAYS_CONVOLUTION,  // Every hole is filled as a convolution.
+    NEVER_CONVOLUTION  // Every hole is filled directly.
+};
+
+/**
+ * @brief Where the holes of the exact fill are filled, see GpuFill. Without a device, every
+ *        hole is filled on the CPU.
+ */
+enum FillDevice
+{
+    AUTO_DEVICE,  // A hole is filled on the GPU if it is large enough to be faster there.
+    CPU_DEVICE,  // Every hole is filled on the CPU.
+    GPU_DEVICE  // Every hole is filled on the GPU.
+};
+
+
+/*-----=  Struct Definition  =-----*/
+
+
+/**
+ * @brief The parameters of a single fill, passed to every fill call instead of being kept in
+ *        global variables, so fills with different parameters may run concurrently.
+ */
+struct FillConfig
+{
+    /**
+     * @brief A Constructor for the FillConfig which sets the default parameters.
+     */
+    FillConfig() : epsilon(DEFAULT_EPSILON), z(DEFAULT_Z), sigma(DEFAULT_SIGMA),
+                   connectivity(DEFAULT_CONNECTIVITY), strategy(EXACT_FILL),
+                   weight(INVERSE_POWER_WEIGHT), tolerance(DEFAULT_TOLERANCE),
+                   convolution(AUTO_CONVOLUTION), device(AUTO_DEVICE) {}
+
+    float epsilon;  // The epsilon value of the inverse power weighted function.
+    float z;  // The z value of the inverse power weighted function.
+    float sigma;  // The standard deviation of the gaussian weighted function.
+    int connectivity;  // The pixel connectivity value, 4 or 8.
+    FillStrategy strategy;  // The strategy used to fill the holes.
+    WeightType weight;  // The weighted function used to fill the holes.
+    float tolerance;  // The error tolerance of the approximate fill.
+    ConvolutionMode convolution;  // Whether the holes of the exact fill are convolutions.
+    FillDevice device;  // Where the holes of the exact fill are filled.
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,759 @@
+/**
+ * @file FillKernel.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the vectorized fill kernel implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "FillKernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FILL_KERNEL_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define FILL_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def GENERAL_ROOT 0
+ * @brief A Macro that sets the base root value for z values which are computed with pow.
+ */
+#define GENERAL_ROOT 0
+
+/**
+ * @def MAX_SPECIALISED_POWER 16
+ * @brief A Macro that sets the maximal z value which is computed by multiplications, for an
+ *        integer or a half-integer z. The integer power of the base root is z/2 (up to 8) for
+ *        an even z, z (up to 15) for an odd z and 2z (up to 31) for a half-integer z.
+ */
+#define MAX_SPECIALISED_POWER 16
+
+/**
+ * @def BOUNDARY_TILE_SIZE 1024
+ * @brief A Macro that sets the number of boundary pixels of a tile of the blocked kernel,
+ *        whose 3 arrays of floats take 12KB and fit the L1 cache (with a single channel).
+ */
+#define BOUNDARY_TILE_SIZE 1024
+
+/**
+ * @def KERNEL_ENTRY(name, Kernel)
+ * @brief A Macro that sets the kernel entry of an instruction set, with the instantiations of
+ *        the kernel template for 1 to MAX_CHANNELS channels.
+ */
+#define KERNEL_ENTRY(name, Kernel) {name, {Kernel<1>, Kernel<2>, Kernel<3>, Kernel<4>}}
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A Type Definition for a kernel which accumulates the weighted sums of a pixel
+ *        over a range of the boundary, into every channel of the boundary values.
+ */
+typedef void (*AccumulateFunction)(const FillKernel::Parameters &parameters, const float *boundaryX,
+                                   const float *boundaryY, const float *boundaryValues,
+                                   const size_t valuesStride, const size_t count, const float x,
+                                   const float y, float *numerators, float &denominator);
+
+
+/*-----=  Boundary Arrays Implementation  =-----*/
+
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and their values in the image.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ * @param x Set to the X coordinates of the boundary pixels.
+ * @param y Set to the Y coordinates of the boundary pixels.
+ * @param values Set to the values of the boundary pixels.
+ */
+template <typename T>
+static void assignBoundary(const BasicImage<T> &image, const holeSet &boundary,
+                           std::vector<float> &x, std::vector<float> &y,
+                           std::vector<float> &values)
+{
+    x.resize(boundary.size());
+    y.resize(boundary.size());
+    values.resize(boundary.size());
+    for (size_t i = 0; i < boundary.size(); ++i)
+    {
+        x[i] = (float) boundary[i].getX();
+        y[i] = (float) boundary[i].getY();
+        values[i] = image.at(boundary[i]);
+    }
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and the values of all their channels
+ *        in the multi-channel image. The interleaved channels of the image are split into a
+ *        plane of values per channel.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ * @param x Set to the X coordinates of the boundary pixels.
+ * @param y Set to the Y coordinates of the boundary pixels.
+ * @param values Set to the values of the boundary pixels, channel after channel.
+ */
+template <typename T>
+static void assignBoundary(const BasicColorImage<T> &image, const holeSet &boundary,
+                           std::vector<float> &x, std::vector<float> &y,
+                           std::vector<float> &values)
+{
+    const size_t count = boundary.size();
+    const int channels = image.getChannels();
+    x.resize(count);
+    y.resize(count);
+    values.resize(count * channels);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = (float) boundary[i].getX();
+        y[i] = (float) boundary[i].getY();
+        const T *pixelValues = image.at(boundary[i]);
+        for (int c = 0; c < channels; ++c)
+        {
+            values[c * count + i] = pixelValues[c];
+        }
+    }
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and their values in the image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ */
+void BoundaryArrays::assign(const Image &image, const holeSet &boundary)
+{
+    _channels = 1;
+    assignBoundary(image, boundary, _x, _y, _values);
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and their values in the byte image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ */
+void BoundaryArrays::assign(const ByteImage &image, const holeSet &boundary)
+{
+    _channels = 1;
+    assignBoundary(image, boundary, _x, _y, _values);
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and their values in the 16-bit image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ */
+void BoundaryArrays::assign(const ShortImage &image, const holeSet &boundary)
+{
+    _channels = 1;
+    assignBoundary(image, boundary, _x, _y, _values);
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and the values of all their
+ *        channels in the multi-channel image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ */
+void BoundaryArrays::assign(const ColorImage &image, const holeSet &boundary)
+{
+    _channels = image.getChannels();
+    assignBoundary(image, boundary, _x, _y, _values);
+}
+
+/**
+ * @brief Sets the arrays from the given boundary pixels and the values of all their
+ *        channels in the multi-channel byte image.
+ * @param image The image containing the boundary.
+ * @param boundary The boundary pixels.
+ */
+void BoundaryArrays::assign(const ByteColorImage &image, const holeSet &boundary)
+{
+    _channels = image.getChannels();
+    assignBoundary(image, boundary, _x, _y, _values);
+}
+
+/**
+ * @brief Sets the arrays from the given arrays, reordered by the given order.
+ * @param source The arrays to copy.
+ * @param order The indices in the source arrays, by their new order.
+ */
+void BoundaryArrays::assign(const BoundaryArrays &source, const std::vector<size_t> &order)
+{
+    _channels = source._channels;
+    _x.resize(order.size());
+    _y.resize(order.size());
+    _values.resize(order.size() * _channels);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        _x[i] = source._x[order[i]];
+        _y[i] = source._y[order[i]];
+        for (int c = 0; c < _channels; ++c)
+        {
+            _values[c * order.size() + i] = source._values[c * source.size() + order[i]];
+        }
+    }
+}
+
+
+/*-----=  Scalar Kernel  =-----*/
+
+
+/**
+ * @brief Computes |x-y|^z from the squared distance according to the kernel parameters.
+ * @param parameters The kernel parameters.
+ * @param squaredDistance The squared distance between the pixels.
+ * @return The distance raised to the power of z.
+ */
+static inline float scalarDistancePower(const FillKernel::Parameters &parameters,
+                                        const float squaredDistance)
+{
+    float base = squaredDistance;
+    switch (parameters.baseRoot)
+    {
+        case GENERAL_ROOT:
+            return std::pow(squaredDistance, parameters.halfZ);
+        case 2:
+            base = std::sqrt(squaredDistance);
+            break;
+        case 4:
+            base = std::sqrt(std::sqrt(squaredDistance));
+            break;
+        default:
+            break;
+    }
+    float result = 1;
+    for (int power = parameters.power; power != 0; power >>= 1)
+    {
+        if (power & 1)
+        {
+            result *= base;
+        }
+        base *= base;
+    }
+    return result;
+}
+
+/**
+ * @brief The portable kernel which accumulates the weighted sums one boundary pixel at a time.
+ *        It is also used for the remainder of the vectorized kernels. The kernels are templates
+ *        of the number of channels, whose values are at valuesStride from each other, so the
+ *        weight of every pair is computed once for all the channels.
+ * @tparam Channels The number of channels of the boundary values.
+ */
+template <int Channels>
+static void accumulateScalar(const FillKernel::Parameters &parameters, const float *boundaryX,
+                             const float *boundaryY, const float *boundaryValues,
+                             const size_t valuesStride, const size_t count, const float x,
+                             const float y, float *numerators, float &denominator)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float dx = boundaryX[i] - x;
+        const float dy = boundaryY[i] - y;
+        const float weight = 1 / (scalarDistancePower(parameters, dx * dx + dy * dy) +
+                                  parameters.epsilon);
+        for (int c = 0; c < Channels; ++c)
+        {
+            numerators[c] += weight * boundaryValues[c * valuesStride + i];
+        }
+        denominator += weight;
+    }
+}
+
+
+/*-----=  x86 Kernels  =-----*/
+
+
+#ifdef FILL_KERNEL_X86
+
+/**
+ * @brief The SSE2 kernel, 4 boundary pixels at a time.
+ * @tparam Channels The number of channels of the boundary values.
+ */
+template <int Channels>
+static void accumulateSse2(const FillKernel::Parameters &parameters, const float *boundaryX,
+                           const float *boundaryY, const float *boundaryValues,
+                           const size_t valuesStride, const size_t count, const float x,
+                           const float y, float *numerators, float &denominator)
+{
+    const __m128 pixelX = _mm_set1_ps(x);
+    const __m128 pixelY = _mm_set1_ps(y);
+    const __m128 epsilon = _mm_set1_ps(parameters.epsilon);
+    const __m128 one = _mm_set1_ps(1);
+    __m128 channelNumerators[Channels];
+    for (int c = 0; c < Channels; ++c)
+    {
+        channelNumerators[c] = _mm_setzero_ps();
+    }
+    __m128 denominators = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(boundaryX + i), pixelX);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(boundaryY + i), pixelY);
+        __m128 base = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        if (parameters.baseRoot >= 2)
+        {
+            base = _mm_sqrt_ps(base);
+        }
+        if (parameters.baseRoot == 4)
+        {
+            base = _mm_sqrt_ps(base);
+        }
+        __m128 distancePower = one;
+        for (int power = parameters.power; power != 0; power >>= 1)
+        {
+            if (power & 1)
+            {
+                distancePower = _mm_mul_ps(distancePower, base);
+            }
+            base = _mm_mul_ps(base, base);
+        }
+        const __m128 weight = _mm_div_ps(one, _mm_add_ps(distancePower, epsilon));
+        for (int c = 0; c < Channels; ++c)
+        {
+            const __m128 values = _mm_loadu_ps(boundaryValues + c * valuesStride + i);
+            channelNumerators[c] = _mm_add_ps(channelNumerators[c], _mm_mul_ps(weight, values));
+        }
+        denominators = _mm_add_ps(denominators, weight);
+    }
+
+    float lanes[4];
+    for (int c = 0; c < Channels; ++c)
+    {
+        _mm_storeu_ps(lanes, channelNumerators[c]);
+        numerators[c] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    _mm_storeu_ps(lanes, denominators);
+    denominator += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    accumulateScalar<Channels>(parameters, boundaryX + i, boundaryY + i, boundaryValues + i,
+                               valuesStride, count - i, x, y, numerators, denominator);
+}
+
+/**
+ * @brief The AVX2 kernel, 8 boundary pixels at a time.
+ * @tparam Channels The number of channels of the boundary values.
+ */
+template <int Channels>
+__attribute__((target("avx2,fma")))
+static void accumulateAvx2(const FillKernel::Parameters &parameters, const float *boundaryX,
+                           const float *boundaryY, const float *boundaryValues,
+                           const size_t valuesStride, const size_t count, const float x,
+                           const float y, float *numerators, float &denominator)
+{
+    const __m256 pixelX = _mm256_set1_ps(x);
+    const __m256 pixelY = _mm256_set1_ps(y);
+    const __m256 epsilon = _mm256_set1_ps(parameters.epsilon);
+    const __m256 one = _mm256_set1_ps(1);
+    __m256 channelNumerators[Channels];
+    for (int c = 0; c < Channels; ++c)
+    {
+        channelNumerators[c] = _mm256_setzero_ps();
+    }
+    __m256 denominators = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(boundaryX + i), pixelX);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(boundaryY + i), pixelY);
+        __m256 base = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+        if (parameters.baseRoot >= 2)
+        {
+            base = _mm256_sqrt_ps(base);
+        }
+        if (parameters.baseRoot == 4)
+        {
+            base = _mm256_sqrt_ps(base);
+        }
+        __m256 distancePower = one;
+        for (int power = parameters.power; power != 0; power >>= 1)
+        {
+            if (power & 1)
+            {
+                distancePower = _mm256_mul_ps(distancePower, base);
+            }
+            base = _mm256_mul_ps(base, base);
+        }
+        const __m256 weight = _mm256_div_ps(one, _mm256_add_ps(distancePower, epsilon));
+        for (int c = 0; c < Channels; ++c)
+        {
+            const __m256 values = _mm256_loadu_ps(boundaryValues + c * valuesStride + i);
+            channelNumerators[c] = _mm256_fmadd_ps(weight, values, channelNumerators[c]);
+        }
+        denominators = _mm256_add_ps(denominators, weight);
+    }
+
+    float lanes[8];
+    for (int c = 0; c < Channels; ++c)
+    {
+        _mm256_storeu_ps(lanes, channelNumerators[c]);
+        numerators[c] += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+                         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+    _mm256_storeu_ps(lanes, denominators);
+    denominator += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+                   ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    accumulateScalar<Channels>(parameters, boundaryX + i, boundaryY + i, boundaryValues + i,
+                               valuesStride, count - i, x, y, numerators, denominator);
+}
+
+// The AVX-512 intrinsics of some GCC versions trigger false uninitialized warnings.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * @brief The AVX-512 kernel, 16 boundary pixels at a time.
+ * @tparam Channels The number of channels of the boundary values.
+ */
+template <int Channels>
+__attribute__((target("avx512f")))
+static void accumulateAvx512(const FillKernel::Parameters &parameters, const float *boundaryX,
+                             const float *boundaryY, const float *boundaryValues,
+                             const size_t valuesStride, const size_t count, const float x,
+                             const float y, float *numerators, float &denominator)
+{
+    const __m512 pixelX = _mm512_set1_ps(x);
+    const __m512 pixelY = _mm512_set1_ps(y);
+    const __m512 epsilon = _mm512_set1_ps(parameters.epsilon);
+    const __m512 one = _mm512_set1_ps(1);
+    __m512 channelNumerators[Channels];
+    for (int c = 0; c < Channels; ++c)
+    {
+        channelNumerators[c] = _mm512_setzero_ps();
+    }
+    __m512 denominators = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(boundaryX + i), pixelX);
+        const __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(boundaryY + i), pixelY);
+        __m512 base = _mm512_fmadd_ps(dx, dx, _mm512_mul_ps(dy, dy));
+        if (parameters.baseRoot >= 2)
+        {
+            base = _mm512_sqrt_ps(base);
+        }
+        if (parameters.baseRoot == 4)
+        {
+            base = _mm512_sqrt_ps(base);
+        }
+        __m512 distancePower = one;
+        for (int power = parameters.power; power != 0; power >>= 1)
+        {
+            if (power & 1)
+            {
+                distancePower = _mm512_mul_ps(distancePower, base);
+            }
+            base = _mm512_mul_ps(base, base);
+        }
+        const __m512 weight = _mm512_div_ps(one, _mm512_add_ps(distancePower, epsilon));
+        for (int c = 0; c < Channels; ++c)
+        {
+            const __m512 values = _mm512_loadu_ps(boundaryValues + c * valuesStride + i);
+            channelNumerators[c] = _mm512_fmadd_ps(weight, values, channelNumerators[c]);
+        }
+        denominators = _mm512_add_ps(denominators, weight);
+    }
+
+    for (int c = 0; c < Channels; ++c)
+    {
+        numerators[c] += _mm512_reduce_add_ps(channelNumerators[c]);
+    }
+    denominator += _mm512_reduce_add_ps(denominators);
+    accumulateScalar<Channels>(parameters, boundaryX + i, boundaryY + i, boundaryValues + i,
+                               valuesStride, count - i, x, y, numerators, denominator);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+
+/*-----=  ARM Kernels  =-----*/
+
+
+#ifdef FILL_KERNEL_NEON
+
+/**
+ * @brief The NEON kernel, 4 boundary pixels at a time.
+ * @tparam Channels The number of channels of the boundary values.
+ */
+template <int Channels>
+static void accumulateNeon(const FillKernel::Parameters &parameters, const float *boundaryX,
+                           const float *boundaryY, const float *boundaryValues,
+                           const size_t valuesStride, const size_t count, const float x,
+                           const float y, float *numerators, float &denominator)
+{
+    const float32x4_t pixelX = vdupq_n_f32(x);
+    const float32x4_t pixelY = vdupq_n_f32(y);
+    const float32x4_t epsilon = vdupq_n_f32(parameters.epsilon);
+    const float32x4_t one = vdupq_n_f32(1);
+    float32x4_t channelNumerators[Channels];
+    for (int c = 0; c < Channels; ++c)
+    {
+        channelNumerators[c] = vdupq_n_f32(0);
+    }
+    float32x4_t denominators = vdupq_n_f32(0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(boundaryX + i), pixelX);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(boundaryY + i), pixelY);
+        float32x4_t base = vmlaq_f32(vmulq_f32(dy, dy), dx, dx);
+        if (parameters.baseRoot >= 2)
+        {
+            base = vsqrtq_f32(base);
+        }
+        if (parameters.baseRoot == 4)
+        {
+            base = vsqrtq_f32(base);
+        }
+        float32x4_t distancePower = one;
+        for (int power = parameters.power; power != 0; power >>= 1)
+        {
+            if (power & 1)
+            {
+                distancePower = vmulq_f32(distancePower, base);
+            }
+            base = vmulq_f32(base, base);
+        }
+        const float32x4_t weight = vdivq_f32(one, vaddq_f32(distancePower, epsilon));
+        for (int c = 0; c < Channels; ++c)
+        {
+            const float32x4_t values = vld1q_f32(boundaryValues + c * valuesStride + i);
+            channelNumerators[c] = vmlaq_f32(channelNumerators[c], weight, values);
+        }
+        denominators = vaddq_f32(denominators, weight);
+    }
+
+    for (int c = 0; c < Channels; ++c)
+    {
+        numerators[c] += vaddvq_f32(channelNumerators[c]);
+    }
+    denominator += vaddvq_f32(denominators);
+    accumulateScalar<Channels>(parameters, boundaryX + i, boundaryY + i, boundaryValues + i,
+                               valuesStride, count - i, x, y, numerators, denominator);
+}
+
+#endif
+
+
+/*-----=  Kernel Selection  =-----*/
+
+
+/**
+ * @brief The name and the functions of a kernel for a single instruction set.
+ */
+struct KernelEntry
+{
+    const char *name;  // The name of the instruction set.
+    AccumulateFunction accumulate[MAX_CHANNELS];  // The kernel functions, by channels - 1.
+};
+
+/**
+ * @brief Picks the widest kernel supported by the running CPU.
+ * @return The selected kernel.
+ */
+static KernelEntry selectKernel()
+{
+    static_assert(MAX_CHANNELS == 4, "KERNEL_ENTRY instantiates the kernels of 1 to 4 channels");
+#if defined(FILL_KERNEL_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return KERNEL_ENTRY("AVX-512", accumulateAvx512);
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return KERNEL_ENTRY("AVX2", accumulateAvx2);
+    }
+    return KERNEL_ENTRY("SSE2", accumulateSse2);
+#elif defined(FILL_KERNEL_NEON)
+    return KERNEL_ENTRY("NEON", accumulateNeon);
+#else
+    return KERNEL_ENTRY("Scalar", accumulateScalar);
+#endif
+}
+
+/**
+ * @brief Returns the kernel of the running CPU, which is selected once.
+ * @return The kernel of the running CPU.
+ */
+static const KernelEntry &getKernel()
+{
+    static const KernelEntry kernel = selectKernel();
+    return kernel;
+}
+
+/**
+ * @brief Returns the kernel function of the given parameters for the given number of
+ *        channels. A z value without a specialised form is computed by the scalar kernel.
+ * @param parameters The kernel parameters.
+ * @param channels The number of channels of the boundary values.
+ * @return The kernel function.
+ */
+static AccumulateFunction getAccumulateFunction(const FillKernel::Parameters &parameters,
+                                                const int channels)
+{
+    assert(channels >= 1 && channels <= MAX_CHANNELS);
+    static const AccumulateFunction scalarFunctions[MAX_CHANNELS] = {
+            accumulateScalar<1>, accumulateScalar<2>, accumulateScalar<3>, accumulateScalar<4>};
+    return (parameters.baseRoot == GENERAL_ROOT) ? scalarFunctions[channels - 1] :
+                                                   getKernel().accumulate[channels - 1];
+}
+
+
+/*-----=  Fill Kernel Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the FillKernel.
+ *        Since |x-y|^z = (|x-y|^2)^(z/2), an even z is a power of the squared distance,
+ *        an odd z is a power of the distance, and a half-integer z is a power of the square
+ *        root of the distance. Other values of z fall back to pow.
+ * @param epsilon The epsilon value of the default weighted function.
+ * @param z The z value of the default weighted function.
+ */
+FillKernel::FillKernel(const float epsilon, const float z)
+{
+    _parameters.epsilon = epsilon;
+    _parameters.halfZ = z / 2;
+    _parameters.baseRoot = GENERAL_ROOT;
+    _parameters.power = 0;
+
+    const float doubleZ = 2 * z;
+    if (doubleZ >= 0 && doubleZ <= 2 * MAX_SPECIALISED_POWER && doubleZ == std::floor(doubleZ))
+    {
+        const int halfPowers = (int) doubleZ;
+        if (halfPowers % 4 == 0)
+        {
+            _parameters.baseRoot = 1;
+            _parameters.power = halfPowers / 4;
+        }
+        else if (halfPowers % 2 == 0)
+        {
+            _parameters.baseRoot = 2;
+            _parameters.power = halfPowers / 2;
+        }
+        else
+        {
+            _parameters.baseRoot = 4;
+            _parameters.power = halfPowers;
+        }
+    }
+}
+
+/**
+ * @brief Accumulates the weighted sums of the given pixel over a range of the boundary.
+ * @param boundary The boundary of the hole containing the pixel.
+ * @param begin The index of the first boundary pixel in the range.
+ * @param end The index after the last boundary pixel in the range.
+ * @param pixel The pixel to fill.
+ * @param numerator The sum of the weighted boundary values to add to.
+ * @param denominator The sum of the weights to add to.
+ */
+void FillKernel::accumulate(const BoundaryArrays &boundary, const size_t begin, const size_t end,
+                            const Pixel &pixel, float &numerator, float &denominator) const
+{
+    getAccumulateFunction(_parameters, 1)(_parameters, boundary.getX() + begin,
+                                          boundary.getY() + begin, boundary.getValues() + begin,
+                                          boundary.size(), end - begin, (float) pixel.getX(),
+                                          (float) pixel.getY(), &numerator, denominator);
+}
+
+/**
+ * @brief Accumulates the weighted sums of a block of pixels over the entire boundary.
+ *        The boundary is walked in tiles which fit the L1 cache, and every tile is used by
+ *        all the pixels of the block before the next tile is read, so a large boundary is
+ *        streamed from memory once per block instead of once per pixel. For a boundary of
+ *        several channels the weight of every pair is computed once and it is accumulated
+ *        into all the channels.
+ * @param boundary The boundary of the hole containing the pixels.
+ * @param pixels The pixels to fill.
+ * @param count The number of pixels.
+ * @param numerators The sums of the weighted boundary values of the pixels to add to, the
+ *        sum of channel c of pixel i at i * channels + c.
+ * @param denominators The sums of the weights of the pixels to add to.
+ */
+void FillKernel::accumulate(const BoundaryArrays &boundary, const Pixel *pixels,
+                            const size_t count, float *numerators, float *denominators) const
+{
+    const int channels = boundary.getChannels();
+    AccumulateFunction accumulateFunction = getAccumulateFunction(_parameters, channels);
+    for (size_t begin = 0; begin < boundary.size(); begin += BOUNDARY_TILE_SIZE)
+    {
+        const size_t tileSize = std::min((size_t) BOUNDARY_TILE_SIZE, boundary.size() - begin);
+        for (size_t i = 0; i < count; ++i)
+        {
+            accumulateFunction(_parameters, boundary.getX() + begin, boundary.getY() + begin,
+                               boundary.getValues() + begin, boundary.size(), tileSize,
+                               (float) pixels[i].getX(), (float) pixels[i].getY(),
+                               numerators + i * channels, denominators[i]);
+        }
+    }
+}
+
+/**
+ * @brief Computes the filled value of the given pixel from the given boundary.
+ * @param boundary The boundary of the hole containing the pixel.
+ * @param pixel The pixel to fill.
+ * @return The filled value of the pixel, MISSING_VALUE for an empty boundary.
+ */
+float FillKernel::fill(const BoundaryArrays &boundary, const Pixel &pixel) const
+{
+    if (boundary.size() == 0)
+    {
+        // A pixel without a boundary stays missing.
+        return MISSING_VALUE;
+    }
+    float numerator = 0;
+    float denominator = 0;
+    accumulate(boundary, 0, boundary.size(), pixel, numerator, denominator);
+    return numerator / denominator;
+}
+
+/**
+ * @brief Computes the weight of two pixels with the given squared distance.
+ * @param squaredDistance The squared distance between the pixels.
+ * @return The weight of the pixels.
+ */
+float FillKernel::weight(const float squaredDistance) const
+{
+    return 1 / (scalarDistancePower(_parameters, squaredDistance) + _parameters.epsilon);
+}
+
+/**
+ * @brief Returns whether |x-y|^z is evaluated without pow, i.e. by the vectorized kernels.
+ * @return true if the z value has a specialised form, false otherwise.
+ */
+bool FillKernel::isSpecialised() const
+{
+    return _parameters.baseRoot != GENERAL_ROOT;
+}
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels.
+ * @return The name of the instruction set used by the kernels.
+ */
+const char *FillKernel::getInstructionSet()
+{
+    return getKernel().name;
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+/**
+ * @file FillKernel.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the vectorized fill kernel of the default weighted function.
+ */
+
+
+#ifndef FILLKERNEL_H
+#define FILLKERNEL_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "ColorImage.h"
+#include "Hole.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing the boundary of a hole as struct-of-arrays, i.e. the X
+ *        coordinates, Y coordinates and values of the boundary pixels in 3 contiguous
+ *        arrays of floats, which is the layout the vectorized kernels stream through.
+ *        The values of a multi-channel image are planar, i.e. every channel is a contiguous
+ *        array of the values of all the boundary pixels, one after the other.
+ */
+class BoundaryArrays
+{
+public:
+    /**
+     * @brief A Constructor for empty BoundaryArrays of a single channel.
+     */
+    BoundaryArrays() : _channels(1) {}
+
+    /**
+     * @brief Sets the arrays from the given boundary pixels and their values in the image.
+     * @param image The image containing the boundary.
+     * @param boundary The boundary pixels.
+     */
+    void assign(const Image &image, const holeSet &boundary);
+
+    /**
+     * @brief Sets the arrays from the given boundary pixels and their values in the byte image.
+     * @param image The image containing the boundary.
+     * @param boundary The boundary pixels.
+     */
+    void assign(const ByteImage &image, const holeSet &boundary);
+
+    /**
+     * @brief Sets the arrays from the given boundary pixels and their values in the 16-bit image.
+     * @param image The image containing the boundary.
+     * @param boundary The boundary pixels.
+     */
+    void assign(const ShortImage &image, const holeSet &boundary);
+
+    /**
+     * @brief Sets the arrays from the given boundary pixels and the values of all their
+     *        channels in the multi-channel image.
+     * @param image The image containing the boundary.
+     * @param boundary The boundary pixels.
+     */
+    void assign(const ColorImage &image, const holeSet &boundary);
+
+    /**
+     * @brief Sets the arrays from the given boundary pixels and the values of all their
+     *        channels in the multi-channel byte image.
+     * @param image The image containing the boundary.
+     * @param boundary The boundary pixels.
+     */
+    void assign(const ByteColorImage &image, const holeSet &boundary);
+
+    /**
+     * @brief Sets the arrays from the given arrays, reordered by the given order.
+     * @param source The arrays to copy.
+     * @param order The indices in the source arrays, by their new order.
+     */
+    void assign(const BoundaryArrays &source, const std::vector<size_t> &order);
+
+    /**
+     * @brief Returns the number of boundary pixels.
+     * @return The number of boundary pixels.
+     */
+    size_t size() const { return _x.size(); }
+
+    /**
+     * @brief Returns the number of channels of the values.
+     * @return The number of channels of the values.
+     */
+    int getChannels() const { return _channels; }
+
+    /**
+     * @brief Returns the X coordinates of the boundary pixels.
+     * @return The X coordinates of the boundary pixels.
+     */
+    const float *getX() const { return _x.data(); }
+
+    /**
+     * @brief Returns the Y coordinates of the boundary pixels.
+     * @return The Y coordinates of the boundary pixels.
+     */
+    const float *getY() const { return _y.data(); }
+
+    /**
+     * @brief Returns the values of the boundary pixels.
+     * @return The values of the boundary pixels.
+     */
+    const float *getValues() const { return _values.data(); }
+
+    /**
+     * @brief Returns the values of the given channel of the boundary pixels.
+     * @param channel The channel of the values.
+     * @return The values of the channel of the boundary pixels.
+     */
+    const float *getValues(const int channel) const { return _values.data() + channel * size(); }
+
+private:
+    std::vector<float> _x;  // The X coordinates of the boundary pixels.
+    std::vector<float> _y;  // The Y coordinates of the boundary pixels.
+    std::vector<float> _values;  // The values of the boundary pixels, channel after channel.
+    int _channels;  // The number of channels of the values.
+
+};
+
+
+/**
+ * @brief A Class which computes the default weighted fill of a pixel, i.e. the sums of
+ *        w(x,y) * I(y) and of w(x,y) over the boundary pixels y, where
+ *        w(x,y) = 1 / (|x-y|^z + epsilon).
+ *        The kernel is vectorized with the widest instruction set supported by the running
+ *        CPU (AVX-512, AVX2 or SSE2 on x86 and NEON on ARM), which is picked at runtime.
+ *        The distance is computed squared in float, and |x-y|^z is evaluated without pow
+ *        for integer and half-integer values of z.
+ */
+class FillKernel
+{
+public:
+    /**
+     * @brief A Constructor for the FillKernel.
+     * @param epsilon The epsilon value of the default weighted function.
+     * @param z The z value of the default weighted function.
+     */
+    FillKernel(const float epsilon, const float z);
+
+    /**
+     * @brief Computes the filled value of the given pixel from the given boundary.
+     * @param boundary The boundary of the hole containing the pixel.
+     * @param pixel The pixel to fill.
+     * @return The filled value of the pixel, MISSING_VALUE for an empty boundary.
+     */
+    float fill(const BoundaryArrays &boundary, const Pixel &pixel) const;
+
+    /**
+     * @brief Accumulates the weighted sums of the given pixel over a range of the boundary.
+     * @param boundary The boundary of the hole containing the pixel.
+     * @param begin The index of the first boundary pixel in the range.
+     * @param end The index after the last boundary pixel in the range.
+     * @param pixel The pixel to fill.
+     * @param numerator The sum of the weighted boundary values to add to.
+     * @param denominator The sum of the weights to add to.
+     */
+    void accumulate(const BoundaryArrays &boundary, const size_t begin, const size_t end,
+                    const Pixel &pixel, float &numerator, float &denominator) const;
+
+    /**
+     * @brief Accumulates the weighted sums of a block of pixels over the entire boundary.
+     *        The boundary is walked in tiles which fit the L1 cache, and every tile is used by
+     *        all the pixels of the block before the next tile is read, so a large boundary is
+     *        streamed from memory once per block instead of once per pixel. For a boundary of
+     *        several channels the weight of every pair is computed once and it is accumulated
+     *        into all the channels.
+     * @param boundary The boundary of the hole containing the pixels.
+     * @param pixels The pixels to fill.
+     * @param count The number of pixels.
+     * @param numerators The sums of the weighted boundary values of the pixels to add to, the
+     *        sum of channel c of pixel i at i * channels + c.
+     * @param denominators The sums of the weights of the pixels to add to.
+     */
+    void accumulate(const BoundaryArrays &boundary, const Pixel *pixels, const size_t count,
+                    float *numerators, float *denominators) const;
+
+    /**
+     * @brief Computes the weight of two pixels with the given squared distance.
+     * @param squaredDistance The squared distance between the pixels.
+     * @return The weight of the pixels.
+     */
+    float weight(const float squaredDistance) const;
+
+    /**
+     * @brief Returns whether |x-y|^z is evaluated without pow, i.e. by the vectorized kernels.
+     * @return true if the z value has a specialised form, false otherwise.
+     */
+    bool isSpecialised() const;
+
+    /**
+     * @brief Returns the name of the instruction set used by the kernels.
+     * @return The name of the instruction set used by the kernels.
+     */
+    static const char *getInstructionSet();
+
+    /**
+     * @brief The parameters of the kernel, |x-y|^z is computed as base^power where the
+     *        base is the squared distance or one of its roots, see FillKernel.cpp.
+     */
+    struct Parameters
+    {
+        float epsilon;  // The epsilon value of the weighted function.
+        float halfZ;  // Half of the z value, used when z has no specialised form.
+        int baseRoot;  // The base's root of the squared distance: 1, 2, 4 or 0 for pow.
+        int power;  // The integer power of the base.
+    };
+
+    /**
+     * @brief Returns the parameters of the kernel, which the GPU backend runs with.
+     * @return The parameters of the kernel.
+     */
+    const Parameters &getParameters() const { return _parameters; }
+
+private:
+    Parameters _parameters;  // The parameters of the kernel.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file GpuFill.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the GpuFill Class implementation without CUDA, where no device is
+ *        available and every hole is filled on the CPU. See GpuFill.cu for the backend.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include "GpuFill.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A job of the fill, which has nothing to keep without a device.
+ */
+struct GpuFill::Job
+{
+};
+
+/**
+ * @brief A Constructor for the GpuFill, without jobs.
+ */
+GpuFill::GpuFill() : _jobCount(0)
+{
+}
+
+/**
+ * @brief A Destructor for the GpuFill, which waits for the jobs and releases them.
+ */
+GpuFill::~GpuFill()
+{
+}
+
+/**
+ * @brief Returns whether a device can be used, which is checked once.
+ * @return true if the fills can run on a device, false otherwise.
+ */
+bool GpuFill::isAvailable()
+{
+    return false;
+}
+
+/**
+ * @brief Starts a new set of jobs, the results of the previous jobs are dropped.
+ */
+void GpuFill::reset()
+{
+    _jobCount = 0;
+}
+
+/**
+ * @brief Submits the fill of the pixels of the given hole from the given boundary as a job,
+ *        which runs asynchronously.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param boundary The boundary of the hole.
+ * @param hole The hole.
+ * @return false, since there is no device.
+ */
+bool GpuFill::submit(const FillKernel &kernel, const BoundaryArrays &boundary, const Hole &hole)
+{
+    (void) kernel;
+    (void) boundary;
+    (void) hole;
+    return false;
+}
+
+/**
+ * @brief Waits for the given job and returns it's values.
+ * @param job The index of the job.
+ * @return nullptr, since there is no device.
+ */
+const float *GpuFill::getValues(const size_t job)
+{
+    (void) job;
+    return nullptr;
+}
\ No newline at end of file
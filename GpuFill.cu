@@ -0,0 +1,326 @@
+/**
+ * @file GpuFill.cu
+ * @author Itai Tagar
+ *
+ * @brief A file for the GpuFill Class implementation with CUDA, built by make CUDA=1.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cuda_runtime.h>
+#include "GpuFill.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def GPU_BLOCK_SIZE 256
+ * @brief A Macro that sets the number of threads of a block, which is also the number of
+ *        boundary pixels of a tile in shared memory.
+ */
+#define GPU_BLOCK_SIZE 256
+
+/**
+ * @def GENERAL_ROOT 0
+ * @brief A Macro that sets the base root value for z values which are computed with pow,
+ *        as in FillKernel.cpp.
+ */
+#define GENERAL_ROOT 0
+
+
+/*-----=  Device Functions  =-----*/
+
+
+/**
+ * @brief Computes |x-y|^z from the squared distance according to the kernel parameters, as
+ *        the scalar kernel of FillKernel.cpp does.
+ * @param parameters The kernel parameters.
+ * @param squaredDistance The squared distance between the pixels.
+ * @return The distance raised to the power of z.
+ */
+__device__ static inline float distancePower(const FillKernel::Parameters &parameters,
+                                             const float squaredDistance)
+{
+    float base = squaredDistance;
+    switch (parameters.baseRoot)
+    {
+        case GENERAL_ROOT:
+            return powf(squaredDistance, parameters.halfZ);
+        case 2:
+            base = sqrtf(squaredDistance);
+            break;
+        case 4:
+            base = sqrtf(sqrtf(squaredDistance));
+            break;
+        default:
+            break;
+    }
+    float result = 1;
+    for (int power = parameters.power; power != 0; power >>= 1)
+    {
+        if (power & 1)
+        {
+            result *= base;
+        }
+        base *= base;
+    }
+    return result;
+}
+
+/**
+ * @brief The fill of a hole, where every thread fills a single hole pixel. The threads of a
+ *        block load a tile of the boundary into shared memory together, and every thread sums
+ *        the tile into it's registers before the next tile is loaded.
+ * @param parameters The kernel parameters.
+ * @param boundaryX The X coordinates of the boundary pixels.
+ * @param boundaryY The Y coordinates of the boundary pixels.
+ * @param boundaryValues The values of the boundary pixels.
+ * @param boundaryCount The number of boundary pixels.
+ * @param pixelX The X coordinates of the hole pixels.
+ * @param pixelY The Y coordinates of the hole pixels.
+ * @param pixelCount The number of hole pixels.
+ * @param values Set to the filled values of the hole pixels.
+ */
+__global__ static void fillHole(const FillKernel::Parameters parameters, const float *boundaryX,
+                                const float *boundaryY, const float *boundaryValues,
+                                const int boundaryCount, const float *pixelX,
+                                const float *pixelY, const int pixelCount, float *values)
+{
+    __shared__ float tileX[GPU_BLOCK_SIZE];
+    __shared__ float tileY[GPU_BLOCK_SIZE];
+    __shared__ float tileValues[GPU_BLOCK_SIZE];
+
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    const float x = (i < pixelCount) ? pixelX[i] : 0;
+    const float y = (i < pixelCount) ? pixelY[i] : 0;
+    float numerator = 0;
+    float denominator = 0;
+    for (int begin = 0; begin < boundaryCount; begin += GPU_BLOCK_SIZE)
+    {
+        const int j = begin + threadIdx.x;
+        if (j < boundaryCount)
+        {
+            tileX[threadIdx.x] = boundaryX[j];
+            tileY[threadIdx.x] = boundaryY[j];
+            tileValues[threadIdx.x] = boundaryValues[j];
+        }
+        __syncthreads();
+        const int tileSize = min(GPU_BLOCK_SIZE, boundaryCount - begin);
+        for (int k = 0; k < tileSize; ++k)
+        {
+            const float dx = tileX[k] - x;
+            const float dy = tileY[k] - y;
+            const float weight = 1 / (distancePower(parameters, dx * dx + dy * dy) +
+                                      parameters.epsilon);
+            numerator += weight * tileValues[k];
+            denominator += weight;
+        }
+        __syncthreads();
+    }
+    if (i < pixelCount)
+    {
+        // A pixel without a boundary stays missing.
+        values[i] = (boundaryCount == 0) ? MISSING_VALUE : numerator / denominator;
+    }
+}
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A job of the fill: the stream of the job, and it's buffers on the host (pinned, so
+ *        the copies are asynchronous) and on the device, which are kept between jobs.
+ */
+struct GpuFill::Job
+{
+    /**
+     * @brief A Constructor for the Job, without buffers.
+     */
+    Job() : stream(nullptr), hostBuffer(nullptr), deviceBuffer(nullptr), capacity(0),
+            valuesOffset(0), failed(false) {}
+
+    /**
+     * @brief A Destructor for the Job, which waits for it's stream and releases the buffers.
+     */
+    ~Job()
+    {
+        if (stream != nullptr)
+        {
+            cudaStreamSynchronize(stream);
+            cudaStreamDestroy(stream);
+        }
+        cudaFreeHost(hostBuffer);
+        cudaFree(deviceBuffer);
+    }
+
+    /**
+     * @brief Makes sure the buffers have room for the given number of floats.
+     * @param floatCount The number of floats.
+     * @return true if the buffers have room, false if the device failed.
+     */
+    bool reserve(const size_t floatCount)
+    {
+        if (stream == nullptr && cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking) !=
+                                 cudaSuccess)
+        {
+            stream = nullptr;
+            return false;
+        }
+        if (floatCount <= capacity)
+        {
+            return true;
+        }
+        cudaFreeHost(hostBuffer);
+        cudaFree(deviceBuffer);
+        hostBuffer = nullptr;
+        deviceBuffer = nullptr;
+        capacity = 0;
+        if (cudaMallocHost((void**) &hostBuffer, floatCount * sizeof(float)) != cudaSuccess ||
+            cudaMalloc((void**) &deviceBuffer, floatCount * sizeof(float)) != cudaSuccess)
+        {
+            return false;
+        }
+        capacity = floatCount;
+        return true;
+    }
+
+    cudaStream_t stream;  // The stream of the job.
+    float *hostBuffer;  // The arrays of the job on the host.
+    float *deviceBuffer;  // The arrays of the job on the device.
+    size_t capacity;  // The number of floats of the buffers.
+    size_t valuesOffset;  // The index of the filled values of the job in the host buffer.
+    bool failed;  // Whether the device failed while running the job.
+};
+
+/**
+ * @brief A Constructor for the GpuFill, without jobs.
+ */
+GpuFill::GpuFill() : _jobCount(0)
+{
+}
+
+/**
+ * @brief A Destructor for the GpuFill, which waits for the jobs and releases them.
+ */
+GpuFill::~GpuFill()
+{
+}
+
+/**
+ * @brief Returns whether a device can be used, which is checked once.
+ * @return true if the fills can run on a device, false otherwise.
+ */
+bool GpuFill::isAvailable()
+{
+    static const bool available = []
+    {
+        int deviceCount = 0;
+        return cudaGetDeviceCount(&deviceCount) == cudaSuccess && deviceCount > 0;
+    }();
+    return available;
+}
+
+/**
+ * @brief Starts a new set of jobs, the results of the previous jobs are dropped.
+ */
+void GpuFill::reset()
+{
+    for (size_t i = 0; i < _jobCount; ++i)
+    {
+        cudaStreamSynchronize(_jobs[i]->stream);
+    }
+    _jobCount = 0;
+}
+
+/**
+ * @brief Submits the fill of the pixels of the given hole from the given boundary as a job,
+ *        which runs asynchronously. The boundary and the pixels are copied, so they can be
+ *        changed once this returns.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param boundary The boundary of the hole.
+ * @param hole The hole.
+ * @return true if the job was submitted, false if the device failed, in which case the
+ *         hole should be filled on the CPU.
+ */
+bool GpuFill::submit(const FillKernel &kernel, const BoundaryArrays &boundary, const Hole &hole)
+{
+    if (_jobCount == _jobs.size())
+    {
+        _jobs.emplace_back(new Job());
+    }
+    Job &job = *_jobs[_jobCount];
+    const size_t boundaryCount = boundary.size();
+    const size_t pixelCount = hole.getHoleSize();
+    if (!job.reserve(3 * boundaryCount + 3 * pixelCount))
+    {
+        return false;
+    }
+
+    // The arrays of the job, the boundary and the hole pixels are packed as struct-of-arrays
+    // into the pinned buffer, which is copied in one transfer.
+    float *hostX = job.hostBuffer;
+    float *hostY = hostX + boundaryCount;
+    float *hostValues = hostY + boundaryCount;
+    float *hostPixelX = hostValues + boundaryCount;
+    float *hostPixelY = hostPixelX + pixelCount;
+    std::copy(boundary.getX(), boundary.getX() + boundaryCount, hostX);
+    std::copy(boundary.getY(), boundary.getY() + boundaryCount, hostY);
+    std::copy(boundary.getValues(), boundary.getValues() + boundaryCount, hostValues);
+    hole.forEachHolePixel([&](const size_t i, const Pixel &x)
+    {
+        hostPixelX[i] = (float) x.getX();
+        hostPixelY[i] = (float) x.getY();
+    });
+    const size_t inputCount = 3 * boundaryCount + 2 * pixelCount;
+    float *deviceX = job.deviceBuffer;
+    float *deviceY = deviceX + boundaryCount;
+    float *deviceValues = deviceY + boundaryCount;
+    float *devicePixelX = deviceValues + boundaryCount;
+    float *devicePixelY = devicePixelX + pixelCount;
+    float *deviceResults = devicePixelY + pixelCount;
+
+    const unsigned int blockCount = (unsigned int) ((pixelCount + GPU_BLOCK_SIZE - 1) /
+                                                    GPU_BLOCK_SIZE);
+    cudaMemcpyAsync(job.deviceBuffer, job.hostBuffer, inputCount * sizeof(float),
+                    cudaMemcpyHostToDevice, job.stream);
+    fillHole<<<blockCount, GPU_BLOCK_SIZE, 0, job.stream>>>(kernel.getParameters(), deviceX,
+                                                            deviceY, deviceValues,
+                                                            (int) boundaryCount, devicePixelX,
+                                                            devicePixelY, (int) pixelCount,
+                                                            deviceResults);
+    cudaMemcpyAsync(job.hostBuffer + inputCount, deviceResults, pixelCount * sizeof(float),
+                    cudaMemcpyDeviceToHost, job.stream);
+    if (cudaGetLastError() != cudaSuccess)
+    {
+        return false;
+    }
+    job.valuesOffset = inputCount;
+    job.failed = false;
+    ++_jobCount;
+    return true;
+}
+
+/**
+ * @brief Waits for the given job and returns it's values.
+ * @param job The index of the job, by the order of the submitted jobs since the last reset.
+ * @return The filled values of the pixels of the job, by their order, valid until the next
+ *         reset, or nullptr if the device failed.
+ */
+const float *GpuFill::getValues(const size_t job)
+{
+    Job &submitted = *_jobs[job];
+    if (cudaStreamSynchronize(submitted.stream) != cudaSuccess)
+    {
+        submitted.failed = true;
+    }
+    if (submitted.failed)
+    {
+        return nullptr;
+    }
+    return submitted.hostBuffer + submitted.valuesOffset;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * @file GpuFill.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the GpuFill Class, the GPU backend of the exact fill.
+ */
+
+
+#ifndef GPUFILL_H
+#define GPUFILL_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Hole.h"
+#include "FillKernel.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing the GPU backend of the exact fill with the default weighted
+ *        function. Every hole is a job with a stream of it's own: the boundary and the hole
+ *        pixels are copied to the device asynchronously, every hole pixel is filled by a
+ *        thread which reads the boundary in tiles from shared memory, and the values are
+ *        copied back asynchronously. So the transfers and the fills of the holes of an image
+ *        overlap each other, and the CPU fills the small holes in the meantime.
+ *        The backend is built by make CUDA=1 (see GpuFill.cu), otherwise no device is
+ *        available (see GpuFill.cpp) and the holes are filled on the CPU. The buffers of the
+ *        jobs are kept between images, so a filler which fills many images allocates them once.
+ */
+class GpuFill
+{
+public:
+    /**
+     * @brief A Constructor for the GpuFill, without jobs.
+     */
+    GpuFill();
+
+    /**
+     * @brief A Destructor for the GpuFill, which waits for the jobs and releases them.
+     */
+    ~GpuFill();
+
+    /**
+     * @brief The fill owns the device buffers of it's jobs, so it can't be copied.
+     */
+    GpuFill(const GpuFill &other) = delete;
+
+    /**
+     * @brief The fill owns the device buffers of it's jobs, so it can't be copied.
+     */
+    GpuFill& operator=(const GpuFill &other) = delete;
+
+    /**
+     * @brief Returns whether a device can be used, which is checked once.
+     * @return true if the fills can run on a device, false otherwise.
+     */
+    static bool isAvailable();
+
+    /**
+     * @brief Starts a new set of jobs, the results of the previous jobs are dropped.
+     */
+    void reset();
+
+    /**
+     * @brief Submits the fill of the pixels of the given hole from the given boundary as a job,
+     *        which runs asynchronously. The boundary and the pixels are copied, so they can be
+     *        changed once this returns.
+     * @param kernel The fill kernel of the default weighted function.
+     * @param boundary The boundary of the hole.
+     * @param hole The hole.
+     * @return true if the job was submitted, false if the device failed, in which case the
+     *         hole should be filled on the CPU.
+     */
+    bool submit(const FillKernel &kernel, const BoundaryArrays &boundary, const Hole &hole);
+
+    /**
+     * @brief Waits for the given job and returns it's values.
+     * @param job The index of the job, by the order of the submitted jobs since the last reset.
+     * @return The filled values of the pixels of the job, by their order, valid until the next
+     *         reset, or nullptr if the device failed.
+     */
+    const float *getValues(const size_t job);
+
+private:
+    struct Job;
+
+    std::vector<std::unique_ptr<Job>> _jobs;  // The jobs, which keep their buffers.
+    size_t _jobCount;  // The number of jobs submitted since the last reset.
+
+};
+
+
+#endif
\ No newline at end of file
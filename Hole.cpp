@@ -15,6 +15,24 @@
 /*-----=  Class Implementation  =-----*/
 
 
+/**
+ * @brief Returns the bounding box of the Hole's pixels, by it's runs.
+ * @return The bounding box of the Hole's pixels, the Hole isn't empty.
+ */
+HoleBox Hole::getHoleBox() const
+{
+    const Pixel first = getHolePixel(0);
+    HoleBox box = {first.getX(), first.getX(), first.getY(), first.getY()};
+    forEachHoleRun([&box](const int row, const int colStart, const int colEnd)
+                   {
+                       box.firstRow = std::min(box.firstRow, row);
+                       box.lastRow = std::max(box.lastRow, row);
+                       box.firstCol = std::min(box.firstCol, colStart);
+                       box.lastCol = std::max(box.lastCol, colEnd - 1);
+                   });
+    return box;
+}
+
 /**
  * @brief operator << for stream insertion.
  * @param os The output stream.
@@ -24,10 +42,10 @@
 std::ostream& operator<<(std::ostream &os, const Hole &hole)
 {
     os << "Hole:" << std::endl;
-    for (const Pixel &pixel : hole.getHolePixels())
-    {
-        os << pixel << '\t';
-    }
+    hole.forEachHolePixel([&os](const size_t, const Pixel &pixel)
+                          {
+                              os << pixel << '\t';
+                          });
     os << std::endl;
     os << "Hole Boundary:" << std::endl;
     for (const Pixel &pixel : hole.getHoleBoundary())
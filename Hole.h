@@ -13,27 +13,79 @@
 /*-----=  Includes  =-----*/
 
 
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
 #include "Pixel.h"
+#include "MonotonicArena.h"
 
 
 /*-----=  Type Definitions  =-----*/
 
 
 /**
- * @brief A Type Definition for the hole's pixels set.
+ * @brief A Type Definition for the hole's pixels set, which may be allocated from an arena.
  */
-typedef std::vector<Pixel> holeSet;
+typedef std::vector<Pixel, ArenaAllocator<Pixel>> holeSet;
+
+/**
+ * @brief A horizontal run of hole pixels, i.e. the pixels of the columns [colStart, colEnd)
+ *        of a row, and the index of it's first pixel in the hole.
+ */
+struct PixelRun
+{
+    int32_t row;  // The row of the run.
+    int32_t colStart;  // The column of the first pixel of the run.
+    int32_t colEnd;  // The column after the last pixel of the run.
+    uint32_t first;  // The index of the first pixel of the run in the hole.
+};
+
+/**
+ * @brief A Type Definition for the hole's runs set, which may be allocated from an arena.
+ */
+typedef std::vector<PixelRun, ArenaAllocator<PixelRun>> runSet;
+
+/**
+ * @brief The bounding box of the pixels of a hole.
+ */
+struct HoleBox
+{
+    int firstRow;  // The first row of the pixels.
+    int lastRow;  // The last row of the pixels.
+    int firstCol;  // The first column of the pixels.
+    int lastCol;  // The last column of the pixels.
+};
 
 
 /*-----=  Class Declaration  =-----*/
 
 
 /**
- * @brief A Class representing a Hole with it's pixels.
+ * @brief A Class representing a Hole with it's pixels. The pixels of a Hole are either a list
+ *        of pixels (e.g. of a hole extracted by BFS), or a list of horizontal runs in a
+ *        row-major order (the holes of findHoles), which takes a fraction of the memory of a
+ *        large hole and is scanned with a unit stride. The fills visit the pixels of either
+ *        form by their indices, see forEachHolePixel. The pixels of a Hole are either on the
+ *        heap, or in an arena which must outlive it (see findHoles), and a copy of a Hole is
+ *        always on the heap.
  */
 class Hole
 {
 public:
+    /**
+     * @brief A Constructor for an empty Hole, whose pixels are on the heap.
+     */
+    Hole() = default;
+
+    /**
+     * @brief A Constructor for an empty Hole, whose pixels are allocated from the given arena.
+     * @param arena The arena of the pixels, nullptr for the heap.
+     */
+    explicit Hole(MonotonicArena *arena) : _holePixels(ArenaAllocator<Pixel>(arena)),
+                                           _holeRuns(ArenaAllocator<PixelRun>(arena)),
+                                           _holeBoundary(ArenaAllocator<Pixel>(arena)) {}
+
     /**
      * @brief operator << for stream insertion.
      * @param os The output stream.
@@ -43,16 +95,112 @@ public:
     friend std::ostream& operator<<(std::ostream &os, const Hole &hole);
 
     /**
-     * @brief Returns the Hole's pixels.
-     * @return The Hole's pixels.
+     * @brief Returns the Hole's pixels, of a Hole which is a list of pixels.
+     * @return The Hole's pixels, empty for a Hole of runs.
+     */
+    const holeSet &getHolePixels() const { return _holePixels; }
+
+    /**
+     * @brief Returns the Hole's runs, of a Hole which is a list of runs.
+     * @return The Hole's runs, empty for a Hole of pixels.
+     */
+    const runSet &getHoleRuns() const { return _holeRuns; }
+
+    /**
+     * @brief Returns the number of the Hole's pixels, in either form.
+     * @return The number of the Hole's pixels.
+     */
+    size_t getHoleSize() const { return _holePixels.size() + _runPixelCount; }
+
+    /**
+     * @brief Returns the Hole's pixel of the given index, in either form.
+     * @param index The index of the pixel, less than the Hole's size.
+     * @return The Hole's pixel.
+     */
+    Pixel getHolePixel(const size_t index) const
+    {
+        if (_holeRuns.empty())
+        {
+            return _holePixels[index];
+        }
+        const PixelRun &run = *findRun(index);
+        return Pixel(run.row, run.colStart + (int) (index - run.first));
+    }
+
+    /**
+     * @brief Visits the Hole's pixels of the indices [begin, end), in either form, by their
+     *        order. The pixels of a run are visited in a unit stride loop.
+     * @tparam Visitor The type of the visitor, a callable object with the signature
+     *         void(size_t index, const Pixel &pixel).
+     * @param begin The index of the first pixel.
+     * @param end The index after the last pixel, at most the Hole's size.
+     * @param visitor The visitor of the pixels.
+     */
+    template <typename Visitor>
+    void forEachHolePixel(const size_t begin, const size_t end, const Visitor &visitor) const
+    {
+        if (_holeRuns.empty())
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                visitor(i, _holePixels[i]);
+            }
+            return;
+        }
+        size_t index = begin;
+        for (auto run = findRun(begin); index < end; ++run)
+        {
+            const size_t runEnd = std::min(end, (size_t) run->first + (run->colEnd -
+                                                                         run->colStart));
+            for (int y = run->colStart + (int) (index - run->first); index < runEnd; ++index, ++y)
+            {
+                visitor(index, Pixel(run->row, y));
+            }
+        }
+    }
+
+    /**
+     * @brief Visits the Hole's runs, where every pixel of a Hole of pixels is a run of it's own.
+     * @tparam Visitor The type of the visitor, a callable object with the signature
+     *         void(int row, int colStart, int colEnd), where colEnd is after the last column.
+     * @param visitor The visitor of the runs.
+     */
+    template <typename Visitor>
+    void forEachHoleRun(const Visitor &visitor) const
+    {
+        for (const Pixel &pixel : _holePixels)
+        {
+            visitor(pixel.getX(), pixel.getY(), pixel.getY() + 1);
+        }
+        for (const PixelRun &run : _holeRuns)
+        {
+            visitor(run.row, run.colStart, run.colEnd);
+        }
+    }
+
+    /**
+     * @brief Returns the bounding box of the Hole's pixels, by it's runs.
+     * @return The bounding box of the Hole's pixels, the Hole isn't empty.
+     */
+    HoleBox getHoleBox() const;
+
+    /**
+     * @brief Visits all the Hole's pixels, in either form, by their order.
+     * @tparam Visitor The type of the visitor, a callable object with the signature
+     *         void(size_t index, const Pixel &pixel).
+     * @param visitor The visitor of the pixels.
      */
-    const holeSet getHolePixels() const { return _holePixels; }
+    template <typename Visitor>
+    void forEachHolePixel(const Visitor &visitor) const
+    {
+        forEachHolePixel(0, getHoleSize(), visitor);
+    }
 
     /**
      * @brief Returns the Hole's boundary pixels.
      * @return The Hole's boundary pixels.
      */
-    const holeSet getHoleBoundary() const { return _holeBoundary; }
+    const holeSet &getHoleBoundary() const { return _holeBoundary; }
 
     /**
      * @brief Adds new pixel to the Hole.
@@ -60,15 +208,75 @@ public:
      */
     void addHolePixels(const Pixel &pixel) { _holePixels.push_back(pixel); }
 
+    /**
+     * @brief Adds a new run to the Hole, after it's last run in a row-major order. A run which
+     *        continues the last run is merged into it.
+     * @param row The row of the run.
+     * @param colStart The column of the first pixel of the run.
+     * @param colEnd The column after the last pixel of the run.
+     */
+    void addHoleRun(const int row, const int colStart, const int colEnd)
+    {
+        if (!_holeRuns.empty() && _holeRuns.back().row == row &&
+            _holeRuns.back().colEnd == colStart)
+        {
+            _holeRuns.back().colEnd = colEnd;
+        }
+        else
+        {
+            _holeRuns.push_back({row, colStart, colEnd, (uint32_t) _runPixelCount});
+        }
+        _runPixelCount += colEnd - colStart;
+    }
+
     /**
      * @brief Adds new pixel to the Hole's boundary.
      * @param pixel The pixel to add.
      */
     void addHoleBoundary(const Pixel &pixel) { _holeBoundary.push_back(pixel); }
 
+    /**
+     * @brief Reserves room for the given number of pixels, so adding them doesn't reallocate.
+     * @param holeSize The number of pixels of the Hole.
+     * @param boundarySize The number of pixels of the Hole's boundary.
+     */
+    void reserve(const size_t holeSize, const size_t boundarySize)
+    {
+        _holePixels.reserve(holeSize);
+        _holeBoundary.reserve(boundarySize);
+    }
+
+    /**
+     * @brief Reserves room for the given number of runs and boundary pixels, so adding them
+     *        doesn't reallocate.
+     * @param runCount The number of runs of the Hole.
+     * @param boundarySize The number of pixels of the Hole's boundary.
+     */
+    void reserveRuns(const size_t runCount, const size_t boundarySize)
+    {
+        _holeRuns.reserve(runCount);
+        _holeBoundary.reserve(boundarySize);
+    }
+
 private:
-    holeSet _holePixels;  // The Hole's pixels.
+    /**
+     * @brief Returns the run which contains the pixel of the given index.
+     * @param index The index of the pixel, less than the Hole's size.
+     * @return The run of the pixel.
+     */
+    runSet::const_iterator findRun(const size_t index) const
+    {
+        return std::upper_bound(_holeRuns.begin(), _holeRuns.end(), index,
+                                [](const size_t value, const PixelRun &run)
+                                {
+                                    return value < run.first;
+                                }) - 1;
+    }
+
+    holeSet _holePixels;  // The Hole's pixels, of a Hole of pixels.
+    runSet _holeRuns;  // The Hole's runs, of a Hole of runs.
     holeSet _holeBoundary;  // The Hole's boundary pixels.
+    size_t _runPixelCount = 0;  // The number of pixels of the Hole's runs.
 
 };
 
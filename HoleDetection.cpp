@@ -0,0 +1,658 @@
+/**
+ * @file HoleDetection.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the hole detection functions implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include "HoleDetection.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def NO_LABEL 0
+ * @brief A Macro that sets the label of a pixel which is not part of any hole.
+ */
+#define NO_LABEL 0
+
+/**
+ * @def NO_HOLE -1
+ * @brief A Macro that sets the hole index of a label which is not yet resolved.
+ */
+#define NO_HOLE (-1)
+
+/**
+ * @def MIN_STRIP_ROWS 64
+ * @brief A Macro that sets the minimal number of rows of a strip of the parallel labelling, so
+ *        a small mask is labelled by a single thread.
+ */
+#define MIN_STRIP_ROWS 64
+
+
+/*-----=  Union-Find Functions  =-----*/
+
+
+/**
+ * @brief Finds the root label of the given label, while halving the path to the root.
+ * @param parents The parent of every label, a root label is its own parent.
+ * @param label The label to find its root.
+ * @return The root label.
+ */
+static int findRoot(std::vector<int> &parents, int label)
+{
+    while (parents[label] != label)
+    {
+        parents[label] = parents[parents[label]];
+        label = parents[label];
+    }
+    return label;
+}
+
+/**
+ * @brief Unite the sets of the two given labels. The smaller root label becomes the root
+ *        of the united set, so the root of a hole is always the label of its first pixel.
+ * @param parents The parent of every label, a root label is its own parent.
+ * @param lhs The first label.
+ * @param rhs The second label.
+ */
+static void uniteLabels(std::vector<int> &parents, const int lhs, const int rhs)
+{
+    const int lhsRoot = findRoot(parents, lhs);
+    const int rhsRoot = findRoot(parents, rhs);
+    if (lhsRoot < rhsRoot)
+    {
+        parents[rhsRoot] = lhsRoot;
+    }
+    else
+    {
+        parents[lhsRoot] = rhsRoot;
+    }
+}
+
+
+/**
+ * @brief Finds the root label of the given label like findRoot, in parents which other threads
+ *        unite at the same time. The path is halved only if no other thread has changed it.
+ * @param parents The parent of every label, a root label is its own parent.
+ * @param label The label to find its root.
+ * @return The root label.
+ */
+static int findSharedRoot(std::vector<int> &parents, int label)
+{
+    int parent = __atomic_load_n(&parents[label], __ATOMIC_ACQUIRE);
+    while (parent != label)
+    {
+        // The parent of a label is always smaller than it, so the grandparent stays an
+        // ancestor of the label even if the link is changed by another thread.
+        const int grandparent = __atomic_load_n(&parents[parent], __ATOMIC_ACQUIRE);
+        int expected = parent;
+        __atomic_compare_exchange_n(&parents[label], &expected, grandparent, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+        label = grandparent;
+        parent = __atomic_load_n(&parents[label], __ATOMIC_ACQUIRE);
+    }
+    return label;
+}
+
+/**
+ * @brief Unite the sets of the two given labels like uniteLabels, without a lock, in parents
+ *        which other threads unite at the same time. The larger root is linked to the smaller
+ *        root only if it is still a root, and otherwise the roots are found again.
+ * @param parents The parent of every label, a root label is its own parent.
+ * @param lhs The first label.
+ * @param rhs The second label.
+ */
+static void uniteSharedLabels(std::vector<int> &parents, int lhs, int rhs)
+{
+    while (true)
+    {
+        lhs = findSharedRoot(parents, lhs);
+        rhs = findSharedRoot(parents, rhs);
+        if (lhs == rhs)
+        {
+            return;
+        }
+        if (lhs > rhs)
+        {
+            std::swap(lhs, rhs);
+        }
+        int expected = rhs;
+        if (__atomic_compare_exchange_n(&parents[rhs], &expected, lhs, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE))
+        {
+            return;
+        }
+    }
+}
+
+
+/*-----=  Mask Scan Functions  =-----*/
+
+
+/**
+ * @brief Returns the index of the lowest set bit of the given word, and clears it.
+ * @param word The word, not 0.
+ * @return The index of the lowest set bit.
+ */
+static int popLowestBit(uint64_t &word)
+{
+    const int bit = __builtin_ctzll(word);
+    word &= word - 1;
+    return bit;
+}
+
+/**
+ * @brief Returns the pixels of the given word of a row which are missing or neighbour a
+ *        missing pixel, by the missing pixels of the row and of the rows above and below it.
+ * @param mask The mask of the missing pixels.
+ * @param x The row number.
+ * @param word The index of the word in the row.
+ * @return The word of the pixels which are missing or neighbour a missing pixel.
+ */
+static uint64_t getNearWord(const HoleMask &mask, const int x, const size_t word)
+{
+    const size_t rowWords = mask.getRowWords();
+    auto columnWord = [&](const size_t index) -> uint64_t
+    {
+        uint64_t missing = mask.getRow(x)[index];
+        if (x > INITIAL_ROW)
+        {
+            missing |= mask.getRow(x - 1)[index];
+        }
+        if (x + 1 < mask.getRows())
+        {
+            missing |= mask.getRow(x + 1)[index];
+        }
+        return missing;
+    };
+    const uint64_t missing = columnWord(word);
+    uint64_t near = missing | (missing << 1) | (missing >> 1);
+    if (word > 0)
+    {
+        near |= columnWord(word - 1) >> (MASK_WORD_BITS - 1);
+    }
+    if (word + 1 < rowWords)
+    {
+        near |= columnWord(word + 1) << (MASK_WORD_BITS - 1);
+    }
+    const int lastBits = mask.getCols() % MASK_WORD_BITS;
+    if (word + 1 == rowWords && lastBits != 0)
+    {
+        // Clear the bits after the last column.
+        near &= ((uint64_t) 1 << lastBits) - 1;
+    }
+    return near;
+}
+
+
+/*-----=  Capacity Functions  =-----*/
+
+
+/**
+ * @brief Adds the given label extent to the given hole extent.
+ * @param holeExtent The extent of the hole.
+ * @param labelExtent The extent of a label of the hole.
+ */
+static void mergeExtent(LabelExtent &holeExtent, const LabelExtent &labelExtent)
+{
+    holeExtent.count += labelExtent.count;
+    holeExtent.runs += labelExtent.runs;
+    holeExtent.firstRow = std::min(holeExtent.firstRow, labelExtent.firstRow);
+    holeExtent.lastRow = std::max(holeExtent.lastRow, labelExtent.lastRow);
+    holeExtent.firstCol = std::min(holeExtent.firstCol, labelExtent.firstCol);
+    holeExtent.lastCol = std::max(holeExtent.lastCol, labelExtent.lastCol);
+}
+
+/**
+ * @brief Returns an upper bound of the number of boundary pixels of a hole. Every boundary
+ *        pixel neighbours a hole pixel, so it is in the bounding box of the hole grown by a
+ *        pixel, and there are at most connectivity boundary pixels for every hole pixel.
+ * @param extent The extent of the hole.
+ * @param rows The number of rows of the mask.
+ * @param cols The number of columns of the mask.
+ * @param connectivity The pixel connectivity value.
+ * @return The upper bound of the number of boundary pixels.
+ */
+static size_t getBoundaryBound(const LabelExtent &extent, const int rows, const int cols,
+                               const int connectivity)
+{
+    const size_t boxRows = (size_t) (std::min(extent.lastRow + 1, rows - 1) -
+                                     std::max(extent.firstRow - 1, INITIAL_ROW) + 1);
+    const size_t boxCols = (size_t) (std::min(extent.lastCol + 1, cols - 1) -
+                                     std::max(extent.firstCol - 1, INITIAL_COLUMN) + 1);
+    return std::min(boxRows * boxCols - extent.count, (size_t) connectivity * extent.count);
+}
+
+
+/*-----=  Labelling Functions  =-----*/
+
+
+/**
+ * @brief Labels every missing pixel of the given rows using the neighbours that were already
+ *        scanned in these rows, and counts the pixels, the runs and the bounding box of every
+ *        label. The labels of the rows start at 1, and the rows above the first row are
+ *        ignored, so strips of rows can be labelled at the same time.
+ * @tparam Connectivity The pixel connectivity value.
+ * @param mask The mask of the missing pixels.
+ * @param firstRow The first row.
+ * @param endRow The row after the last row.
+ * @param labels The labels plane of the pixels, whose rows are set.
+ * @param parents Set to the parent of every label of the rows.
+ * @param labelExtents Set to the extent of every label of the rows.
+ */
+template <int Connectivity>
+static void labelRows(const HoleMask &mask, const int firstRow, const int endRow,
+                      std::vector<int> &labels, std::vector<int> &parents,
+                      std::vector<LabelExtent> &labelExtents)
+{
+    const int cols = mask.getCols();
+    const size_t rowWords = mask.getRowWords();
+    std::fill(labels.begin() + (size_t) firstRow * cols, labels.begin() + (size_t) endRow * cols,
+              NO_LABEL);
+    parents.assign(1, NO_LABEL);
+    labelExtents.assign(1, LabelExtent());
+    for (int x = firstRow; x < endRow; ++x)
+    {
+        const uint64_t *row = mask.getRow(x);
+        int *rowLabels = labels.data() + (size_t) x * cols;
+        const int *previousLabels = (x > firstRow) ? rowLabels - cols : nullptr;
+        for (size_t word = 0; word < rowWords; ++word)
+        {
+            // A word of known pixels is skipped at once.
+            for (uint64_t missing = row[word]; missing != 0; )
+            {
+                const int y = (int) (word * MASK_WORD_BITS) + popLowestBit(missing);
+                int scannedLabels[MAX_CONNECTIVITY / 2];
+                int scannedCount = 0;
+                if (y > INITIAL_COLUMN)
+                {
+                    scannedLabels[scannedCount++] = rowLabels[y - 1];
+                }
+                if (x > firstRow)
+                {
+                    scannedLabels[scannedCount++] = previousLabels[y];
+                    if (Connectivity == 8)
+                    {
+                        if (y > INITIAL_COLUMN)
+                        {
+                            scannedLabels[scannedCount++] = previousLabels[y - 1];
+                        }
+                        if (y + 1 < cols)
+                        {
+                            scannedLabels[scannedCount++] = previousLabels[y + 1];
+                        }
+                    }
+                }
+
+                int label = NO_LABEL;
+                for (int i = 0; i < scannedCount; ++i)
+                {
+                    if (scannedLabels[i] == NO_LABEL)
+                    {
+                        continue;
+                    }
+                    if (label == NO_LABEL)
+                    {
+                        label = scannedLabels[i];
+                    }
+                    else if (scannedLabels[i] != label)
+                    {
+                        uniteLabels(parents, label, scannedLabels[i]);
+                    }
+                }
+                if (label == NO_LABEL)
+                {
+                    // This pixel starts a new hole.
+                    label = (int) parents.size();
+                    parents.push_back(label);
+                    labelExtents.push_back({0, 0, x, x, y, y});
+                }
+                rowLabels[y] = label;
+                LabelExtent &extent = labelExtents[label];
+                ++extent.count;
+                if (y == INITIAL_COLUMN || rowLabels[y - 1] == NO_LABEL)
+                {
+                    ++extent.runs;
+                }
+                extent.lastRow = x;
+                extent.firstCol = std::min(extent.firstCol, y);
+                extent.lastCol = std::max(extent.lastCol, y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Labels every missing pixel of the mask like labelRows, in parallel over horizontal
+ *        strips of the mask. Every strip is labelled on its own, the labels of the strips are
+ *        moved to ranges of their own in the labels of the mask, and the labels of the first
+ *        row of every strip are united with the labels of their neighbours in the row above the
+ *        strip (by the neighbours of the connectivity, so the diagonal neighbours are united in
+ *        8-connectivity), by a lock-free union-find, since the seams are united in parallel.
+ *        The labels of every strip are created in a row-major order and the moved ranges are in
+ *        the order of the strips, so the root of a hole is still the label of its first pixel.
+ * @tparam Connectivity The pixel connectivity value.
+ * @param mask The mask of the missing pixels.
+ * @param stripCount The number of strips, at least 2.
+ * @param scratch The buffers of the labelling, whose labels, parents and label extents are set.
+ * @param threadPool The threads used in the labelling.
+ */
+template <int Connectivity>
+static void labelStrips(const HoleMask &mask, const size_t stripCount, LabellingScratch &scratch,
+                        ThreadPool &threadPool)
+{
+    const int rows = mask.getRows();
+    const int cols = mask.getCols();
+    const size_t rowWords = mask.getRowWords();
+    std::vector<int> &labels = scratch.labels;
+    std::vector<int> &parents = scratch.parents;
+    std::vector<LabelExtent> &labelExtents = scratch.labelExtents;
+    std::vector<LabelStrip> &strips = scratch.strips;
+    strips.resize(stripCount);
+    for (size_t i = 0; i < stripCount; ++i)
+    {
+        strips[i].firstRow = (int) (rows * i / stripCount);
+        strips[i].endRow = (int) (rows * (i + 1) / stripCount);
+    }
+    threadPool.parallelFor(stripCount, 1, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            labelRows<Connectivity>(mask, strips[i].firstRow, strips[i].endRow, labels,
+                                    strips[i].parents, strips[i].labelExtents);
+        }
+    });
+
+    // Move the labels of every strip after the labels of the strips above it.
+    int labelCount = NO_LABEL + 1;
+    for (LabelStrip &strip : strips)
+    {
+        strip.labelOffset = labelCount - (NO_LABEL + 1);
+        labelCount += (int) strip.parents.size() - (NO_LABEL + 1);
+    }
+    parents.resize(labelCount);
+    labelExtents.resize(labelCount);
+    parents[NO_LABEL] = NO_LABEL;
+    threadPool.parallelFor(stripCount, 1, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const LabelStrip &strip = strips[i];
+            const int offset = strip.labelOffset;
+            for (int label = NO_LABEL + 1; label < (int) strip.parents.size(); ++label)
+            {
+                parents[offset + label] = offset + strip.parents[label];
+                labelExtents[offset + label] = strip.labelExtents[label];
+            }
+            if (offset == 0)
+            {
+                continue;
+            }
+            for (int x = strip.firstRow; x < strip.endRow; ++x)
+            {
+                const uint64_t *row = mask.getRow(x);
+                int *rowLabels = labels.data() + (size_t) x * cols;
+                for (size_t word = 0; word < rowWords; ++word)
+                {
+                    for (uint64_t missing = row[word]; missing != 0; )
+                    {
+                        rowLabels[word * MASK_WORD_BITS + popLowestBit(missing)] += offset;
+                    }
+                }
+            }
+        }
+    });
+
+    // Unite the labels which meet across the seams, the seam above every strip but the first.
+    threadPool.parallelFor(stripCount - 1, 1, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const int x = strips[i + 1].firstRow;
+            const uint64_t *row = mask.getRow(x);
+            const int *rowLabels = labels.data() + (size_t) x * cols;
+            for (size_t word = 0; word < rowWords; ++word)
+            {
+                for (uint64_t missing = row[word]; missing != 0; )
+                {
+                    const int y = (int) (word * MASK_WORD_BITS) + popLowestBit(missing);
+                    forEachNeighbour<Connectivity>(Pixel(x, y), rows, cols, [&](
+                        const int neighbourX, const int neighbourY)
+                    {
+                        const int label = labels[(size_t) neighbourX * cols + neighbourY];
+                        if (neighbourX < x && label != NO_LABEL)
+                        {
+                            uniteSharedLabels(parents, rowLabels[y], label);
+                        }
+                    });
+                }
+            }
+        }
+    });
+}
+
+
+/*-----=  Hole Detection Functions  =-----*/
+
+
+/**
+ * @brief Finds all the holes of the mask and their boundaries, see findHoles.
+ * @tparam Connectivity The pixel connectivity value.
+ * @param mask The mask of the missing pixels.
+ * @param scratch The buffers of the labelling.
+ * @param arena The arena of the pixels of the holes, which is reset, nullptr for the heap.
+ * @param holes Set to the holes of the mask.
+ * @param threadPool The threads used in the labelling, nullptr for a serial labelling.
+ */
+template <int Connectivity>
+static void labelHoles(const HoleMask &mask, LabellingScratch &scratch, MonotonicArena *arena,
+                       std::vector<Hole> &holes, ThreadPool *threadPool)
+{
+    const int rows = mask.getRows();
+    const int cols = mask.getCols();
+    const size_t rowWords = mask.getRowWords();
+    std::vector<int> &labels = scratch.labels;
+    std::vector<int> &parents = scratch.parents;
+    std::vector<LabelExtent> &labelExtents = scratch.labelExtents;
+    labels.resize((size_t) rows * cols);
+
+    // First pass, label every missing pixel, and count the pixels, the runs and the bounding box
+    // of every label. A large mask is labelled in strips by all the threads.
+    const size_t stripCount = (threadPool == nullptr) ? 1 :
+                              std::min((size_t) threadPool->getThreadCount(),
+                                       (size_t) (rows / MIN_STRIP_ROWS));
+    if (stripCount > 1)
+    {
+        labelStrips<Connectivity>(mask, stripCount, scratch, *threadPool);
+    }
+    else
+    {
+        labelRows<Connectivity>(mask, INITIAL_ROW, rows, labels, parents, labelExtents);
+    }
+
+    // Resolve every label to the index of its hole, ordered by the root labels, and add up the
+    // extents of the labels of every hole.
+    std::vector<int> &holeIndices = scratch.holeIndices;
+    std::vector<LabelExtent> &holeExtents = scratch.holeExtents;
+    holeIndices.assign(parents.size(), NO_HOLE);
+    holeExtents.clear();
+    for (int label = NO_LABEL + 1; label < (int) parents.size(); ++label)
+    {
+        const int root = findRoot(parents, label);
+        if (root == label)
+        {
+            holeIndices[label] = (int) holeExtents.size();
+            holeExtents.push_back(labelExtents[label]);
+        }
+        else
+        {
+            holeIndices[label] = holeIndices[root];
+            mergeExtent(holeExtents[holeIndices[root]], labelExtents[label]);
+        }
+    }
+
+    // Allocate every hole once, by its number of runs and the bound of its boundary.
+    size_t holeBytes = 0;
+    for (const LabelExtent &extent : holeExtents)
+    {
+        holeBytes += extent.runs * sizeof(PixelRun) +
+                     getBoundaryBound(extent, rows, cols, Connectivity) * sizeof(Pixel);
+    }
+    holes.clear();
+    if (arena != nullptr)
+    {
+        arena->reset(holeBytes);
+    }
+    for (const LabelExtent &extent : holeExtents)
+    {
+        holes.emplace_back(arena);
+        holes.back().reserveRuns(extent.runs, getBoundaryBound(extent, rows, cols, Connectivity));
+    }
+
+    // Second pass, collect the runs of every hole and every boundary pixel. Only the pixels
+    // which are missing or neighbour a missing pixel are visited, in a row-major order, and the
+    // missing pixels of a word are collected a run at a time.
+    for (int x = INITIAL_ROW; x < rows; ++x)
+    {
+        const uint64_t *row = mask.getRow(x);
+        const int *rowLabels = labels.data() + (size_t) x * cols;
+        for (size_t word = 0; word < rowWords; ++word)
+        {
+            const int wordColumn = (int) (word * MASK_WORD_BITS);
+            for (uint64_t missing = row[word]; missing != 0; )
+            {
+                // The run of the lowest missing pixel ends at the first known pixel after it.
+                const int start = __builtin_ctzll(missing);
+                const uint64_t known = ~(missing | (((uint64_t) 1 << start) - 1));
+                const int end = (known != 0) ? __builtin_ctzll(known) : MASK_WORD_BITS;
+                holes[holeIndices[rowLabels[wordColumn + start]]].addHoleRun(
+                    x, wordColumn + start, wordColumn + end);
+                missing &= (end < MASK_WORD_BITS) ? ~(((uint64_t) 1 << end) - 1) : 0;
+            }
+            for (uint64_t near = getNearWord(mask, x, word) & ~row[word]; near != 0; )
+            {
+                const int y = wordColumn + popLowestBit(near);
+
+                // A known pixel is a boundary pixel of every hole it neighbours.
+                int adjacentHoles[MAX_CONNECTIVITY];
+                int adjacentCount = 0;
+                forEachNeighbour<Connectivity>(Pixel(x, y), rows, cols, [&](const int neighbourX,
+                                                                           const int neighbourY)
+                {
+                    const int label = labels[(size_t) neighbourX * cols + neighbourY];
+                    if (label == NO_LABEL)
+                    {
+                        return;
+                    }
+                    const int holeIndex = holeIndices[label];
+                    for (int j = 0; j < adjacentCount; ++j)
+                    {
+                        if (adjacentHoles[j] == holeIndex)
+                        {
+                            return;
+                        }
+                    }
+                    adjacentHoles[adjacentCount++] = holeIndex;
+                });
+                for (int j = 0; j < adjacentCount; ++j)
+                {
+                    holes[adjacentHoles[j]].addHoleBoundary(Pixel(x, y));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries using a connected component
+ *        labelling with union-find. The first pass labels the missing pixels, the second pass
+ *        collects every hole pixel and every boundary pixel, and both passes skip the words of
+ *        the mask which have no missing pixels near them.
+ *        The holes are ordered by their first pixel in a row-major scan of the mask.
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @return The holes of the mask, empty if the mask has no missing pixels.
+ */
+std::vector<Hole> findHoles(const HoleMask &mask, const int connectivity)
+{
+    std::vector<int> labels;
+    return findHoles(mask, connectivity, labels);
+}
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries, see findHoles, using the
+ *        given labels plane, so a plane can be reused between masks without allocations.
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @param labels The labels plane of the pixels, resized to the size of the mask.
+ * @return The holes of the mask, empty if the mask has no missing pixels.
+ */
+std::vector<Hole> findHoles(const HoleMask &mask, const int connectivity,
+                            std::vector<int> &labels)
+{
+    LabellingScratch scratch;
+    scratch.labels.swap(labels);
+    std::vector<Hole> holes;
+    findHoles(mask, connectivity, scratch, nullptr, holes);
+    labels.swap(scratch.labels);
+    return holes;
+}
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries, see findHoles, into the
+ *        given holes, whose pixels are allocated from the given arena. The first pass counts
+ *        the pixels and the bounding box of every hole, so the arena is reset once with room
+ *        for all the holes and every hole is allocated once. Reusing the buffers, the arena
+ *        and the holes between masks allocates nothing once they are large enough. The holes
+ *        of an arena are valid until it is reset (by the next call with it).
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @param scratch The buffers of the labelling.
+ * @param arena The arena of the pixels of the holes, which is reset, nullptr for the heap.
+ * @param holes Set to the holes of the mask.
+ */
+void findHoles(const HoleMask &mask, const int connectivity, LabellingScratch &scratch,
+               MonotonicArena *arena, std::vector<Hole> &holes, ThreadPool *threadPool)
+{
+    INSTRUMENT_SCOPE("findHoles");
+    if (connectivity == 8)
+    {
+        labelHoles<8>(mask, scratch, arena, holes, threadPool);
+    }
+    else
+    {
+        labelHoles<4>(mask, scratch, arena, holes, threadPool);
+    }
+#ifdef HOLEFILLING_INSTRUMENTATION
+    size_t holePixelCount = 0;
+    size_t boundaryPixelCount = 0;
+    for (const Hole &hole : holes)
+    {
+        holePixelCount += hole.getHoleSize();
+        boundaryPixelCount += hole.getHoleBoundary().size();
+    }
+    INSTRUMENT_COUNT("holes", holes.size());
+    INSTRUMENT_COUNT("hole pixels", holePixelCount);
+    INSTRUMENT_COUNT("boundary pixels", boundaryPixelCount);
+#endif
+}
+
+/**
+ * @brief Finds all the holes in the image and their boundaries, i.e. the holes of the mask of
+ *        its MISSING_VALUE pixels, see findHoles of a HoleMask.
+ * @param image The image to search in.
+ * @param connectivity The pixel connectivity value.
+ * @return The holes in the image, empty if the image has no missing pixels.
+ */
+std::vector<Hole> findHoles(const Image &image, const int connectivity)
+{
+    return findHoles(HoleMask::fromImage(image), connectivity);
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * @file HoleDetection.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the hole detection functions.
+ */
+
+
+#ifndef HOLEDETECTION_H
+#define HOLEDETECTION_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "Hole.h"
+#include "HoleMask.h"
+#include "MonotonicArena.h"
+#include "ThreadPool.h"
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The number of pixels and the bounding box of a label, or of a hole, of the labelling.
+ */
+struct LabelExtent
+{
+    size_t count;  // The number of pixels.
+    size_t runs;  // The number of horizontal runs of the pixels.
+    int firstRow;  // The first row of the pixels.
+    int lastRow;  // The last row of the pixels.
+    int firstCol;  // The first column of the pixels.
+    int lastCol;  // The last column of the pixels.
+};
+
+/**
+ * @brief A strip of rows of the mask, which the parallel labelling labels on its own, with
+ *        labels of it's own.
+ */
+struct LabelStrip
+{
+    int firstRow;  // The first row of the strip.
+    int endRow;  // The row after the last row of the strip.
+    int labelOffset;  // The offset of the labels of the strip in the labels of the mask.
+    std::vector<int> parents;  // The parent of every label of the strip.
+    std::vector<LabelExtent> labelExtents;  // The extent of every label of the strip.
+};
+
+/**
+ * @brief The buffers of the labelling of the hole detection, which keep their allocations
+ *        between masks.
+ */
+struct LabellingScratch
+{
+    std::vector<int> labels;  // The labels plane of the pixels.
+    std::vector<int> parents;  // The parent of every label in the union-find.
+    std::vector<int> holeIndices;  // The index of the hole of every label.
+    std::vector<LabelExtent> labelExtents;  // The extent of every label.
+    std::vector<LabelExtent> holeExtents;  // The extent of every hole.
+    std::vector<LabelStrip> strips;  // The strips of the parallel labelling.
+};
+
+
+/*-----=  Hole Detection Functions  =-----*/
+
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries using a connected component
+ *        labelling with union-find. The first pass labels the missing pixels, the second pass
+ *        collects every hole pixel and every boundary pixel, and both passes skip the words of
+ *        the mask which have no missing pixels near them.
+ *        The holes are ordered by their first pixel in a row-major scan of the mask.
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @return The holes of the mask, empty if the mask has no missing pixels.
+ */
+std::vector<Hole> findHoles(const HoleMask &mask, const int connectivity);
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries, see findHoles, using the
+ *        given labels plane, so a plane can be reused between masks without allocations.
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @param labels The labels plane of the pixels, resized to the size of the mask.
+ * @return The holes of the mask, empty if the mask has no missing pixels.
+ */
+std::vector<Hole> findHoles(const HoleMask &mask, const int connectivity,
+                            std::vector<int> &labels);
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries, see findHoles, into the
+ *        given holes, whose pixels are allocated from the given arena. The first pass counts
+ *        the pixels and the bounding box of every hole, so the arena is reset once with room
+ *        for all the holes and every hole is allocated once. Reusing the buffers, the arena
+ *        and the holes between masks allocates nothing once they are large enough. The holes
+ *        of an arena are valid until it is reset (by the next call with it).
+ *        With a pool of several threads, a large mask is split into horizontal strips, one
+ *        per thread, which the first pass labels in parallel, and the labels which meet
+ *        across the seams of the strips are united by a lock-free union-find. The holes are
+ *        the same as the holes of the serial labelling, in the same order.
+ * @param mask The mask of the missing pixels.
+ * @param connectivity The pixel connectivity value.
+ * @param scratch The buffers of the labelling.
+ * @param arena The arena of the pixels of the holes, which is reset, nullptr for the heap.
+ * @param holes Set to the holes of the mask.
+ * @param threadPool The threads used in the labelling, nullptr for a serial labelling.
+ */
+void findHoles(const HoleMask &mask, const int connectivity, LabellingScratch &scratch,
+               MonotonicArena *arena, std::vector<Hole> &holes,
+               ThreadPool *threadPool = nullptr);
+
+/**
+ * @brief Finds all the holes in the image and their boundaries, i.e. the holes of the mask of
+ *        its MISSING_VALUE pixels, see findHoles of a HoleMask.
+ * @param image The image to search in.
+ * @param connectivity The pixel connectivity value.
+ * @return The holes in the image, empty if the image has no missing pixels.
+ */
+std::vector<Hole> findHoles(const Image &image, const int connectivity);
+
+
+#endif
\ No newline at end of file
@@ -60,4 +60,39 @@ public:
 };
 
 
-#endif
\ No newline at end of file
+
+/**
+ * @brief A Hole Exception Class for a raw image which can't be opened or whose size doesn't
+ *        match the given size of the image.
+ */
+class InvalidRawImageException : public HoleException
+{
+public:
+
+    /**
+     * @brief Describe the error that occurred when this Exception was thrown.
+     * @return An informative message about the Exception.
+     */
+    virtual const char * what() const throw() override
+    {
+        return "Invalid raw image, it can't be opened or it's size doesn't match.";
+    };
+};
+
+
+/**
+ * @brief A Hole Exception Class for a raw image which can't be memory mapped.
+ */
+class MappingFailedException : public HoleException
+{
+public:
+
+    /**
+     * @brief Describe the error that occurred when this Exception was thrown.
+     * @return An informative message about the Exception.
+     */
+    virtual const char * what() const throw() override { return "Can't map the raw image."; };
+};
+
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file HoleExtractor.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the HoleExtractor Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <limits>
+#include "HoleExtractor.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def NOT_VISITED 0
+ * @brief A Macro that sets the stamp of a pixel which was never visited.
+ */
+#define NOT_VISITED 0
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the HoleExtractor.
+ * @param connectivity The pixel connectivity value.
+ */
+HoleExtractor::HoleExtractor(const int connectivity) : _connectivity(connectivity), _rows(0),
+                                                         _cols(0), _generation(NOT_VISITED)
+{
+
+}
+
+/**
+ * @brief Prepare the visited plane for a new BFS in an image of the given size.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ */
+void HoleExtractor::beginGeneration(const int rows, const int cols)
+{
+    if (rows != _rows || cols != _cols)
+    {
+        // A new image size, allocate a new plane.
+        _rows = rows;
+        _cols = cols;
+        _visited.assign((size_t) rows * cols, NOT_VISITED);
+        _generation = NOT_VISITED;
+    }
+    if (_generation == std::numeric_limits<unsigned int>::max())
+    {
+        // The stamps wrapped around, this is the only case the plane is cleared.
+        std::fill(_visited.begin(), _visited.end(), NOT_VISITED);
+        _generation = NOT_VISITED;
+    }
+    ++_generation;
+}
+
+/**
+ * @brief Calculate the hole in the image from a given missing pixel using BFS.
+ * @tparam Connectivity The pixel connectivity value.
+ * @param image The image containing the hole.
+ * @param missingPixel A missing pixel inside the hole.
+ * @return A Hole class representing the hole in the image.
+ */
+template <int Connectivity>
+Hole HoleExtractor::traverseHole(const Image &image, const Pixel &missingPixel)
+{
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    Hole hole;
+
+    // Set data for the BFS algorithm.
+    beginGeneration(rows, cols);
+    _pixelQueue.clear();
+
+    // Update data according to the given missing pixel.
+    _pixelQueue.push_back(missingPixel);
+    _visited[(size_t) missingPixel.getX() * cols + missingPixel.getY()] = _generation;
+
+    for (size_t queueHead = 0; queueHead < _pixelQueue.size(); ++queueHead)
+    {
+        // Get the next pixel from the queue and add it to the hole.
+        const Pixel currentPixel = _pixelQueue[queueHead];
+        hole.addHolePixels(currentPixel);
+
+        // Traverse the neighbours according the the pixel connectivity.
+        forEachNeighbour<Connectivity>(currentPixel, rows, cols, [&](const int currentX,
+                                                                     const int currentY)
+        {
+            unsigned int &visited = _visited[(size_t) currentX * cols + currentY];
+            if (visited != _generation)
+            {
+                // If this pixel hasn't been visited we process it and mark as visited.
+                visited = _generation;
+                if (image.at(currentX, currentY) == MISSING_VALUE)
+                {
+                    // Add this pixel to the queue for next iterations.
+                    _pixelQueue.emplace_back(currentX, currentY);
+                }
+                else
+                {
+                    // Don't add this pixel to the queue, instead add it to the boundary.
+                    hole.addHoleBoundary(Pixel(currentX, currentY));
+                }
+            }
+        });
+    }
+
+    return hole;
+}
+
+/**
+ * @brief Calculate the hole in the image from a given missing pixel using BFS.
+ *        The running time is linear in the size of the hole and its boundary.
+ * @param image The image containing the hole.
+ * @param missingPixel A missing pixel inside the hole.
+ * @return A Hole class representing the hole in the image.
+ */
+Hole HoleExtractor::calculateHole(const Image &image, const Pixel &missingPixel)
+{
+    INSTRUMENT_SCOPE("calculateHole");
+    return (_connectivity == 8) ? traverseHole<8>(image, missingPixel) :
+                                  traverseHole<4>(image, missingPixel);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file HoleExtractor.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the HoleExtractor Class.
+ */
+
+
+#ifndef HOLEEXTRACTOR_H
+#define HOLEEXTRACTOR_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "Hole.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class which extracts holes from images using BFS, and keeps its scratch data
+ *        between calls. The visited pixels are kept in a generation-stamped plane, a pixel
+ *        is visited in the current call iff its stamp equals the current generation, so the
+ *        plane is never cleared and every call only touches the pixels the BFS visits.
+ *        The plane is reallocated only when the image size changes.
+ */
+class HoleExtractor
+{
+public:
+    /**
+     * @brief A Constructor for the HoleExtractor.
+     * @param connectivity The pixel connectivity value.
+     */
+    explicit HoleExtractor(const int connectivity);
+
+    /**
+     * @brief Calculate the hole in the image from a given missing pixel using BFS.
+     *        The running time is linear in the size of the hole and its boundary.
+     * @param image The image containing the hole.
+     * @param missingPixel A missing pixel inside the hole.
+     * @return A Hole class representing the hole in the image.
+     */
+    Hole calculateHole(const Image &image, const Pixel &missingPixel);
+
+private:
+    /**
+     * @brief Prepare the visited plane for a new BFS in an image of the given size.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     */
+    void beginGeneration(const int rows, const int cols);
+
+    /**
+     * @brief Calculate the hole in the image from a given missing pixel using BFS.
+     * @tparam Connectivity The pixel connectivity value.
+     * @param image The image containing the hole.
+     * @param missingPixel A missing pixel inside the hole.
+     * @return A Hole class representing the hole in the image.
+     */
+    template <int Connectivity>
+    Hole traverseHole(const Image &image, const Pixel &missingPixel);
+
+    int _connectivity;  // The pixel connectivity value.
+    int _rows;  // The number of rows of the visited plane.
+    int _cols;  // The number of columns of the visited plane.
+    unsigned int _generation;  // The stamp of the pixels visited in the current call.
+    std::vector<unsigned int> _visited;  // The generation in which every pixel was visited.
+    std::vector<Pixel> _pixelQueue;  // The BFS queue.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,1902 @@
+/**
+ * @file HoleFiller.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the HoleFiller Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include "HoleFiller.h"
+#include "HoleDetection.h"
+#include "WeightFunctions.h"
+#include "ConvolutionFill.h"
+#include "BoundaryQuadtree.h"
+#include "HoleSchedule.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def NEIGHBOURS_CHUNK_SIZE 1024
+ * @brief A Macro that sets the number of layer pixels filled by a single task of a thread.
+ */
+#define NEIGHBOURS_CHUNK_SIZE 1024
+
+/**
+ * @def KNOWN_LAYER -1
+ * @brief A Macro that sets the layer of a known pixel in the neighbours fill.
+ */
+#define KNOWN_LAYER (-1)
+
+/**
+ * @def UNASSIGNED_LAYER INT_MAX
+ * @brief A Macro that sets the layer of a hole pixel which wasn't reached yet by the BFS.
+ */
+#define UNASSIGNED_LAYER INT_MAX
+
+/**
+ * @def CONVOLUTION_CROSSOVER 8
+ * @brief A Macro that sets the ratio of the cost of a boundary pair in the exact fill to the
+ *        cost of a transform operation in the convolution, above which the convolution is used.
+ */
+#define CONVOLUTION_CROSSOVER 8
+
+/**
+ * @def GPU_MIN_PAIRS 4194304
+ * @brief A Macro that sets the minimal number of hole and boundary pixel pairs of a hole which
+ *        is filled on the GPU in the automatic device mode, below which the transfers cost more
+ *        than the fill.
+ */
+#define GPU_MIN_PAIRS 4194304
+
+/**
+ * @def MAX_INTEGER_Z 4
+ * @brief A Macro that sets the maximal integer z value with a compile time weighted function.
+ */
+#define MAX_INTEGER_Z 4
+
+/**
+ * @def PYRAMID_MAX_EXACT_PIXELS 4096
+ * @brief A Macro that sets the maximal number of missing pixels in the coarsest level of the
+ *        pyramid, which is filled by the exact fill.
+ */
+#define PYRAMID_MAX_EXACT_PIXELS 4096
+
+/**
+ * @def PYRAMID_WINDOW_RADIUS 2
+ * @brief A Macro that sets the radius of the local window used to refine every level.
+ */
+#define PYRAMID_WINDOW_RADIUS 2
+
+/**
+ * @def FILL_CHUNK_SIZE 64
+ * @brief A Macro that sets the number of hole pixels filled by a single task of a thread.
+ */
+#define FILL_CHUNK_SIZE 64
+
+/**
+ * @def KERNEL_BLOCK_SIZE 64
+ * @brief A Macro that sets the number of hole pixels which share every tile of the boundary
+ *        in the fill kernel.
+ */
+#define KERNEL_BLOCK_SIZE 64
+
+/**
+ * @def AUTO_APPROXIMATE_PAIRS 67108864
+ * @brief A Macro that sets the minimal number of hole and boundary pixel pairs of a hole which
+ *        the automatic strategy fills by the approximate fill, unless it is filled as a
+ *        convolution or on the GPU.
+ */
+#define AUTO_APPROXIMATE_PAIRS 67108864
+
+
+/*-----=  Hole Filling Functions  =-----*/
+
+
+/**
+ * @brief Runs the given task on all the indices in the range [0,count), by the threads of the
+ *        given pool, or by the calling thread alone if there is no pool.
+ * @tparam Task The type of the task, which processes the indices in the range [begin,end).
+ * @param threadPool The threads running the task, nullptr for the calling thread.
+ * @param count The number of indices.
+ * @param chunkSize The number of indices which are processed by a single task call.
+ * @param task The task to run.
+ */
+template <typename Task>
+static void forEachChunk(ThreadPool *threadPool, const size_t count, const size_t chunkSize,
+                         const Task &task)
+{
+    if (threadPool == nullptr)
+    {
+        task(0, count);
+        return;
+    }
+    threadPool->parallelFor(count, chunkSize, task);
+}
+
+/**
+ * @brief Fill the image hole of the given image with the given weighted function.
+ *        Every pixel depends only on the boundary, so chunks of the hole pixels are filled in
+ *        parallel by the threads of the given pool, and the results are written directly
+ *        into the image. The weighted function is a template parameter, so it is inlined in
+ *        the inner loop over the boundary.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ */
+template <typename T, typename WeightFunction>
+static void fillImageHole(BasicImage<T> &image, const Hole &hole,
+                          const WeightFunction &weightedFunction, ThreadPool *threadPool)
+{
+    const holeSet &boundaryPixels = hole.getHoleBoundary();
+    INSTRUMENT_COUNT("weight evaluations", hole.getHoleSize() * boundaryPixels.size());
+    std::vector<float> boundaryValues;
+    boundaryValues.reserve(boundaryPixels.size());
+    for (const Pixel &y : boundaryPixels)
+    {
+        boundaryValues.push_back(image.at(y));
+    }
+    forEachChunk(threadPool, hole.getHoleSize(), FILL_CHUNK_SIZE, [&](const size_t begin,
+                                                                      const size_t end)
+    {
+        hole.forEachHolePixel(begin, end, [&](const size_t, const Pixel &x)
+        {
+            // For every pixel x in the hole we update it's value using the
+            // weighted function and all the pixels in the hole boundary.
+            float numerator = 0;
+            float denominator = 0;
+            for (size_t j = 0; j < boundaryPixels.size(); ++j)
+            {
+                float weightedValue = weightedFunction(x, boundaryPixels[j]);
+                numerator += weightedValue * boundaryValues[j];
+                denominator += weightedValue;
+            }
+            if (denominator < MIN_WEIGHT_SUM)
+            {
+                // All the weights underflowed, so the pixel takes the limit of the fill.
+                numerator = 0;
+                denominator = 0;
+                forEachNearestPixel(x, boundaryPixels, [&](const size_t j)
+                {
+                    numerator += boundaryValues[j];
+                    ++denominator;
+                });
+            }
+            image.at(x) = toPixelValue<T>(numerator / denominator);
+        });
+    });
+}
+
+/**
+ * @brief Fill the image hole of the given image with the given fill kernel.
+ *        The boundary is packed once as struct-of-arrays, and the pixels in the hole are
+ *        computed by the vectorized fill kernel in blocks, so every tile of a large boundary
+ *        is read once per block instead of once per pixel. Every pixel depends only on the boundary,
+ *        so chunks of the hole pixels are filled in parallel by the threads of the given
+ *        pool, and the results are written directly into the image.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param boundary The boundary arrays to set.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ */
+template <typename T>
+static void kernelFillImageHole(BasicImage<T> &image, const Hole &hole, const FillKernel &kernel,
+                                BoundaryArrays &boundary, ThreadPool *threadPool)
+{
+    if (hole.getHoleBoundary().empty())
+    {
+        // A hole without a boundary stays missing.
+        return;
+    }
+    boundary.assign(image, hole.getHoleBoundary());
+    INSTRUMENT_COUNT("weight evaluations", hole.getHoleSize() * hole.getHoleBoundary().size());
+    forEachChunk(threadPool, hole.getHoleSize(), FILL_CHUNK_SIZE, [&](const size_t begin,
+                                                                      const size_t end)
+    {
+        // The pixels are filled in blocks, for which the kernel walks the boundary in tiles
+        // that stay in the cache.
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += KERNEL_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min((size_t) KERNEL_BLOCK_SIZE, end - blockBegin);
+            Pixel block[KERNEL_BLOCK_SIZE];
+            hole.forEachHolePixel(blockBegin, blockBegin + blockSize, [&](const size_t i,
+                                                                          const Pixel &x)
+            {
+                block[i - blockBegin] = x;
+            });
+            float numerators[KERNEL_BLOCK_SIZE] = {};
+            float denominators[KERNEL_BLOCK_SIZE] = {};
+            kernel.accumulate(boundary, block, blockSize, numerators, denominators);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                image.at(block[i]) = toPixelValue<T>(numerators[i] / denominators[i]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Fill the image hole of the given image with an approximation of the default
+ *        weighted function. A quadtree is built over the boundary, and the far clusters of
+ *        boundary pixels are replaced by their aggregated weight, see BoundaryQuadtree.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param config The parameters of the fill.
+ * @param boundary The boundary arrays to set.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ */
+template <typename T>
+static void approximateFillImageHole(BasicImage<T> &image, const Hole &hole,
+                                     const FillConfig &config, BoundaryArrays &boundary,
+                                     ThreadPool *threadPool)
+{
+    const FillKernel kernel(config.epsilon, config.z);
+    boundary.assign(image, hole.getHoleBoundary());
+    const BoundaryQuadtree quadtree(boundary, config.tolerance);
+    forEachChunk(threadPool, hole.getHoleSize(), FILL_CHUNK_SIZE, [&](const size_t begin,
+                                                                      const size_t end)
+    {
+        hole.forEachHolePixel(begin, end, [&](const size_t, const Pixel &x)
+        {
+            image.at(x) = toPixelValue<T>(quadtree.fill(kernel, x));
+        });
+    });
+}
+
+/**
+ * @brief Computes the size of the smallest box which contains any of the given holes and
+ *        its boundary, i.e. the maximal offsets between two pixels of the same hole.
+ * @param holes The holes in the image.
+ * @param rows Set to the number of rows in the box.
+ * @param cols Set to the number of columns in the box.
+ */
+static void getHolesExtent(const std::vector<Hole> &holes, int &rows, int &cols)
+{
+    rows = 0;
+    cols = 0;
+    for (const Hole &hole : holes)
+    {
+        if (hole.getHoleSize() == 0)
+        {
+            continue;
+        }
+        const HoleBox box = hole.getHoleBox();
+        int minX = box.firstRow;
+        int maxX = box.lastRow;
+        int minY = box.firstCol;
+        int maxY = box.lastCol;
+        for (const Pixel &x : hole.getHoleBoundary())
+        {
+            minX = std::min(minX, x.getX());
+            maxX = std::max(maxX, x.getX());
+            minY = std::min(minY, x.getY());
+            maxY = std::max(maxY, x.getY());
+        }
+        rows = std::max(rows, maxX - minX + 1);
+        cols = std::max(cols, maxY - minY + 1);
+    }
+}
+
+/**
+ * @brief Fill the image hole of the given image with the given weighted function as a
+ *        convolution, if the given mode allows it. In the automatic mode, the convolution is
+ *        used only if its estimated cost is below the cost of the direct exact fill.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param mode Whether to fill the hole as a convolution.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the transforms, 0 if the hole wasn't filled.
+ */
+template <typename T, typename WeightFunction>
+static size_t convolutionFillImageHole(BasicImage<T> &image, const Hole &hole,
+                                       const WeightFunction &weightedFunction,
+                                       const ConvolutionMode mode, ThreadPool &threadPool)
+{
+    if (mode == NEVER_CONVOLUTION)
+    {
+        return 0;
+    }
+    ConvolutionFill convolutionFill(hole);
+    const double directCost = (double) hole.getHoleSize() * hole.getHoleBoundary().size();
+    if (mode == AUTO_CONVOLUTION && directCost < CONVOLUTION_CROSSOVER * convolutionFill.getCost())
+    {
+        return 0;
+    }
+    convolutionFill.fill(image, hole, weightedFunction, threadPool);
+    INSTRUMENT_COUNT("bytes allocated", convolutionFill.getMemorySize());
+    return convolutionFill.getMemorySize();
+}
+
+/**
+ * @brief Returns the weight table of the given weighted function which covers the given
+ *        offsets, from the scratch. The table of the scratch is reused if it was computed for
+ *        the same weighted function and it is large enough, and otherwise it is computed again.
+ *        A table computed again for the same weighted function covers the offsets of the old
+ *        table too, if it fits, so the tables of images with holes of alternating sizes don't
+ *        thrash. The weight of an offset doesn't depend on the size of the table, so the fill
+ *        doesn't depend on the reuse.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param scratch The buffers of the fill.
+ * @param weightedFunction The weighted function of the table.
+ * @param config The parameters of the fill, which set the weighted function.
+ * @param rows The minimal number of rows in the table.
+ * @param cols The minimal number of columns in the table.
+ * @return The weight table.
+ */
+template <typename WeightFunction>
+static const WeightTable &getWeightTable(FillScratch &scratch,
+                                         const WeightFunction &weightedFunction,
+                                         const FillConfig &config, const int rows, const int cols)
+{
+    const FillConfig &tableConfig = scratch.tableConfig;
+    WeightTable &weightTable = scratch.weightTable;
+    const bool isSameWeight = weightTable.getRows() > 0 && tableConfig.weight == config.weight &&
+                              tableConfig.epsilon == config.epsilon &&
+                              tableConfig.z == config.z && tableConfig.sigma == config.sigma;
+    if (isSameWeight && weightTable.getRows() >= rows && weightTable.getCols() >= cols)
+    {
+        return weightTable;
+    }
+    int tableRows = rows;
+    int tableCols = cols;
+    if (isSameWeight && WeightTable::fits(std::max(rows, weightTable.getRows()),
+                                          std::max(cols, weightTable.getCols())))
+    {
+        tableRows = std::max(rows, weightTable.getRows());
+        tableCols = std::max(cols, weightTable.getCols());
+    }
+    weightTable = WeightTable(weightedFunction, tableRows, tableCols);
+    scratch.tableConfig = config;
+    INSTRUMENT_COUNT("bytes allocated", weightTable.getMemorySize());
+    return weightTable;
+}
+
+/**
+ * @brief Fill the given holes of an image by the given fill of a single hole, in the order of
+ *        their costs, see HoleSchedule. The split holes are filled one after the other, each
+ *        by all the threads of the pool. The batches of the other holes are filled in
+ *        parallel, every batch by a single thread with its own boundary arrays, so the threads
+ *        don't wait for each other between the holes of a batch.
+ * @tparam HoleFill The type of the fill of a single hole, which is called with the hole, the
+ *         boundary arrays it may set and the threads of its fill (nullptr for the calling
+ *         thread), and returns the number of bytes of its transforms.
+ * @param holes The holes in the image.
+ * @param excludedHoles The holes which are filled elsewhere, by their order in the holes.
+ * @param minSplitCost The minimal cost of a hole which is split, see HoleSchedule.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @param holeFill The fill of a single hole.
+ * @return The number of bytes of the largest transforms.
+ */
+template <typename HoleFill>
+static size_t scheduledFillImageHoles(const std::vector<Hole> &holes,
+                                      const std::vector<const Hole*> &excludedHoles,
+                                      const double minSplitCost, FillScratch &scratch,
+                                      ThreadPool &threadPool, const HoleFill &holeFill)
+{
+    HoleSchedule &schedule = scratch.schedule;
+    schedule.assign(holes, excludedHoles, threadPool.getThreadCount(), minSplitCost);
+    size_t transformsSize = 0;
+    for (const Hole *hole : schedule.getSplitHoles())
+    {
+        transformsSize = std::max(transformsSize, holeFill(*hole, scratch.boundary, &threadPool));
+    }
+    threadPool.parallelFor(schedule.getBatchCount(), 1, [&](const size_t begin, const size_t end)
+    {
+        BoundaryArrays boundary;
+        for (size_t batch = begin; batch < end; ++batch)
+        {
+            for (const Hole * const *hole = schedule.batchBegin(batch);
+                 hole != schedule.batchEnd(batch); ++hole)
+            {
+                holeFill(**hole, boundary, nullptr);
+            }
+        }
+    });
+    return transformsSize;
+}
+
+/**
+ * @brief Fill the image hole of the given image by the exact fill. A hole which is filled by
+ *        all the threads is filled as a convolution if the mode of the parameters allows it,
+ *        see convolutionFillImageHole. The automatic strategy fills a hole of the default
+ *        weighted function whose cost is too high for the direct fill by the approximate fill.
+ *        Any other hole is filled directly, by the given fill kernel if there is one, and by
+ *        the given weighted function otherwise.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param kernel The fill kernel of the weighted function, nullptr for no kernel.
+ * @param config The parameters of the fill.
+ * @param boundary The boundary arrays to set.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ * @return The number of bytes of the transforms, 0 if the hole wasn't a convolution.
+ */
+template <typename T, typename WeightFunction>
+static size_t exactFillImageHole(BasicImage<T> &image, const Hole &hole,
+                                 const WeightFunction &weightedFunction, const FillKernel *kernel,
+                                 const FillConfig &config, BoundaryArrays &boundary,
+                                 ThreadPool *threadPool)
+{
+    if (threadPool != nullptr)
+    {
+        const size_t transformsSize = convolutionFillImageHole(image, hole, weightedFunction,
+                                                               config.convolution, *threadPool);
+        if (transformsSize != 0)
+        {
+            return transformsSize;
+        }
+    }
+    if (config.strategy == AUTO_FILL && config.weight == INVERSE_POWER_WEIGHT &&
+        HoleSchedule::getCost(hole) >= AUTO_APPROXIMATE_PAIRS)
+    {
+        approximateFillImageHole(image, hole, config, boundary, threadPool);
+    }
+    else if (kernel != nullptr)
+    {
+        kernelFillImageHole(image, hole, *kernel, boundary, threadPool);
+    }
+    else
+    {
+        fillImageHole(image, hole, weightedFunction, threadPool);
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the minimal cost of a hole of the exact fill which is split across the
+ *        threads. Every hole is split if every hole is a convolution, which uses the threads.
+ * @param config The parameters of the fill.
+ * @return The minimal cost of a split hole, see HoleSchedule.
+ */
+static double getSplitCost(const FillConfig &config)
+{
+    return (config.convolution == ALWAYS_CONVOLUTION) ? 0 : SCHEDULE_SPLIT_PAIRS;
+}
+
+/**
+ * @brief Fill all the holes of the given image with the given weighted function by the exact
+ *        fill. The weight of every offset within the largest hole is tabulated once, so the
+ *        inner loop is a table lookup instead of the weighted function, see WeightTable.
+ *        The table is kept in the scratch, and it is reused by the next fills with the same
+ *        weighted function. If the table is too large, the weighted function is computed for
+ *        every pair. The holes are scheduled by their costs, see scheduledFillImageHoles, and
+ *        large holes are filled as a convolution, see exactFillImageHole.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the largest transforms.
+ */
+template <typename T, typename WeightFunction>
+static size_t exactFillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                                  const WeightFunction &weightedFunction, const FillConfig &config,
+                                  FillScratch &scratch, ThreadPool &threadPool)
+{
+    int rows = 0;
+    int cols = 0;
+    getHolesExtent(holes, rows, cols);
+    if (!WeightTable::fits(rows, cols))
+    {
+        return scheduledFillImageHoles(holes, std::vector<const Hole*>(), getSplitCost(config),
+                                       scratch, threadPool, [&](const Hole &hole,
+                                                                BoundaryArrays &boundary,
+                                                                ThreadPool *holeThreadPool)
+        {
+            return exactFillImageHole(image, hole, weightedFunction, nullptr, config, boundary,
+                                      holeThreadPool);
+        });
+    }
+    const WeightTable &weightTable = getWeightTable(scratch, weightedFunction, config, rows,
+                                                    cols);
+    const size_t transformsSize = scheduledFillImageHoles(
+            holes, std::vector<const Hole*>(), getSplitCost(config), scratch, threadPool,
+            [&](const Hole &hole, BoundaryArrays &boundary, ThreadPool *holeThreadPool)
+    {
+        return exactFillImageHole(image, hole, weightTable, nullptr, config, boundary,
+                                  holeThreadPool);
+    });
+    return weightTable.getMemorySize() + transformsSize;
+}
+
+/**
+ * @brief Submits the holes of the given image which are filled on the GPU by the given
+ *        parameters to the device, where they are filled asynchronously, see GpuFill.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param deviceHoles Set to the submitted holes, by their order in the holes.
+ */
+template <typename T>
+static void submitDeviceHoles(const BasicImage<T> &image, const std::vector<Hole> &holes,
+                              const FillKernel &kernel, const FillConfig &config,
+                              FillScratch &scratch, std::vector<const Hole*> &deviceHoles)
+{
+    deviceHoles.clear();
+    if (config.device == CPU_DEVICE || config.convolution == ALWAYS_CONVOLUTION ||
+        !GpuFill::isAvailable())
+    {
+        return;
+    }
+    scratch.gpuFill.reset();
+    for (const Hole &hole : holes)
+    {
+        const double pairCount = (double) hole.getHoleSize() * hole.getHoleBoundary().size();
+        if (config.device == AUTO_DEVICE && pairCount < GPU_MIN_PAIRS)
+        {
+            continue;
+        }
+        scratch.boundary.assign(image, hole.getHoleBoundary());
+        if (scratch.gpuFill.submit(kernel, scratch.boundary, hole))
+        {
+            deviceHoles.push_back(&hole);
+        }
+    }
+}
+
+/**
+ * @brief Waits for the holes which were submitted to the device and writes their values into
+ *        the image. A hole which the device failed to fill is filled on the CPU.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param deviceHoles The submitted holes.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ */
+template <typename T>
+static void collectDeviceHoles(BasicImage<T> &image, const std::vector<const Hole*> &deviceHoles,
+                               const FillKernel &kernel, FillScratch &scratch,
+                               ThreadPool &threadPool)
+{
+    for (size_t i = 0; i < deviceHoles.size(); ++i)
+    {
+        const Hole &hole = *deviceHoles[i];
+        const float *values = scratch.gpuFill.getValues(i);
+        if (values == nullptr)
+        {
+            kernelFillImageHole(image, hole, kernel, scratch.boundary, &threadPool);
+            continue;
+        }
+        INSTRUMENT_COUNT("weight evaluations", hole.getHoleSize() * hole.getHoleBoundary().size());
+        hole.forEachHolePixel([&](const size_t j, const Pixel &x)
+        {
+            image.at(x) = toPixelValue<T>(values[j]);
+        });
+    }
+}
+
+/**
+ * @brief Fill all the holes of the given image with the default weighted function by the exact
+ *        fill. A z value with a specialised form is computed by the vectorized fill kernel,
+ *        which is faster than a table lookup, and any other z value uses the weight table.
+ *        Large holes are filled on the GPU with a z value with a specialised form, if there
+ *        is a device (see GpuFill), and the other holes are scheduled by their costs on the
+ *        CPU, see scheduledFillImageHoles and exactFillImageHole.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam PowerWeight The type of the default weighted function, InversePowerWeight or
+ *         IntegerInversePowerWeight.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the largest transforms.
+ */
+template <typename T, typename PowerWeight>
+static size_t powerFillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                                  const PowerWeight &weightedFunction, const FillConfig &config,
+                                  FillScratch &scratch, ThreadPool &threadPool)
+{
+    const FillKernel kernel(weightedFunction.getEpsilon(), weightedFunction.getZ());
+    if (!kernel.isSpecialised())
+    {
+        return exactFillImageHoles<T, PowerWeight>(image, holes, weightedFunction, config,
+                                                   scratch, threadPool);
+    }
+    // The holes of the device are submitted first, so the CPU fills the other holes while the
+    // device fills them.
+    std::vector<const Hole*> deviceHoles;
+    submitDeviceHoles(image, holes, kernel, config, scratch, deviceHoles);
+    const size_t transformsSize = scheduledFillImageHoles(
+            holes, deviceHoles, getSplitCost(config), scratch, threadPool,
+            [&](const Hole &hole, BoundaryArrays &boundary, ThreadPool *holeThreadPool)
+    {
+        return exactFillImageHole(image, hole, weightedFunction, &kernel, config, boundary,
+                                  holeThreadPool);
+    });
+    collectDeviceHoles(image, deviceHoles, kernel, scratch, threadPool);
+    return transformsSize;
+}
+
+/**
+ * @brief Fill all the holes of the given image with the default weighted function by the exact
+ *        fill, see powerFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the largest transforms.
+ */
+template <typename T>
+static size_t exactFillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                                  const InversePowerWeight &weightedFunction,
+                                  const FillConfig &config, FillScratch &scratch,
+                                  ThreadPool &threadPool)
+{
+    return powerFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+}
+
+/**
+ * @brief Fill all the holes of the given image with the default weighted function of an
+ *        integer z by the exact fill, see powerFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam Z The z value of the weighted function.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the largest transforms.
+ */
+template <typename T, int Z>
+static size_t exactFillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                                  const IntegerInversePowerWeight<Z> &weightedFunction,
+                                  const FillConfig &config, FillScratch &scratch,
+                                  ThreadPool &threadPool)
+{
+    return powerFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+}
+
+/**
+ * @brief Fill the image hole of the given image using only the neighbours of every pixel,
+ *        peeling the hole layer by layer (an onion-peel wavefront). The BFS distance layers
+ *        of the hole from its boundary are computed once, where the first layer is the hole
+ *        pixels which neighbour a known pixel. Every pixel in a layer is computed only from
+ *        its known neighbours and its neighbours in the previous layers, so the pixels of a
+ *        layer are independent: they are filled in parallel into a values plane over the box
+ *        of the hole, which is written into the image once all the layers are done. The filled
+ *        neighbours are read from the plane, so they keep their full precision in an image of
+ *        bytes. The result does not depend on the order of the hole pixels. The planes and the
+ *        layers are kept in the scratch, and they are reused by the next holes.
+ * @tparam Connectivity The pixel connectivity value.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ */
+template <int Connectivity, typename T, typename WeightFunction>
+static void neighboursFillImageHole(BasicImage<T> &image, const Hole &hole,
+                                    const WeightFunction &weightedFunction,
+                                    FillScratch &scratch, ThreadPool &threadPool)
+{
+    if (hole.getHoleSize() == 0)
+    {
+        return;
+    }
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+
+    // Set a layers plane over the bounding box of the hole.
+    const HoleBox box = hole.getHoleBox();
+    const int minX = box.firstRow;
+    const int maxX = box.lastRow;
+    const int minY = box.firstCol;
+    const int maxY = box.lastCol;
+    const int boxCols = maxY - minY + 1;
+    std::vector<int> &layers = scratch.layers;
+    std::vector<float> &values = scratch.values;
+    layers.assign((size_t) (maxX - minX + 1) * boxCols, KNOWN_LAYER);
+    values.resize(layers.size());
+    auto layerOf = [&](const int x, const int y) -> int&
+    {
+        return layers[(size_t) (x - minX) * boxCols + (y - minY)];
+    };
+    auto valueOf = [&](const int x, const int y) -> float&
+    {
+        return values[(size_t) (x - minX) * boxCols + (y - minY)];
+    };
+    auto isHolePixel = [&](const int x, const int y)
+    {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY && layerOf(x, y) != KNOWN_LAYER;
+    };
+    hole.forEachHoleRun([&](const int x, const int colStart, const int colEnd)
+    {
+        std::fill(&layerOf(x, colStart), &layerOf(x, colStart) + (colEnd - colStart),
+                  UNASSIGNED_LAYER);
+    });
+
+    // The first layer is the hole pixels which neighbour a known pixel.
+    std::vector<Pixel> &layerPixels = scratch.layerPixels;
+    layerPixels.clear();
+    layerPixels.reserve(hole.getHoleSize());
+    hole.forEachHolePixel([&](const size_t, const Pixel &x)
+    {
+        bool hasKnownNeighbour = false;
+        forEachNeighbour<Connectivity>(x, rows, cols, [&](const int neighbourX,
+                                                          const int neighbourY)
+        {
+            hasKnownNeighbour = hasKnownNeighbour || !isHolePixel(neighbourX, neighbourY);
+        });
+        if (hasKnownNeighbour)
+        {
+            layerOf(x.getX(), x.getY()) = 0;
+            layerPixels.push_back(x);
+        }
+    });
+
+    // Compute the next layers using BFS, layer k is [layerStarts[k], layerStarts[k+1]).
+    std::vector<size_t> layerStarts(1, 0);
+    while (layerStarts.back() < layerPixels.size())
+    {
+        const int nextLayer = (int) layerStarts.size();
+        const size_t layerEnd = layerPixels.size();
+        for (size_t i = layerStarts.back(); i < layerEnd; ++i)
+        {
+            forEachNeighbour<Connectivity>(layerPixels[i], rows, cols, [&](const int neighbourX,
+                                                                           const int neighbourY)
+            {
+                if (isHolePixel(neighbourX, neighbourY) &&
+                    layerOf(neighbourX, neighbourY) == UNASSIGNED_LAYER)
+                {
+                    layerOf(neighbourX, neighbourY) = nextLayer;
+                    layerPixels.emplace_back(neighbourX, neighbourY);
+                }
+            });
+        }
+        layerStarts.push_back(layerEnd);
+    }
+
+    // Fill the layers one after the other, the pixels of every layer in parallel.
+    for (size_t layer = 0; layer + 1 < layerStarts.size(); ++layer)
+    {
+        const size_t layerBegin = layerStarts[layer];
+        const size_t layerSize = layerStarts[layer + 1] - layerBegin;
+        threadPool.parallelFor(layerSize, NEIGHBOURS_CHUNK_SIZE, [&](const size_t begin,
+                                                                     const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Pixel &x = layerPixels[layerBegin + i];
+                float numerator = 0;
+                float denominator = 0;
+                forEachNeighbour<Connectivity>(x, rows, cols, [&](const int neighbourX,
+                                                                  const int neighbourY)
+                {
+                    const bool isFilled = isHolePixel(neighbourX, neighbourY);
+                    if (isFilled && layerOf(neighbourX, neighbourY) >= (int) layer)
+                    {
+                        // This neighbour isn't filled yet.
+                        return;
+                    }
+                    float yValue = isFilled ? valueOf(neighbourX, neighbourY) :
+                                              (float) image.at(neighbourX, neighbourY);
+                    float weightedValue = weightedFunction(x, Pixel(neighbourX, neighbourY));
+                    numerator += weightedValue * yValue;
+                    denominator += weightedValue;
+                });
+                assert(denominator != 0);
+                valueOf(x.getX(), x.getY()) = numerator / denominator;
+            }
+        });
+    }
+    for (const Pixel &x : layerPixels)
+    {
+        image.at(x) = toPixelValue<T>(valueOf(x.getX(), x.getY()));
+    }
+}
+
+/**
+ * @brief Fill the image hole of the given image using only the neighbours of every pixel.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param connectivity The pixel connectivity value.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ */
+template <typename T, typename WeightFunction>
+static void neighboursFillImageHole(BasicImage<T> &image, const Hole &hole, const int connectivity,
+                                    const WeightFunction &weightedFunction,
+                                    FillScratch &scratch, ThreadPool &threadPool)
+{
+    if (connectivity == 8)
+    {
+        neighboursFillImageHole<8, T, WeightFunction>(image, hole, weightedFunction, scratch,
+                                                      threadPool);
+    }
+    else
+    {
+        neighboursFillImageHole<4, T, WeightFunction>(image, hole, weightedFunction, scratch,
+                                                      threadPool);
+    }
+}
+
+/**
+ * @brief Downsample the given image by 2 in every axis. Every coarse pixel is the mean of
+ *        the known pixels among its 4 fine pixels, and it is missing iff all of them are.
+ * @param image The image to downsample.
+ * @param missingCount Set to the number of missing pixels in the downsampled image.
+ * @return The downsampled image.
+ */
+static Image downsampleImage(const Image &image, size_t &missingCount)
+{
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    Image coarseImage((rows + 1) / 2, (cols + 1) / 2);
+    missingCount = 0;
+    for (int x = INITIAL_ROW; x < coarseImage.getRows(); ++x)
+    {
+        float *coarseRow = coarseImage.getRow(x);
+        for (int y = INITIAL_COLUMN; y < coarseImage.getCols(); ++y)
+        {
+            float sum = 0;
+            int knownCount = 0;
+            for (int fineX = 2 * x; fineX < std::min(2 * x + 2, rows); ++fineX)
+            {
+                const float *fineRow = image.getRow(fineX);
+                for (int fineY = 2 * y; fineY < std::min(2 * y + 2, cols); ++fineY)
+                {
+                    if (fineRow[fineY] != MISSING_VALUE)
+                    {
+                        sum += fineRow[fineY];
+                        ++knownCount;
+                    }
+                }
+            }
+            if (knownCount == 0)
+            {
+                coarseRow[y] = MISSING_VALUE;
+                ++missingCount;
+            }
+            else
+            {
+                coarseRow[y] = sum / knownCount;
+            }
+        }
+    }
+    return coarseImage;
+}
+
+/**
+ * @brief Refine the holes of a pyramid level from the filled coarser level, in one streaming
+ *        pass over the hole pixels. Every missing pixel is the weighted mean of its local
+ *        window, where a known or already refined pixel contributes its value, a missing
+ *        pixel contributes the filled value of its coarse pixel, and the pixel itself
+ *        contributes its coarse value as if it was at distance 1.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The pyramid level to fix.
+ * @param holes The holes of the pyramid level.
+ * @param coarseImage The filled coarser level.
+ * @param weightedFunction The weighted function used in the fill process.
+ */
+template <typename WeightFunction>
+static void refinePyramidLevel(Image &image, const std::vector<Hole> &holes,
+                               const Image &coarseImage, const WeightFunction &weightedFunction)
+{
+    const int windowSize = 2 * PYRAMID_WINDOW_RADIUS + 1;
+    float windowWeights[windowSize][windowSize];
+    for (int dx = -PYRAMID_WINDOW_RADIUS; dx <= PYRAMID_WINDOW_RADIUS; ++dx)
+    {
+        for (int dy = -PYRAMID_WINDOW_RADIUS; dy <= PYRAMID_WINDOW_RADIUS; ++dy)
+        {
+            // The pixel itself is weighted as a pixel at distance 1.
+            const Pixel offset = (dx == 0 && dy == 0) ? Pixel(1, 0) : Pixel(dx, dy);
+            windowWeights[dx + PYRAMID_WINDOW_RADIUS][dy + PYRAMID_WINDOW_RADIUS] =
+                    weightedFunction(Pixel(), offset);
+        }
+    }
+
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    for (const Hole &hole : holes)
+    {
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
+        {
+            float numerator = 0;
+            float denominator = 0;
+            const int minX = std::max(x.getX() - PYRAMID_WINDOW_RADIUS, INITIAL_ROW);
+            const int maxX = std::min(x.getX() + PYRAMID_WINDOW_RADIUS, rows - 1);
+            const int minY = std::max(x.getY() - PYRAMID_WINDOW_RADIUS, INITIAL_COLUMN);
+            const int maxY = std::min(x.getY() + PYRAMID_WINDOW_RADIUS, cols - 1);
+            for (int windowX = minX; windowX <= maxX; ++windowX)
+            {
+                const float *row = image.getRow(windowX);
+                const float *coarseRow = coarseImage.getRow(windowX / 2);
+                const float *weights = windowWeights[windowX - x.getX() + PYRAMID_WINDOW_RADIUS];
+                for (int windowY = minY; windowY <= maxY; ++windowY)
+                {
+                    const float value = (row[windowY] != MISSING_VALUE) ? row[windowY] :
+                                                                         coarseRow[windowY / 2];
+                    const float weight = weights[windowY - x.getY() + PYRAMID_WINDOW_RADIUS];
+                    numerator += weight * value;
+                    denominator += weight;
+                }
+            }
+            image.at(x) = numerator / denominator;
+        });
+    }
+}
+
+/**
+ * @brief Fill all the holes of the given image with a coarse-to-fine pyramid. The image and
+ *        its holes are downsampled until the holes are small, the coarsest level is filled
+ *        by the exact fill, and then every finer level is refined from the coarser level
+ *        using only a local window, so the work per pixel is about constant. The levels tell
+ *        the missing pixels by MISSING_VALUE, so the hole pixels are marked first, since the
+ *        holes of a mask may have any values.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param config The parameters of the fill.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill of the coarsest level.
+ * @return The number of bytes of the weight table and of the transforms of the exact fill.
+ */
+template <typename WeightFunction>
+static size_t pyramidFillImageHoles(Image &image, const std::vector<Hole> &holes,
+                                    const FillConfig &config,
+                                    const WeightFunction &weightedFunction,
+                                    FillScratch &scratch, ThreadPool &threadPool)
+{
+    size_t missingCount = 0;
+    for (const Hole &hole : holes)
+    {
+        missingCount += hole.getHoleSize();
+        hole.forEachHoleRun([&](const int x, const int colStart, const int colEnd)
+        {
+            std::fill(image.getRow(x) + colStart, image.getRow(x) + colEnd, MISSING_VALUE);
+        });
+    }
+
+    // Build the levels of the pyramid, the first level is the image itself.
+    std::vector<Image> coarseLevels;
+    const Image *currentLevel = &image;
+    while (missingCount > PYRAMID_MAX_EXACT_PIXELS &&
+           (currentLevel->getRows() > 1 || currentLevel->getCols() > 1))
+    {
+        coarseLevels.push_back(downsampleImage(*currentLevel, missingCount));
+        currentLevel = &coarseLevels.back();
+        INSTRUMENT_COUNT("bytes allocated", (size_t) currentLevel->getRows() *
+                                            currentLevel->getCols() * sizeof(float));
+    }
+
+    if (coarseLevels.empty())
+    {
+        // The holes are small enough for the exact fill.
+        return exactFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+    }
+
+    // Fill the coarsest level exactly, and refine the levels from the coarsest to the image.
+    scratch.mask.assign(coarseLevels.back());
+    findHoles(scratch.mask, config.connectivity, scratch.labelling, &scratch.levelArena,
+              scratch.levelHoles, &threadPool);
+    const size_t scratchSize = exactFillImageHoles(coarseLevels.back(), scratch.levelHoles,
+                                                   weightedFunction, config, scratch, threadPool);
+    for (size_t level = coarseLevels.size() - 1; level > 0; --level)
+    {
+        scratch.mask.assign(coarseLevels[level - 1]);
+        findHoles(scratch.mask, config.connectivity, scratch.labelling, &scratch.levelArena,
+                  scratch.levelHoles, &threadPool);
+        refinePyramidLevel(coarseLevels[level - 1], scratch.levelHoles, coarseLevels[level],
+                           weightedFunction);
+    }
+    refinePyramidLevel(image, holes, coarseLevels.front(), weightedFunction);
+    return scratchSize;
+}
+
+/**
+ * @brief Fill all the holes of the given integer image with a coarse-to-fine pyramid. The
+ *        levels of the pyramid mark their missing pixels by MISSING_VALUE, which isn't an
+ *        integer pixel value, so the image is filled as a copy of floats, and the hole pixels
+ *        are copied back.
+ * @tparam T The type of the pixel values of the image, unsigned short or unsigned char.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param config The parameters of the fill.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill of the coarsest level.
+ * @return The number of bytes of the copy, the weight table and the transforms.
+ */
+template <typename T, typename WeightFunction>
+static size_t pyramidFillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                                    const FillConfig &config,
+                                    const WeightFunction &weightedFunction,
+                                    FillScratch &scratch, ThreadPool &threadPool)
+{
+    Image floatImage(image.getRows(), image.getCols());
+    INSTRUMENT_COUNT("bytes allocated", (size_t) image.getRows() * image.getCols() * sizeof(float));
+    for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+    {
+        std::copy(image.getRow(x), image.getRow(x) + image.getCols(), floatImage.getRow(x));
+    }
+    const size_t scratchSize = pyramidFillImageHoles(floatImage, holes, config, weightedFunction,
+                                                     scratch, threadPool);
+    for (const Hole &hole : holes)
+    {
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
+        {
+            image.at(x) = toPixelValue<T>(floatImage.at(x));
+        });
+    }
+    return scratchSize + (size_t) image.getRows() * image.getCols() * sizeof(float);
+}
+
+/**
+ * @brief Fill all the holes of the given image with the strategy of the given parameters and
+ *        the given weighted function.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param config The parameters of the fill.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the transforms used in the fill.
+ */
+template <typename T, typename WeightFunction>
+static size_t fillImageHoles(BasicImage<T> &image, const std::vector<Hole> &holes,
+                             const FillConfig &config, const WeightFunction &weightedFunction,
+                             FillScratch &scratch, ThreadPool &threadPool)
+{
+    if (config.strategy == EXACT_FILL || config.strategy == AUTO_FILL)
+    {
+        return exactFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+    }
+    if (config.strategy == PYRAMID_FILL)
+    {
+        // The pyramid fills all the holes of the image together.
+        return pyramidFillImageHoles(image, holes, config, weightedFunction, scratch, threadPool);
+    }
+    if (config.strategy == APPROXIMATE_FILL)
+    {
+        return scheduledFillImageHoles(holes, std::vector<const Hole*>(), SCHEDULE_SPLIT_PAIRS,
+                                       scratch, threadPool, [&](const Hole &hole,
+                                                                BoundaryArrays &boundary,
+                                                                ThreadPool *holeThreadPool)
+        {
+            approximateFillImageHole(image, hole, config, boundary, holeThreadPool);
+            return (size_t) 0;
+        });
+    }
+    for (const Hole &hole : holes)
+    {
+        neighboursFillImageHole(image, hole, config.connectivity, weightedFunction, scratch,
+                                threadPool);
+    }
+    return 0;
+}
+
+/**
+ * @brief Fill the image hole of the given multi-channel image with the given weighted function.
+ *        The weight of every pair of a hole pixel and a boundary pixel is computed once, and it
+ *        is accumulated into the sums of all the channels, see fillImageHole.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ */
+template <typename T, typename WeightFunction>
+static void colorFillImageHole(BasicColorImage<T> &image, const Hole &hole,
+                               const WeightFunction &weightedFunction, ThreadPool *threadPool)
+{
+    const holeSet &boundaryPixels = hole.getHoleBoundary();
+    const int channels = image.getChannels();
+    INSTRUMENT_COUNT("weight evaluations", hole.getHoleSize() * boundaryPixels.size());
+    // The channels of a boundary pixel are read together, so they are kept interleaved.
+    std::vector<float> boundaryValues;
+    boundaryValues.reserve(boundaryPixels.size() * channels);
+    for (const Pixel &y : boundaryPixels)
+    {
+        boundaryValues.insert(boundaryValues.end(), image.at(y), image.at(y) + channels);
+    }
+    forEachChunk(threadPool, hole.getHoleSize(), FILL_CHUNK_SIZE, [&](const size_t begin,
+                                                                      const size_t end)
+    {
+        hole.forEachHolePixel(begin, end, [&](const size_t, const Pixel &x)
+        {
+            float numerators[MAX_CHANNELS] = {};
+            float denominator = 0;
+            const float *values = boundaryValues.data();
+            for (size_t j = 0; j < boundaryPixels.size(); ++j, values += channels)
+            {
+                float weightedValue = weightedFunction(x, boundaryPixels[j]);
+                for (int c = 0; c < channels; ++c)
+                {
+                    numerators[c] += weightedValue * values[c];
+                }
+                denominator += weightedValue;
+            }
+            if (denominator < MIN_WEIGHT_SUM)
+            {
+                // All the weights underflowed, so the pixel takes the limit of the fill.
+                std::fill(numerators, numerators + channels, 0.0f);
+                denominator = 0;
+                forEachNearestPixel(x, boundaryPixels, [&](const size_t j)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        numerators[c] += boundaryValues[j * channels + c];
+                    }
+                    ++denominator;
+                });
+            }
+            T *pixelValues = image.at(x);
+            for (int c = 0; c < channels; ++c)
+            {
+                pixelValues[c] = toPixelValue<T>(numerators[c] / denominator);
+            }
+        });
+    });
+}
+
+/**
+ * @brief Fill the image hole of the given multi-channel image with the given fill kernel. The
+ *        channels of the boundary are packed as planes, and the kernel computes the weight of
+ *        every pair once and accumulates it into all the channels, see kernelFillImageHole.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param hole The hole in the image.
+ * @param kernel The fill kernel of the default weighted function.
+ * @param boundary The boundary arrays to set.
+ * @param threadPool The threads used in the fill, nullptr for the calling thread.
+ */
+template <typename T>
+static void kernelFillColorImageHole(BasicColorImage<T> &image, const Hole &hole,
+                                     const FillKernel &kernel, BoundaryArrays &boundary,
+                                     ThreadPool *threadPool)
+{
+    if (hole.getHoleBoundary().empty())
+    {
+        // A hole without a boundary stays missing.
+        return;
+    }
+    const int channels = image.getChannels();
+    boundary.assign(image, hole.getHoleBoundary());
+    INSTRUMENT_COUNT("weight evaluations", hole.getHoleSize() * hole.getHoleBoundary().size());
+    forEachChunk(threadPool, hole.getHoleSize(), FILL_CHUNK_SIZE, [&](const size_t begin,
+                                                                      const size_t end)
+    {
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += KERNEL_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min((size_t) KERNEL_BLOCK_SIZE, end - blockBegin);
+            Pixel block[KERNEL_BLOCK_SIZE];
+            hole.forEachHolePixel(blockBegin, blockBegin + blockSize, [&](const size_t i,
+                                                                          const Pixel &x)
+            {
+                block[i - blockBegin] = x;
+            });
+            float numerators[MAX_CHANNELS * KERNEL_BLOCK_SIZE] = {};
+            float denominators[KERNEL_BLOCK_SIZE] = {};
+            kernel.accumulate(boundary, block, blockSize, numerators, denominators);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                T *pixelValues = image.at(block[i]);
+                for (int c = 0; c < channels; ++c)
+                {
+                    pixelValues[c] = toPixelValue<T>(numerators[i * channels + c] /
+                                                     denominators[i]);
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Fill the given holes of the given multi-channel image channel by channel. Every
+ *        channel is copied into a plane, the plane is filled by the given fill, and the hole
+ *        pixels of the plane are copied back into the channel. The holes themselves are shared
+ *        by all the channels.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam PlaneFill The type of the fill of a plane, which is called with the plane and
+ *         returns the number of bytes of its scratch memory.
+ * @param image The image to fix.
+ * @param holes The holes which are filled in every plane.
+ * @param planeFill The fill of a plane.
+ * @return The number of bytes of the plane and of the largest scratch memory of a plane fill.
+ */
+template <typename T, typename PlaneFill>
+static size_t planarFillImageHoles(BasicColorImage<T> &image, const std::vector<const Hole*> &holes,
+                                   const PlaneFill &planeFill)
+{
+    const int channels = image.getChannels();
+    BasicImage<T> plane(image.getRows(), image.getCols());
+    const size_t planeSize = (size_t) image.getRows() * image.getCols() * sizeof(T);
+    INSTRUMENT_COUNT("bytes allocated", planeSize);
+    size_t scratchSize = 0;
+    for (int c = 0; c < channels; ++c)
+    {
+        for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+        {
+            const T *row = image.getRow(x);
+            T *planeRow = plane.getRow(x);
+            for (int y = INITIAL_COLUMN; y < image.getCols(); ++y)
+            {
+                planeRow[y] = row[y * channels + c];
+            }
+        }
+        scratchSize = std::max(scratchSize, planeFill(plane));
+        for (const Hole *hole : holes)
+        {
+            hole->forEachHolePixel([&](const size_t, const Pixel &x)
+            {
+                image.at(x)[c] = plane.at(x);
+            });
+        }
+    }
+    return scratchSize + planeSize;
+}
+
+/**
+ * @brief Returns whether the given hole of a multi-channel image is filled by the direct exact
+ *        fill of all the channels in one pass. A hole which the exact fill of a single channel
+ *        fills as a convolution or by the approximate fill is filled channel by channel, see
+ *        exactFillImageHole.
+ * @param hole The hole in the image.
+ * @param config The parameters of the fill.
+ * @return true if the hole is filled directly, false otherwise.
+ */
+static bool isDirectColorHole(const Hole &hole, const FillConfig &config)
+{
+    const double cost = HoleSchedule::getCost(hole);
+    if (config.strategy == AUTO_FILL && config.weight == INVERSE_POWER_WEIGHT &&
+        cost >= AUTO_APPROXIMATE_PAIRS)
+    {
+        return false;
+    }
+    if (config.convolution == ALWAYS_CONVOLUTION)
+    {
+        return false;
+    }
+    if (config.convolution == NEVER_CONVOLUTION || cost < SCHEDULE_SPLIT_PAIRS)
+    {
+        return true;
+    }
+    return cost < CONVOLUTION_CROSSOVER * ConvolutionFill(hole).getCost();
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the given weighted function
+ *        by the exact fill. The holes which are filled directly are scheduled by their costs
+ *        (see scheduledFillImageHoles), and every one of them is filled in one pass over its
+ *        pairs for all the channels: by the given fill kernel if there is one, and otherwise by
+ *        the weight table or by the weighted function, as in exactFillImageHoles. The other
+ *        holes are filled channel by channel, see isDirectColorHole. The holes are on the CPU.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param kernel The fill kernel of the weighted function, nullptr for no kernel.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table, the plane and the largest transforms.
+ */
+template <typename T, typename WeightFunction>
+static size_t colorExactFillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                                       const WeightFunction &weightedFunction,
+                                       const FillKernel *kernel, const FillConfig &config,
+                                       FillScratch &scratch, ThreadPool &threadPool)
+{
+    std::vector<const Hole*> planarHoles;
+    for (const Hole &hole : holes)
+    {
+        if (!isDirectColorHole(hole, config))
+        {
+            planarHoles.push_back(&hole);
+        }
+    }
+
+    size_t scratchSize = 0;
+    int rows = 0;
+    int cols = 0;
+    getHolesExtent(holes, rows, cols);
+    if (kernel != nullptr)
+    {
+        scheduledFillImageHoles(holes, planarHoles, SCHEDULE_SPLIT_PAIRS, scratch, threadPool,
+                                [&](const Hole &hole, BoundaryArrays &boundary,
+                                    ThreadPool *holeThreadPool)
+        {
+            kernelFillColorImageHole(image, hole, *kernel, boundary, holeThreadPool);
+            return (size_t) 0;
+        });
+    }
+    else if (!WeightTable::fits(rows, cols))
+    {
+        scheduledFillImageHoles(holes, planarHoles, SCHEDULE_SPLIT_PAIRS, scratch, threadPool,
+                                [&](const Hole &hole, BoundaryArrays &, ThreadPool *holeThreadPool)
+        {
+            colorFillImageHole(image, hole, weightedFunction, holeThreadPool);
+            return (size_t) 0;
+        });
+    }
+    else
+    {
+        const WeightTable &weightTable = getWeightTable(scratch, weightedFunction, config, rows,
+                                                        cols);
+        scheduledFillImageHoles(holes, planarHoles, SCHEDULE_SPLIT_PAIRS, scratch, threadPool,
+                                [&](const Hole &hole, BoundaryArrays &, ThreadPool *holeThreadPool)
+        {
+            colorFillImageHole(image, hole, weightTable, holeThreadPool);
+            return (size_t) 0;
+        });
+        scratchSize = weightTable.getMemorySize();
+    }
+
+    if (!planarHoles.empty())
+    {
+        scratchSize += planarFillImageHoles(image, planarHoles, [&](BasicImage<T> &plane)
+        {
+            size_t transformsSize = 0;
+            for (const Hole *hole : planarHoles)
+            {
+                transformsSize = std::max(transformsSize,
+                                          exactFillImageHole(plane, *hole, weightedFunction,
+                                                             kernel, config, scratch.boundary,
+                                                             &threadPool));
+            }
+            return transformsSize;
+        });
+    }
+    return scratchSize;
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the given weighted function
+ *        by the exact fill, see colorExactFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table, the plane and the largest transforms.
+ */
+template <typename T, typename WeightFunction>
+static size_t colorExactFillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                                       const WeightFunction &weightedFunction,
+                                       const FillConfig &config, FillScratch &scratch,
+                                       ThreadPool &threadPool)
+{
+    return colorExactFillImageHoles(image, holes, weightedFunction, nullptr, config, scratch,
+                                    threadPool);
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the default weighted
+ *        function by the exact fill. A z value with a specialised form is computed by the
+ *        vectorized fill kernel, and any other z value uses the weight table, see
+ *        colorExactFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam PowerWeight The type of the default weighted function, InversePowerWeight or
+ *         IntegerInversePowerWeight.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table, the plane and the largest transforms.
+ */
+template <typename T, typename PowerWeight>
+static size_t colorPowerFillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                                       const PowerWeight &weightedFunction,
+                                       const FillConfig &config, FillScratch &scratch,
+                                       ThreadPool &threadPool)
+{
+    const FillKernel kernel(weightedFunction.getEpsilon(), weightedFunction.getZ());
+    return colorExactFillImageHoles(image, holes, weightedFunction,
+                                    kernel.isSpecialised() ? &kernel : nullptr, config, scratch,
+                                    threadPool);
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the default weighted
+ *        function by the exact fill, see colorPowerFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table, the plane and the largest transforms.
+ */
+template <typename T>
+static size_t colorExactFillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                                       const InversePowerWeight &weightedFunction,
+                                       const FillConfig &config, FillScratch &scratch,
+                                       ThreadPool &threadPool)
+{
+    return colorPowerFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the default weighted
+ *        function of an integer z by the exact fill, see colorPowerFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam Z The z value of the weighted function.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param weightedFunction The default weighted function.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the plane and the largest transforms.
+ */
+template <typename T, int Z>
+static size_t colorExactFillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                                       const IntegerInversePowerWeight<Z> &weightedFunction,
+                                       const FillConfig &config, FillScratch &scratch,
+                                       ThreadPool &threadPool)
+{
+    return colorPowerFillImageHoles(image, holes, weightedFunction, config, scratch, threadPool);
+}
+
+/**
+ * @brief Fill all the holes of the given multi-channel image with the strategy of the given
+ *        parameters and the given weighted function. The exact fill fills all the channels
+ *        in one pass, see colorExactFillImageHoles, and the other strategies fill the image
+ *        channel by channel with the same holes, see planarFillImageHoles.
+ * @tparam T The type of the pixel values of the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param config The parameters of the fill.
+ * @param weightedFunction The weighted function used in the fill process.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the scratch memory used in the fill.
+ */
+template <typename T, typename WeightFunction>
+static size_t fillImageHoles(BasicColorImage<T> &image, const std::vector<Hole> &holes,
+                             const FillConfig &config, const WeightFunction &weightedFunction,
+                             FillScratch &scratch, ThreadPool &threadPool)
+{
+    if (config.strategy == EXACT_FILL || config.strategy == AUTO_FILL)
+    {
+        return colorExactFillImageHoles(image, holes, weightedFunction, config, scratch,
+                                        threadPool);
+    }
+    std::vector<const Hole*> planarHoles;
+    for (const Hole &hole : holes)
+    {
+        planarHoles.push_back(&hole);
+    }
+    return planarFillImageHoles(image, planarHoles, [&](BasicImage<T> &plane)
+    {
+        return fillImageHoles(plane, holes, config, weightedFunction, scratch, threadPool);
+    });
+}
+
+/**
+ * @brief Returns whether the given hole has a boundary to fill it from.
+ * @param hole The hole.
+ * @return true if the hole has a boundary, false otherwise.
+ */
+static bool hasBoundary(const Hole &hole)
+{
+    return !hole.getHoleBoundary().empty();
+}
+
+/**
+ * @brief Fill all the holes of the given image with the given parameters. A hole without a
+ *        boundary, e.g. of an image whose pixels are all missing, has no values to fill it
+ *        from, so it is skipped and its pixels stay missing, by every strategy. The weighted
+ *        function of the parameters is resolved once here, and the default weighted function
+ *        with a small integer z is resolved to its compile time form.
+ * @tparam ImageType The type of the image, BasicImage or BasicColorImage.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the transforms used in the fill.
+ */
+template <typename ImageType>
+static size_t fillImageHoles(ImageType &image, const std::vector<Hole> &holes,
+                             const FillConfig &config, FillScratch &scratch,
+                             ThreadPool &threadPool)
+{
+    if (!std::all_of(holes.begin(), holes.end(), hasBoundary))
+    {
+        std::vector<Hole> boundedHoles;
+        std::copy_if(holes.begin(), holes.end(), std::back_inserter(boundedHoles), hasBoundary);
+        return fillImageHoles(image, boundedHoles, config, scratch, threadPool);
+    }
+    if (config.weight == GAUSSIAN_WEIGHT)
+    {
+        return fillImageHoles(image, holes, config,
+                              GaussianWeight(std::max(config.sigma, MIN_SIGMA)), scratch,
+                              threadPool);
+    }
+    const int integerZ = (int) config.z;
+    if (integerZ != config.z || integerZ < 1 || integerZ > MAX_INTEGER_Z)
+    {
+        return fillImageHoles(image, holes, config, InversePowerWeight(config.epsilon, config.z),
+                              scratch, threadPool);
+    }
+    switch (integerZ)
+    {
+        case 1:
+            return fillImageHoles(image, holes, config,
+                                  IntegerInversePowerWeight<1>(config.epsilon), scratch,
+                                  threadPool);
+        case 2:
+            return fillImageHoles(image, holes, config,
+                                  IntegerInversePowerWeight<2>(config.epsilon), scratch,
+                                  threadPool);
+        case 3:
+            return fillImageHoles(image, holes, config,
+                                  IntegerInversePowerWeight<3>(config.epsilon), scratch,
+                                  threadPool);
+        default:
+            return fillImageHoles(image, holes, config,
+                                  IntegerInversePowerWeight<4>(config.epsilon), scratch,
+                                  threadPool);
+    }
+}
+
+
+/*-----=  Tiled Fill Functions  =-----*/
+
+
+/**
+ * @brief Returns whether the given hole of a window is complete, i.e. none of its pixels is on
+ *        an edge of the window which isn't an edge of the image, so the entire hole and its
+ *        boundary are inside the window.
+ * @param hole The hole, in the coordinates of the window.
+ * @param windowX The first row of the window in the image.
+ * @param windowY The first column of the window in the image.
+ * @param window The window.
+ * @param image The mapped image.
+ * @return true if the hole is complete, false otherwise.
+ */
+static bool isCompleteHole(const Hole &hole, const int windowX, const int windowY,
+                           const Image &window, const MappedImage &image)
+{
+    const bool openTop = windowX > INITIAL_ROW;
+    const bool openBottom = windowX + window.getRows() < image.getRows();
+    const bool openLeft = windowY > INITIAL_COLUMN;
+    const bool openRight = windowY + window.getCols() < image.getCols();
+    const HoleBox box = hole.getHoleBox();
+    return !((openTop && box.firstRow == INITIAL_ROW) ||
+             (openBottom && box.lastRow == window.getRows() - 1) ||
+             (openLeft && box.firstCol == INITIAL_COLUMN) ||
+             (openRight && box.lastCol == window.getCols() - 1));
+}
+
+/**
+ * @brief Fill the holes of a single tile of the mapped image. The holes are found in a window
+ *        of the tile with a halo around it, and every complete hole of the window is filled.
+ *        If a hole which reaches into the tile isn't complete, the halo is doubled until it is.
+ * @param image The mapped image to fix.
+ * @param tileX The first row of the tile.
+ * @param tileY The first column of the tile.
+ * @param tileSize The number of rows and columns in a tile.
+ * @param halo The initial number of rows and columns around the tile in the window.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The number of bytes of the weight table and of the transforms used in the fill.
+ */
+static size_t tiledFillTile(MappedImage &image, const int tileX, const int tileY,
+                            const int tileSize, const int halo, const FillConfig &config,
+                            FillScratch &scratch, ThreadPool &threadPool)
+{
+    INSTRUMENT_SCOPE("fillTile");
+    const int tileEndX = std::min(tileX + tileSize, image.getRows());
+    const int tileEndY = std::min(tileY + tileSize, image.getCols());
+    size_t scratchSize = 0;
+    for (long margin = halo; ; margin = std::max(2 * margin, 1L))
+    {
+        const int windowX = (int) std::max((long) INITIAL_ROW, tileX - margin);
+        const int windowY = (int) std::max((long) INITIAL_COLUMN, tileY - margin);
+        const int windowEndX = (int) std::min((long) image.getRows(), tileEndX + margin);
+        const int windowEndY = (int) std::min((long) image.getCols(), tileEndY + margin);
+        Image window = image.getWindow(windowX, windowY, windowEndX - windowX,
+                                       windowEndY - windowY);
+
+        std::vector<Hole> &completeHoles = scratch.completeHoles;
+        completeHoles.clear();
+        bool hasIncompleteHole = false;
+        scratch.mask.assign(window);
+        findHoles(scratch.mask, config.connectivity, scratch.labelling, &scratch.windowArena,
+                  scratch.windowHoles, &threadPool);
+        for (Hole &hole : scratch.windowHoles)
+        {
+            if (isCompleteHole(hole, windowX, windowY, window, image))
+            {
+                completeHoles.push_back(std::move(hole));
+                continue;
+            }
+            hole.forEachHoleRun([&](const int x, const int colStart, const int colEnd)
+            {
+                const int imageX = windowX + x;
+                if (imageX >= tileX && imageX < tileEndX && windowY + colStart < tileEndY &&
+                    windowY + colEnd > tileY)
+                {
+                    hasIncompleteHole = true;
+                }
+            });
+        }
+        scratchSize = std::max(scratchSize, fillImageHoles(window, completeHoles, config, scratch,
+                                                           threadPool));
+        if (!hasIncompleteHole)
+        {
+            return scratchSize;
+        }
+    }
+}
+
+/**
+ * @brief Fill all the holes of the mapped image tile by tile, in a row-major order of the
+ *        tiles. A hole is filled by the first tile whose window contains it completely, and
+ *        the holes are independent, so the result doesn't depend on the tiles. Once a row of
+ *        tiles is done its rows are written back to the file and dropped from memory, so the
+ *        memory is set by the tile size (and by the largest hole) and not by the image size.
+ * @param image The mapped image to fix.
+ * @param tileSize The number of rows and columns in a tile.
+ * @param halo The initial number of rows and columns around a tile in its window.
+ * @param config The parameters of the fill.
+ * @param scratch The buffers of the fill.
+ * @param threadPool The threads used in the fill.
+ * @return The largest number of bytes of the weight table and of the transforms of a tile.
+ */
+static size_t tiledFillImage(MappedImage &image, const int tileSize, const int halo,
+                             const FillConfig &config, FillScratch &scratch,
+                             ThreadPool &threadPool)
+{
+    size_t scratchSize = 0;
+    for (int tileX = INITIAL_ROW; tileX < image.getRows(); tileX += tileSize)
+    {
+        for (int tileY = INITIAL_COLUMN; tileY < image.getCols(); tileY += tileSize)
+        {
+            scratchSize = std::max(scratchSize, tiledFillTile(image, tileX, tileY, tileSize, halo,
+                                                              config, scratch, threadPool));
+        }
+        // The rows above the halo of the next row of tiles are done. The released rows may be
+        // read back (by a window grown for a large hole, or by the kernel mapping the pages
+        // around a page fault), so they are all released again.
+        const int doneRows = std::max(tileX + tileSize - halo, INITIAL_ROW);
+        image.releaseRows(INITIAL_ROW, std::min(doneRows, image.getRows()));
+    }
+    return scratchSize;
+}
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the HoleFiller.
+ * @param config The parameters of the fills.
+ * @param threadCount The number of threads used in the fills, 0 for all the hardware
+ *        threads.
+ */
+HoleFiller::HoleFiller(const FillConfig &config, const unsigned int threadCount) :
+        _config(config), _threadPool(threadCount), _scratchSize(0)
+{
+
+}
+
+/**
+ * @brief Finds all the holes of the given image, i.e. its MISSING_VALUE pixels, and their
+ *        boundaries by the connectivity of the parameters.
+ * @param image The image with the missing pixels in it.
+ * @return A vector of all the holes in the image.
+ */
+std::vector<Hole> HoleFiller::findHoles(const Image &image)
+{
+    _scratch.mask.assign(image);
+    return findHoles(_scratch.mask);
+}
+
+/**
+ * @brief Finds all the holes of the given mask and their boundaries by the connectivity of
+ *        the parameters.
+ * @param mask The mask of the missing pixels.
+ * @return A vector of all the holes in the mask.
+ */
+std::vector<Hole> HoleFiller::findHoles(const HoleMask &mask)
+{
+    // The holes are the caller's, so they are on the heap.
+    std::vector<Hole> holes;
+    ::findHoles(mask, _config.connectivity, _scratch.labelling, nullptr, holes, &_threadPool);
+    return holes;
+}
+
+/**
+ * @brief Finds the holes of the given image, i.e. its MISSING_VALUE pixels, and fills them.
+ * @param image The image to fix.
+ */
+void HoleFiller::fill(Image &image)
+{
+    _scratch.mask.assign(image);
+    fillHoles(image, detectHoles(_scratch.mask));
+}
+
+/**
+ * @brief Finds the holes of the given mask and fills them in the given image.
+ * @param image The image to fix.
+ * @param mask The mask of the missing pixels of the image, of the same size.
+ */
+void HoleFiller::fill(Image &image, const HoleMask &mask)
+{
+    assert(image.getRows() == mask.getRows() && image.getCols() == mask.getCols());
+    fillHoles(image, detectHoles(mask));
+}
+
+/**
+ * @brief Finds the holes of the given mask and fills them in the given image.
+ * @param image The image to fix.
+ * @param mask The mask of the missing pixels of the image, of the same size.
+ */
+void HoleFiller::fill(ShortImage &image, const HoleMask &mask)
+{
+    assert(image.getRows() == mask.getRows() && image.getCols() == mask.getCols());
+    fillHoles(image, detectHoles(mask));
+}
+
+/**
+ * @brief Finds the holes of the given mask and fills them in the given image.
+ * @param image The image to fix.
+ * @param mask The mask of the missing pixels of the image, of the same size.
+ */
+void HoleFiller::fill(ByteImage &image, const HoleMask &mask)
+{
+    assert(image.getRows() == mask.getRows() && image.getCols() == mask.getCols());
+    fillHoles(image, detectHoles(mask));
+}
+
+/**
+ * @brief Finds the holes of the given mask once and fills them in all the channels of the
+ *        given multi-channel image.
+ * @param image The image to fix.
+ * @param mask The mask of the missing pixels of the image, of the same size.
+ */
+void HoleFiller::fill(ColorImage &image, const HoleMask &mask)
+{
+    assert(image.getRows() == mask.getRows() && image.getCols() == mask.getCols());
+    fillHoles(image, detectHoles(mask));
+}
+
+/**
+ * @brief Finds the holes of the given mask once and fills them in all the channels of the
+ *        given multi-channel image.
+ * @param image The image to fix.
+ * @param mask The mask of the missing pixels of the image, of the same size.
+ */
+void HoleFiller::fill(ByteColorImage &image, const HoleMask &mask)
+{
+    assert(image.getRows() == mask.getRows() && image.getCols() == mask.getCols());
+    fillHoles(image, detectHoles(mask));
+}
+
+/**
+ * @brief Fills the given holes of the given image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ */
+void HoleFiller::fillHoles(Image &image, const std::vector<Hole> &holes)
+{
+    INSTRUMENT_SCOPE("fillHoles");
+    _scratchSize = fillImageHoles(image, holes, _config, _scratch, _threadPool);
+}
+
+/**
+ * @brief Fills the given holes of the given image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ */
+void HoleFiller::fillHoles(ShortImage &image, const std::vector<Hole> &holes)
+{
+    INSTRUMENT_SCOPE("fillHoles");
+    _scratchSize = fillImageHoles(image, holes, _config, _scratch, _threadPool);
+}
+
+/**
+ * @brief Fills the given holes of the given image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ */
+void HoleFiller::fillHoles(ByteImage &image, const std::vector<Hole> &holes)
+{
+    INSTRUMENT_SCOPE("fillHoles");
+    _scratchSize = fillImageHoles(image, holes, _config, _scratch, _threadPool);
+}
+
+/**
+ * @brief Fills the given holes in all the channels of the given multi-channel image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ */
+void HoleFiller::fillHoles(ColorImage &image, const std::vector<Hole> &holes)
+{
+    INSTRUMENT_SCOPE("fillHoles");
+    _scratchSize = fillImageHoles(image, holes, _config, _scratch, _threadPool);
+}
+
+/**
+ * @brief Fills the given holes in all the channels of the given multi-channel image.
+ * @param image The image to fix.
+ * @param holes The holes in the image.
+ */
+void HoleFiller::fillHoles(ByteColorImage &image, const std::vector<Hole> &holes)
+{
+    INSTRUMENT_SCOPE("fillHoles");
+    _scratchSize = fillImageHoles(image, holes, _config, _scratch, _threadPool);
+}
+
+/**
+ * @brief Fills all the holes of the mapped image tile by tile, so the memory is set by the
+ *        tile size (and by the largest hole) and not by the image size.
+ * @param image The mapped image to fix.
+ * @param tileSize The number of rows and columns in a tile.
+ * @param halo The initial number of rows and columns around a tile in its window.
+ */
+void HoleFiller::fillTiled(MappedImage &image, const int tileSize, const int halo)
+{
+    INSTRUMENT_SCOPE("fillTiled");
+    _scratchSize = tiledFillImage(image, tileSize, halo, _config, _scratch, _threadPool);
+}
+/**
+ * @brief Finds the holes of the given mask into the holes of the scratch, whose pixels are in
+ *        the arena of the scratch, so the holes of an image allocate nothing once the arena is
+ *        large enough.
+ * @param mask The mask of the missing pixels.
+ * @return The holes of the mask, valid until the next fill.
+ */
+const std::vector<Hole> &HoleFiller::detectHoles(const HoleMask &mask)
+{
+    ::findHoles(mask, _config.connectivity, _scratch.labelling, &_scratch.holeArena,
+                _scratch.holes, &_threadPool);
+    return _scratch.holes;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+/**
+ * @file HoleFiller.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the HoleFiller Class.
+ */
+
+
+#ifndef HOLEFILLER_H
+#define HOLEFILLER_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "ColorImage.h"
+#include "Hole.h"
+#include "HoleMask.h"
+#include "HoleDetection.h"
+#include "HoleSchedule.h"
+#include "MonotonicArena.h"
+#include "FillConfig.h"
+#include "FillKernel.h"
+#include "GpuFill.h"
+#include "WeightTable.h"
+#include "ThreadPool.h"
+#include "MappedImage.h"
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The buffers of the fills of a HoleFiller, which keep their allocations between fills.
+ */
+struct FillScratch
+{
+    HoleMask mask;  // The mask of the missing pixels of the last image.
+    LabellingScratch labelling;  // The buffers of the labelling of the hole detection.
+    MonotonicArena holeArena;  // The arena of the pixels of the holes of the last image.
+    std::vector<Hole> holes;  // The holes of the last image.
+    MonotonicArena windowArena;  // The arena of the pixels of the holes of the last window.
+    std::vector<Hole> windowHoles;  // The holes of the last window of the tiled fill.
+    std::vector<Hole> completeHoles;  // The complete holes of the last window.
+    MonotonicArena levelArena;  // The arena of the pixels of the holes of the last level.
+    std::vector<Hole> levelHoles;  // The holes of the last level of the pyramid fill.
+    HoleSchedule schedule;  // The order in which the threads fill the holes of the last image.
+    BoundaryArrays boundary;  // The boundary of the last split hole as struct-of-arrays.
+    GpuFill gpuFill;  // The jobs of the holes which are filled on the GPU.
+    WeightTable weightTable;  // The weight table of the exact fill.
+    FillConfig tableConfig;  // The parameters the weight table was computed for.
+    std::vector<int> layers;  // The layers plane of the neighbours fill.
+    std::vector<float> values;  // The values plane of the neighbours fill.
+    std::vector<Pixel> layerPixels;  // The hole pixels of the neighbours fill, layer by layer.
+};
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a reusable hole fill context, which is the library interface of
+ *        the hole filling. The filler owns its threads and the scratch buffers of the fills
+ *        (the mask, the labelling and the arenas of the holes of the hole detection, the
+ *        boundary arrays, the weight table and the planes of the neighbours fill), so a filler
+ *        which fills many images allocates them once. The images are views of the caller's
+ *        pixels of 8, 16 or 32 bits, of a single channel or of interleaved channels, and they
+ *        are filled in place. A filler must not be used by two threads at once.
+ */
+class HoleFiller
+{
+public:
+    /**
+     * @brief A Constructor for the HoleFiller.
+     * @param config The parameters of the fills.
+     * @param threadCount The number of threads used in the fills, 0 for all the hardware
+     *        threads.
+     */
+    explicit HoleFiller(const FillConfig &config, const unsigned int threadCount = 0);
+
+    /**
+     * @brief The filler owns its threads and its buffers, so it can't be copied.
+     */
+    HoleFiller(const HoleFiller &other) = delete;
+
+    /**
+     * @brief The filler owns its threads and its buffers, so it can't be copied.
+     */
+    HoleFiller& operator=(const HoleFiller &other) = delete;
+
+    /**
+     * @brief Returns the parameters of the fills.
+     * @return The parameters of the fills.
+     */
+    const FillConfig &getConfig() const { return _config; }
+
+    /**
+     * @brief Sets the parameters of the next fills. The buffers are kept.
+     * @param config The parameters of the fills.
+     */
+    void setConfig(const FillConfig &config) { _config = config; }
+
+    /**
+     * @brief Finds all the holes of the given image, i.e. its MISSING_VALUE pixels, and their
+     *        boundaries by the connectivity of the parameters.
+     * @param image The image with the missing pixels in it.
+     * @return A vector of all the holes in the image.
+     */
+    std::vector<Hole> findHoles(const Image &image);
+
+    /**
+     * @brief Finds all the holes of the given mask and their boundaries by the connectivity of
+     *        the parameters.
+     * @param mask The mask of the missing pixels.
+     * @return A vector of all the holes in the mask.
+     */
+    std::vector<Hole> findHoles(const HoleMask &mask);
+
+    /**
+     * @brief Finds the holes of the given image, i.e. its MISSING_VALUE pixels, and fills them.
+     * @param image The image to fix.
+     */
+    void fill(Image &image);
+
+    /**
+     * @brief Finds the holes of the given mask and fills them in the given image.
+     * @param image The image to fix.
+     * @param mask The mask of the missing pixels of the image, of the same size.
+     */
+    void fill(Image &image, const HoleMask &mask);
+
+    /**
+     * @brief Finds the holes of the given mask and fills them in the given image.
+     * @param image The image to fix.
+     * @param mask The mask of the missing pixels of the image, of the same size.
+     */
+    void fill(ShortImage &image, const HoleMask &mask);
+
+    /**
+     * @brief Finds the holes of the given mask and fills them in the given image.
+     * @param image The image to fix.
+     * @param mask The mask of the missing pixels of the image, of the same size.
+     */
+    void fill(ByteImage &image, const HoleMask &mask);
+
+    /**
+     * @brief Finds the holes of the given mask once and fills them in all the channels of the
+     *        given multi-channel image.
+     * @param image The image to fix.
+     * @param mask The mask of the missing pixels of the image, of the same size.
+     */
+    void fill(ColorImage &image, const HoleMask &mask);
+
+    /**
+     * @brief Finds the holes of the given mask once and fills them in all the channels of the
+     *        given multi-channel image.
+     * @param image The image to fix.
+     * @param mask The mask of the missing pixels of the image, of the same size.
+     */
+    void fill(ByteColorImage &image, const HoleMask &mask);
+
+    /**
+     * @brief Fills the given holes of the given image.
+     * @param image The image to fix.
+     * @param holes The holes in the image.
+     */
+    void fillHoles(Image &image, const std::vector<Hole> &holes);
+
+    /**
+     * @brief Fills the given holes of the given image.
+     * @param image The image to fix.
+     * @param holes The holes in the image.
+     */
+    void fillHoles(ShortImage &image, const std::vector<Hole> &holes);
+
+    /**
+     * @brief Fills the given holes of the given image.
+     * @param image The image to fix.
+     * @param holes The holes in the image.
+     */
+    void fillHoles(ByteImage &image, const std::vector<Hole> &holes);
+
+    /**
+     * @brief Fills the given holes in all the channels of the given multi-channel image.
+     * @param image The image to fix.
+     * @param holes The holes in the image.
+     */
+    void fillHoles(ColorImage &image, const std::vector<Hole> &holes);
+
+    /**
+     * @brief Fills the given holes in all the channels of the given multi-channel image.
+     * @param image The image to fix.
+     * @param holes The holes in the image.
+     */
+    void fillHoles(ByteColorImage &image, const std::vector<Hole> &holes);
+
+    /**
+     * @brief Fills all the holes of the mapped image tile by tile, so the memory is set by the
+     *        tile size (and by the largest hole) and not by the image size.
+     * @param image The mapped image to fix.
+     * @param tileSize The number of rows and columns in a tile.
+     * @param halo The initial number of rows and columns around a tile in its window.
+     */
+    void fillTiled(MappedImage &image, const int tileSize, const int halo);
+
+    /**
+     * @brief Returns the number of bytes of the weight table and of the transforms used by the
+     *        last fill.
+     * @return The number of bytes of the scratch memory of the last fill.
+     */
+    size_t getScratchSize() const { return _scratchSize; }
+
+private:
+    /**
+     * @brief Finds the holes of the given mask into the holes of the scratch, whose pixels are
+     *        in the arena of the scratch, so the holes of an image allocate nothing once the
+     *        arena is large enough.
+     * @param mask The mask of the missing pixels.
+     * @return The holes of the mask, valid until the next fill.
+     */
+    const std::vector<Hole> &detectHoles(const HoleMask &mask);
+
+    FillConfig _config;  // The parameters of the fills.
+    ThreadPool _threadPool;  // The threads used in the fills.
+    FillScratch _scratch;  // The buffers of the fills.
+    size_t _scratchSize;  // The number of bytes of the scratch memory of the last fill.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -10,14 +10,33 @@
 
 
 #include <iostream>
-#include <deque>
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <cmath>
-#include <random>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include "Pixel.h"
+#include "Image.h"
+#include "ColorImage.h"
 #include "Hole.h"
+#include "HoleDetection.h"
+#include "HoleMask.h"
+#include "FillConfig.h"
+#include "HoleFiller.h"
+#include "HoleGenerator.h"
+#include "MappedImage.h"
+#include "BoundedQueue.h"
 #include "HoleException.h"
+#include "Instrumentation.h"
 
 
 /*-----=  Definitions  =-----*/
@@ -25,69 +44,342 @@
 
 /**
  * @def VALID_ARGUMENT_COUNT 5
- * @brief A Macro that sets the valid number of arguments for this program.
+ * @brief A Macro that sets the valid number of arguments for this program, without options.
  */
 #define VALID_ARGUMENT_COUNT 5
 
 /**
- * @def IMAGE_PATH_ARG_INDEX 1
- * @brief A Macro that sets the index of the image path in the program arguments.
+ * @def BATCH_ARGUMENT_COUNT 3
+ * @brief A Macro that sets the valid number of arguments for the batch mode, without options.
  */
-#define IMAGE_PATH_ARG_INDEX 1
+#define BATCH_ARGUMENT_COUNT 3
 
 /**
- * @def EPSILON_ARG_INDEX 2
- * @brief A Macro that sets the index of the epsilon value in the program arguments.
+ * @def USAGE_MESSAGE
+ * @brief A Macro that sets the usage message of this program.
  */
-#define EPSILON_ARG_INDEX 2
+#define USAGE_MESSAGE "Usage: HoleFilling <image_path> <epsilon> <z> <connectivity> " \
+                      "[--threads <count>] [--strategy <exact|neighbours|approximate|pyramid|auto>] " \
+                      "[--weight <inverse-power|gaussian>] [--sigma <value>] " \
+                      "[--tolerance <value>] [--convolution <auto|always|never>] " \
+                      "[--device <auto|cpu|gpu>] " \
+                      "[--mask <path>] [--holes <rectangle|ellipse|brush|pinhole> <coverage> " \
+                      "[--hole-size <size>] [--seed <seed>]] [--report-error] [--report-memory] " \
+                      "[--stats <path>] [--trace <path>] [--color] [--headless [--output <path>]] " \
+                      "[--tiled <rows> <cols> --output <path> [--tile-size <size>] [--halo <size>]]\n" \
+                      "       HoleFilling --batch <manifest> [options]"
 
 /**
- * @def Z_ARG_INDEX 3
- * @brief A Macro that sets the index of the z value in the program arguments.
+ * @def BATCH_OPTION "--batch"
+ * @brief A Macro that sets the option for filling the images of a manifest without display.
  */
-#define Z_ARG_INDEX 3
+#define BATCH_OPTION "--batch"
 
 /**
- * @def CONNECTIVITY_ARG_INDEX 4
- * @brief A Macro that sets the index of the pixel connectivity value in the program arguments.
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option for the number of threads used in the fill.
  */
-#define CONNECTIVITY_ARG_INDEX 4
+#define THREADS_OPTION "--threads"
 
 /**
- * @def FLOAT_POINT '.'
- * @brief A Macro that represents the character for the float point.
+ * @def STRATEGY_OPTION "--strategy"
+ * @brief A Macro that sets the option for the fill strategy.
  */
-#define FLOAT_POINT '.'
+#define STRATEGY_OPTION "--strategy"
+
+/**
+ * @def WEIGHT_OPTION "--weight"
+ * @brief A Macro that sets the option for the weighted function.
+ */
+#define WEIGHT_OPTION "--weight"
+
+/**
+ * @def SIGMA_OPTION "--sigma"
+ * @brief A Macro that sets the option for the standard deviation of the gaussian weight.
+ */
+#define SIGMA_OPTION "--sigma"
+
+/**
+ * @def TOLERANCE_OPTION "--tolerance"
+ * @brief A Macro that sets the option for the error tolerance of the approximate fill.
+ */
+#define TOLERANCE_OPTION "--tolerance"
+
+/**
+ * @def CONVOLUTION_OPTION "--convolution"
+ * @brief A Macro that sets the option for filling the holes of the exact fill as convolutions.
+ */
+#define CONVOLUTION_OPTION "--convolution"
+
+/**
+ * @def DEVICE_OPTION "--device"
+ * @brief A Macro that sets the option for the device which fills the holes of the exact fill.
+ */
+#define DEVICE_OPTION "--device"
+
+/**
+ * @def TILED_OPTION "--tiled"
+ * @brief A Macro that sets the option for the tiled fill of a raw image of the given size.
+ */
+#define TILED_OPTION "--tiled"
+
+/**
+ * @def OUTPUT_OPTION "--output"
+ * @brief A Macro that sets the option for the path of the filled image.
+ */
+#define OUTPUT_OPTION "--output"
+
+/**
+ * @def TILE_SIZE_OPTION "--tile-size"
+ * @brief A Macro that sets the option for the number of rows and columns in a tile.
+ */
+#define TILE_SIZE_OPTION "--tile-size"
+
+/**
+ * @def HALO_OPTION "--halo"
+ * @brief A Macro that sets the option for the number of rows and columns around a tile.
+ */
+#define HALO_OPTION "--halo"
+
+/**
+ * @def MASK_OPTION "--mask"
+ * @brief A Macro that sets the option for the path of the mask of the missing pixels.
+ */
+#define MASK_OPTION "--mask"
+
+/**
+ * @def REPORT_ERROR_OPTION "--report-error"
+ * @brief A Macro that sets the option for reporting the fill error against the exact fill.
+ */
+#define REPORT_ERROR_OPTION "--report-error"
+
+/**
+ * @def REPORT_MEMORY_OPTION "--report-memory"
+ * @brief A Macro that sets the option for reporting the scratch memory of the fill.
+ */
+#define REPORT_MEMORY_OPTION "--report-memory"
+
+/**
+ * @def HEADLESS_OPTION "--headless"
+ * @brief A Macro that sets the option for filling the image in place without display.
+ */
+#define HEADLESS_OPTION "--headless"
+
+/**
+ * @def COLOR_OPTION "--color"
+ * @brief A Macro that sets the option for filling all the channels of a color image at once.
+ */
+#define COLOR_OPTION "--color"
+
+/**
+ * @def HOLES_OPTION "--holes"
+ * @brief A Macro that sets the option which generates holes of a shape up to a coverage.
+ */
+#define HOLES_OPTION "--holes"
+
+/**
+ * @def HOLE_SIZE_OPTION "--hole-size"
+ * @brief A Macro that sets the option of the maximal size of a generated hole.
+ */
+#define HOLE_SIZE_OPTION "--hole-size"
+
+/**
+ * @def SEED_OPTION "--seed"
+ * @brief A Macro that sets the option of the seed of the generated holes.
+ */
+#define SEED_OPTION "--seed"
+
+/**
+ * @def STATS_OPTION "--stats"
+ * @brief A Macro that sets the option for writing the timings and the counters as JSON.
+ */
+#define STATS_OPTION "--stats"
+
+/**
+ * @def TRACE_OPTION "--trace"
+ * @brief A Macro that sets the option for writing the timings as a Chrome trace.
+ */
+#define TRACE_OPTION "--trace"
+
+/**
+ * @def EXACT_STRATEGY_NAME "exact"
+ * @brief A Macro that sets the name of the exact fill strategy.
+ */
+#define EXACT_STRATEGY_NAME "exact"
+
+/**
+ * @def NEIGHBOURS_STRATEGY_NAME "neighbours"
+ * @brief A Macro that sets the name of the neighbours fill strategy.
+ */
+#define NEIGHBOURS_STRATEGY_NAME "neighbours"
+
+/**
+ * @def APPROXIMATE_STRATEGY_NAME "approximate"
+ * @brief A Macro that sets the name of the quadtree approximate fill strategy.
+ */
+#define APPROXIMATE_STRATEGY_NAME "approximate"
+
+/**
+ * @def PYRAMID_STRATEGY_NAME "pyramid"
+ * @brief A Macro that sets the name of the coarse-to-fine pyramid fill strategy.
+ */
+#define PYRAMID_STRATEGY_NAME "pyramid"
+
+/**
+ * @def AUTO_STRATEGY_NAME "auto"
+ * @brief A Macro that sets the name of the strategy which is chosen for every hole by its cost.
+ */
+#define AUTO_STRATEGY_NAME "auto"
+
+/**
+ * @def INVERSE_POWER_WEIGHT_NAME "inverse-power"
+ * @brief A Macro that sets the name of the default inverse power weighted function.
+ */
+#define INVERSE_POWER_WEIGHT_NAME "inverse-power"
+
+/**
+ * @def GAUSSIAN_WEIGHT_NAME "gaussian"
+ * @brief A Macro that sets the name of the gaussian weighted function.
+ */
+#define GAUSSIAN_WEIGHT_NAME "gaussian"
+
+/**
+ * @def AUTO_CONVOLUTION_NAME "auto"
+ * @brief A Macro that sets the name of the mode which picks the convolution by its cost.
+ */
+#define AUTO_CONVOLUTION_NAME "auto"
+
+/**
+ * @def ALWAYS_CONVOLUTION_NAME "always"
+ * @brief A Macro that sets the name of the mode which fills every hole as a convolution.
+ */
+#define ALWAYS_CONVOLUTION_NAME "always"
+
+/**
+ * @def NEVER_CONVOLUTION_NAME "never"
+ * @brief A Macro that sets the name of the mode which never fills a hole as a convolution.
+ */
+#define NEVER_CONVOLUTION_NAME "never"
+
+/**
+ * @def AUTO_DEVICE_NAME "auto"
+ * @brief A Macro that sets the name of the mode which picks the device by the size of a hole.
+ */
+#define AUTO_DEVICE_NAME "auto"
+
+/**
+ * @def CPU_DEVICE_NAME "cpu"
+ * @brief A Macro that sets the name of the mode which fills every hole on the CPU.
+ */
+#define CPU_DEVICE_NAME "cpu"
+
+/**
+ * @def GPU_DEVICE_NAME "gpu"
+ * @brief A Macro that sets the name of the mode which fills every hole on the GPU.
+ */
+#define GPU_DEVICE_NAME "gpu"
+
+/**
+ * @def RECTANGLE_HOLE_NAME "rectangle"
+ * @brief A Macro that sets the name of the rectangle hole shape.
+ */
+#define RECTANGLE_HOLE_NAME "rectangle"
+
+/**
+ * @def ELLIPSE_HOLE_NAME "ellipse"
+ * @brief A Macro that sets the name of the ellipse hole shape.
+ */
+#define ELLIPSE_HOLE_NAME "ellipse"
+
+/**
+ * @def BRUSH_STROKE_HOLE_NAME "brush"
+ * @brief A Macro that sets the name of the brush stroke hole shape.
+ */
+#define BRUSH_STROKE_HOLE_NAME "brush"
+
+/**
+ * @def PINHOLE_HOLE_NAME "pinhole"
+ * @brief A Macro that sets the name of the pinhole shape.
+ */
+#define PINHOLE_HOLE_NAME "pinhole"
 
 /**
- * @def MISSING_VALUE -1
- * @brief A Macro that sets the value of a missing pixel.
+ * @def DEFAULT_THREAD_COUNT 0
+ * @brief A Macro that sets the default number of threads, 0 means all the hardware threads.
  */
-#define MISSING_VALUE (-1)
+#define DEFAULT_THREAD_COUNT 0
 
 /**
- * @def INITIAL_ROW 0
- * @brief A Macro that sets the value of the first row coordinate in the image.
+ * @def DEFAULT_TILE_SIZE 1024
+ * @brief A Macro that sets the default number of rows and columns in a tile.
  */
-#define INITIAL_ROW 0
+#define DEFAULT_TILE_SIZE 1024
 
 /**
- * @def INITIAL_COLUMN 0
- * @brief A Macro that sets the value of the first column coordinate in the image.
+ * @def DEFAULT_HALO 64
+ * @brief A Macro that sets the default number of rows and columns around a tile.
  */
-#define INITIAL_COLUMN 0
+#define DEFAULT_HALO 64
 
 /**
- * @def EPSILON_INITIAL -1
- * @brief A Macro that sets the initial value for the epsilon parameter.
+ * @def DEFAULT_HOLE_SIZE 32
+ * @brief A Macro that sets the default maximal size of a generated hole.
  */
-#define EPSILON_INITIAL (-1)
+#define DEFAULT_HOLE_SIZE 32
 
 /**
- * @def Z_INITIAL -1
- * @brief A Macro that sets the initial value for the z parameter.
+ * @def DEFAULT_SEED 1
+ * @brief A Macro that sets the default seed of the generated holes.
  */
-#define Z_INITIAL (-1)
+#define DEFAULT_SEED 1
+
+/**
+ * @def BATCH_QUEUE_CAPACITY 4
+ * @brief A Macro that sets the maximal number of images waiting between two stages of the batch.
+ */
+#define BATCH_QUEUE_CAPACITY 4
+
+/**
+ * @def MANIFEST_COMMENT '#'
+ * @brief A Macro that sets the character which starts a comment line in the batch manifest.
+ */
+#define MANIFEST_COMMENT '#'
+
+/**
+ * @def MANIFEST_ARG_INDEX 2
+ * @brief A Macro that sets the index of the manifest path in the program arguments.
+ */
+#define MANIFEST_ARG_INDEX 2
+
+/**
+ * @def IMAGE_PATH_ARG_INDEX 1
+ * @brief A Macro that sets the index of the image path in the program arguments.
+ */
+#define IMAGE_PATH_ARG_INDEX 1
+
+/**
+ * @def EPSILON_ARG_INDEX 2
+ * @brief A Macro that sets the index of the epsilon value in the program arguments.
+ */
+#define EPSILON_ARG_INDEX 2
+
+/**
+ * @def Z_ARG_INDEX 3
+ * @brief A Macro that sets the index of the z value in the program arguments.
+ */
+#define Z_ARG_INDEX 3
+
+/**
+ * @def CONNECTIVITY_ARG_INDEX 4
+ * @brief A Macro that sets the index of the pixel connectivity value in the program arguments.
+ */
+#define CONNECTIVITY_ARG_INDEX 4
+
+/**
+ * @def FLOAT_POINT '.'
+ * @brief A Macro that represents the character for the float point.
+ */
+#define FLOAT_POINT '.'
 
 /**
  * @def DEFAULT_MARK_COLOR 1
@@ -108,69 +400,435 @@
 #define PIXEL_ARRAY_EXAMPLE {Pixel(20, 20), Pixel(20, 21), Pixel(20, 22), Pixel(20, 23), Pixel(20, 24), Pixel(21, 20), Pixel(21, 21), Pixel(21, 22), Pixel(21, 23), Pixel(21, 24), Pixel(22, 20), Pixel(22, 21), Pixel(22, 22), Pixel(22, 23), Pixel(22, 24), Pixel(23, 20), Pixel(23, 21), Pixel(23, 22), Pixel(23, 23), Pixel(24, 20)}
 
 
-/*-----=  Program Arguments Functions  =-----*/
-
+/*-----=  Type Definitions  =-----*/
 
-/**
- * @brief The epsilon value used in the default weighted function.
- */
-float epsilon = EPSILON_INITIAL;
 
 /**
- * @brief The z value used in the default weighted function.
+ * @brief The parameters of the program, given by the user.
  */
-float z = Z_INITIAL;
+struct ProgramOptions
+{
+    FillConfig config;  // The parameters of the fill.
+    unsigned int threadCount = DEFAULT_THREAD_COUNT;  // The number of threads used in the fill.
+    bool reportError = false;  // Whether to report the fill error against the exact fill.
+    bool reportMemory = false;  // Whether to report the scratch memory of the fill.
+    bool headless = false;  // Whether to fill the image in place without display.
+    bool color = false;  // Whether to fill all the channels of the color image.
+    int tiledRows = 0;  // The number of rows in the raw image of the tiled fill, 0 if not tiled.
+    int tiledCols = 0;  // The number of columns in the raw image of the tiled fill.
+    const char *outputPath = nullptr;  // The path of the filled image.
+    const char *maskPath = nullptr;  // The path of the mask of the missing pixels, if given.
+    int tileSize = DEFAULT_TILE_SIZE;  // The number of rows and columns in a tile.
+    int halo = DEFAULT_HALO;  // The number of rows and columns around a tile.
+    bool generateHoles = false;  // Whether to generate holes instead of the example hole.
+    HoleShape holeShape = RECTANGLE_HOLE;  // The shape of the generated holes.
+    double holeCoverage = 0;  // The fraction of the image the generated holes cover.
+    int holeSize = DEFAULT_HOLE_SIZE;  // The maximal size of a generated hole.
+    unsigned int seed = DEFAULT_SEED;  // The seed of the generated holes.
+};
 
 
 /*-----=  Program Arguments Functions  =-----*/
 
 
 /**
- * @brief Validate that a given argument (represented as a char *) is a floating number.
+ * @brief Validate that a given argument (represented as a char *) is a floating number, which
+ *        is parsed entirely and fits in a float (so "." or "1.2.3" aren't floats).
  * @param arg The argument to validate.
  * @return 0 if the argument represent a floating number, 1 otherwise.
  */
 static int validateNumeric(const char *arg)
 {
-    while (*arg != '\0')
+    for (const char *digit = arg; *digit != '\0'; ++digit)
+    {
+        if (!(isdigit(*digit)) && (*digit != FLOAT_POINT))
+        {
+            // The current argument represent something that is not a float number.
+            return EXIT_FAILURE;
+        }
+    }
+    char *end = nullptr;
+    errno = 0;
+    std::strtof(arg, &end);
+    if (end == arg || *end != '\0' || errno == ERANGE)
+    {
+        // The digits and the points aren't a single float, or it is out of range.
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Validate that a given program arguments (represented as a char *) is a floating number.
+ * @param epsilon The argument that represent the epsilon value.
+ * @param z The argument that represent the z value.
+ * @return 0 if the both arguments represent a floating number, 1 otherwise.
+ */
+static int validateNumericArguments(const char *epsilon, const char *z, const char *connectivity)
+{
+    if (validateNumeric(epsilon))
+    {
+        // Invalid epsilon argument.
+        std::cerr << "Error: epsilon should be float" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (validateNumeric(z))
+    {
+        // Invalid z argument.
+        std::cerr << "Error: z value should be float" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (std::string(connectivity) != "4" && std::string(connectivity) != "8")
+    {
+        // Invalid connectivity argument.
+        std::cerr << "Error: pixel connectivity value should be 4 or 8" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ * @brief Validate that a given argument (represented as a char *) is a non negative integer,
+ *        which fits in an int.
+ * @param arg The argument to validate.
+ * @return 0 if the argument represent a non negative integer, 1 otherwise.
+ */
+static int validateInteger(const char *arg)
+{
+    if (*arg == '\0')
     {
-        if (!(isdigit(*arg)) && (*arg != FLOAT_POINT))
+        return EXIT_FAILURE;
+    }
+    for (const char *digit = arg; *digit != '\0'; ++digit)
+    {
+        if (!(isdigit(*digit)))
+        {
+            // The current argument represent something that is not an integer.
+            return EXIT_FAILURE;
+        }
+    }
+    errno = 0;
+    const long value = std::strtol(arg, nullptr, 10);
+    if (errno == ERANGE || value > INT_MAX)
+    {
+        // The integer is out of range.
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parse the optional program arguments which follow the positional arguments.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param firstOption The index of the first optional argument.
+ * @param options The program parameters to set.
+ */
+static void parseOptions(int argc, char *argv[], const int firstOption, ProgramOptions &options)
+{
+    for (int i = firstOption; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (option == THREADS_OPTION && i + 1 < argc)
+        {
+            const char *threadsArgument = argv[++i];
+            if (validateInteger(threadsArgument))
+            {
+                // Invalid threads argument.
+                std::cerr << "Error: number of threads should be a non negative integer"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.threadCount = (unsigned int) std::stoul(threadsArgument);
+        }
+        else if (option == STRATEGY_OPTION && i + 1 < argc)
+        {
+            const std::string strategy = argv[++i];
+            if (strategy == EXACT_STRATEGY_NAME)
+            {
+                options.config.strategy = EXACT_FILL;
+            }
+            else if (strategy == NEIGHBOURS_STRATEGY_NAME)
+            {
+                options.config.strategy = NEIGHBOURS_FILL;
+            }
+            else if (strategy == APPROXIMATE_STRATEGY_NAME)
+            {
+                options.config.strategy = APPROXIMATE_FILL;
+            }
+            else if (strategy == PYRAMID_STRATEGY_NAME)
+            {
+                options.config.strategy = PYRAMID_FILL;
+            }
+            else if (strategy == AUTO_STRATEGY_NAME)
+            {
+                options.config.strategy = AUTO_FILL;
+            }
+            else
+            {
+                // Invalid strategy argument.
+                std::cerr << "Error: unknown fill strategy " << strategy << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (option == TOLERANCE_OPTION && i + 1 < argc)
+        {
+            const char *toleranceArgument = argv[++i];
+            if (validateNumeric(toleranceArgument))
+            {
+                // Invalid tolerance argument.
+                std::cerr << "Error: tolerance should be float" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.config.tolerance = std::stof(toleranceArgument);
+        }
+        else if (option == WEIGHT_OPTION && i + 1 < argc)
+        {
+            const std::string weight = argv[++i];
+            if (weight == INVERSE_POWER_WEIGHT_NAME)
+            {
+                options.config.weight = INVERSE_POWER_WEIGHT;
+            }
+            else if (weight == GAUSSIAN_WEIGHT_NAME)
+            {
+                options.config.weight = GAUSSIAN_WEIGHT;
+            }
+            else
+            {
+                // Invalid weight argument.
+                std::cerr << "Error: unknown weighted function " << weight << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (option == SIGMA_OPTION && i + 1 < argc)
+        {
+            const char *sigmaArgument = argv[++i];
+            if (validateNumeric(sigmaArgument) || std::stof(sigmaArgument) < MIN_SIGMA)
+            {
+                // Invalid sigma argument.
+                std::cerr << "Error: sigma should be a float of at least " << MIN_SIGMA
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.config.sigma = std::stof(sigmaArgument);
+        }
+        else if (option == REPORT_ERROR_OPTION)
+        {
+            options.reportError = true;
+        }
+        else if (option == CONVOLUTION_OPTION && i + 1 < argc)
+        {
+            const std::string mode = argv[++i];
+            if (mode == AUTO_CONVOLUTION_NAME)
+            {
+                options.config.convolution = AUTO_CONVOLUTION;
+            }
+            else if (mode == ALWAYS_CONVOLUTION_NAME)
+            {
+                options.config.convolution = ALWAYS_CONVOLUTION;
+            }
+            else if (mode == NEVER_CONVOLUTION_NAME)
+            {
+                options.config.convolution = NEVER_CONVOLUTION;
+            }
+            else
+            {
+                // Invalid convolution argument.
+                std::cerr << "Error: unknown convolution mode " << mode << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (option == DEVICE_OPTION && i + 1 < argc)
+        {
+            const std::string device = argv[++i];
+            if (device == AUTO_DEVICE_NAME)
+            {
+                options.config.device = AUTO_DEVICE;
+            }
+            else if (device == CPU_DEVICE_NAME)
+            {
+                options.config.device = CPU_DEVICE;
+            }
+            else if (device == GPU_DEVICE_NAME)
+            {
+                options.config.device = GPU_DEVICE;
+            }
+            else
+            {
+                // Invalid device argument.
+                std::cerr << "Error: unknown device " << device << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (option == TILED_OPTION && i + 2 < argc)
+        {
+            const char *rowsArgument = argv[++i];
+            const char *colsArgument = argv[++i];
+            if (validateInteger(rowsArgument) || validateInteger(colsArgument) ||
+                std::stoi(rowsArgument) == 0 || std::stoi(colsArgument) == 0)
+            {
+                // Invalid raw image size.
+                std::cerr << "Error: raw image size should be positive integers" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.tiledRows = std::stoi(rowsArgument);
+            options.tiledCols = std::stoi(colsArgument);
+        }
+        else if (option == OUTPUT_OPTION && i + 1 < argc)
+        {
+            options.outputPath = argv[++i];
+        }
+        else if (option == MASK_OPTION && i + 1 < argc)
+        {
+            options.maskPath = argv[++i];
+        }
+        else if ((option == TILE_SIZE_OPTION || option == HALO_OPTION) && i + 1 < argc)
+        {
+            const char *sizeArgument = argv[++i];
+            if (validateInteger(sizeArgument) || (option == TILE_SIZE_OPTION &&
+                                                  std::stoi(sizeArgument) == 0))
+            {
+                // Invalid size argument.
+                std::cerr << "Error: " << option << " should be a positive integer" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            (option == TILE_SIZE_OPTION ? options.tileSize : options.halo) = std::stoi(sizeArgument);
+        }
+        else if (option == HOLES_OPTION && i + 2 < argc)
+        {
+            const std::string shape = argv[++i];
+            const char *coverageArgument = argv[++i];
+            if (shape == RECTANGLE_HOLE_NAME)
+            {
+                options.holeShape = RECTANGLE_HOLE;
+            }
+            else if (shape == ELLIPSE_HOLE_NAME)
+            {
+                options.holeShape = ELLIPSE_HOLE;
+            }
+            else if (shape == BRUSH_STROKE_HOLE_NAME)
+            {
+                options.holeShape = BRUSH_STROKE_HOLE;
+            }
+            else if (shape == PINHOLE_HOLE_NAME)
+            {
+                options.holeShape = PINHOLE_HOLE;
+            }
+            else
+            {
+                // Invalid shape argument.
+                std::cerr << "Error: unknown hole shape " << shape << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if (validateNumeric(coverageArgument) || std::stod(coverageArgument) > 1)
+            {
+                // Invalid coverage argument.
+                std::cerr << "Error: hole coverage should be a float in [0,1]" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.generateHoles = true;
+            options.holeCoverage = std::stod(coverageArgument);
+        }
+        else if (option == HOLE_SIZE_OPTION && i + 1 < argc)
+        {
+            const char *sizeArgument = argv[++i];
+            if (validateInteger(sizeArgument) || std::stoi(sizeArgument) == 0)
+            {
+                // Invalid size argument.
+                std::cerr << "Error: " << option << " should be a positive integer" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.holeSize = std::stoi(sizeArgument);
+        }
+        else if (option == SEED_OPTION && i + 1 < argc)
+        {
+            const char *seedArgument = argv[++i];
+            if (validateInteger(seedArgument))
+            {
+                // Invalid seed argument.
+                std::cerr << "Error: seed should be a non negative integer" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            options.seed = (unsigned int) std::stoul(seedArgument);
+        }
+        else if (option == REPORT_MEMORY_OPTION)
+        {
+            options.reportMemory = true;
+        }
+        else if (option == HEADLESS_OPTION)
+        {
+            options.headless = true;
+        }
+        else if (option == COLOR_OPTION)
+        {
+            options.color = true;
+        }
+        else if ((option == STATS_OPTION || option == TRACE_OPTION) && i + 1 < argc)
+        {
+            const char *outputArgument = argv[++i];
+#ifdef HOLEFILLING_INSTRUMENTATION
+            if (option == STATS_OPTION)
+            {
+                Instrumentation::setJsonOutput(outputArgument);
+            }
+            else
+            {
+                Instrumentation::setTraceOutput(outputArgument);
+            }
+#else
+            // The instrumentation is compiled out.
+            (void) outputArgument;
+            std::cerr << "Error: " << option << " requires a build with instrumentation "
+                      << "(make INSTRUMENT=1)" << std::endl;
+            exit(EXIT_FAILURE);
+#endif
+        }
+        else
         {
-            // The current argument represent something that is not a float number.
-            return EXIT_FAILURE;
+            // Invalid option.
+            std::cerr << USAGE_MESSAGE << std::endl;
+            exit(EXIT_FAILURE);
         }
-        arg++;
     }
-    return EXIT_SUCCESS;
-}
-
-/**
- * @brief Validate that a given program arguments (represented as a char *) is a floating number.
- * @param epsilon The argument that represent the epsilon value.
- * @param z The argument that represent the z value.
- * @return 0 if the both arguments represent a floating number, 1 otherwise.
- */
-static int validateNumericArguments(const char *epsilon, const char *z, const char *connectivity)
-{
-    if (validateNumeric(epsilon))
+    if (options.config.weight != INVERSE_POWER_WEIGHT && options.config.strategy == APPROXIMATE_FILL)
     {
-        // Invalid epsilon argument.
-        std::cerr << "Error: epsilon should be float" << std::endl;
+        // The quadtree aggregates the clusters of the inverse power weight only.
+        std::cerr << "Error: the approximate fill supports only the inverse-power weight"
+                  << std::endl;
         exit(EXIT_FAILURE);
     }
-    if (validateNumeric(z))
+    if (options.tiledRows != 0 && options.outputPath == nullptr)
     {
-        // Invalid z argument.
-        std::cerr << "Error: z value should be float" << std::endl;
+        // The tiled fill writes the filled image to a file.
+        std::cerr << "Error: the tiled fill requires an output path" << std::endl;
         exit(EXIT_FAILURE);
     }
-    if (*connectivity != '4' && *connectivity != '8')
+    if (options.outputPath != nullptr && options.tiledRows == 0 && !options.headless)
     {
-        // Invalid connectivity argument.
-        std::cerr << "Error: pixel connectivity value should be 4 or 8" << std::endl;
+        // The displayed image isn't written, the filled images are written without display.
+        std::cerr << "Error: --output requires --tiled or --headless" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (options.tiledRows != 0 && options.maskPath != nullptr)
+    {
+        // The raw image of the tiled fill marks its missing pixels by MISSING_VALUE.
+        std::cerr << "Error: the tiled fill doesn't support a mask" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (options.color && (options.tiledRows != 0 || options.reportError))
+    {
+        // The raw image of the tiled fill is a single channel of floats, and the error is
+        // reported against the exact fill of a single channel.
+        std::cerr << "Error: --color doesn't support --tiled or --report-error" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (options.generateHoles && (options.tiledRows != 0 || options.maskPath != nullptr))
+    {
+        // The holes of a raw image or of a mask are given, so none are generated.
+        std::cerr << "Error: --holes doesn't support --tiled or --mask" << std::endl;
         exit(EXIT_FAILURE);
     }
-    return EXIT_SUCCESS;
 }
 
 
@@ -178,265 +836,203 @@ static int validateNumericArguments(const char *epsilon, const char *z, const ch
 
 
 /**
- * @brief Finds a missing pixel in the given image.
- *        If there is no missing pixel the function throws an exception.
- * @param image The image to search in.
- * @param rows The number of rows in the image.
- * @param cols The number of columns in the image.
- * @return A Pixel class represent a missing pixel in the image.
+ * @brief Report the error of a filled image against the exact fill of the same image.
+ * @tparam T The type of the pixel values of the image.
+ * @param filledImage The filled image.
+ * @param exactImage The image filled by the exact fill.
+ * @param holes The holes in the image.
  */
-static Pixel findMissingPixel(float **image, const int rows, const int cols)
+template <typename T>
+static void reportFillError(const BasicImage<T> &filledImage, const BasicImage<T> &exactImage,
+                            const std::vector<Hole> &holes)
 {
-    for (int x = INITIAL_ROW ; x < rows; ++x)
+    double squaredErrorSum = 0;
+    double maxError = 0;
+    size_t pixelCount = 0;
+    for (const Hole &hole : holes)
     {
-        for (int y = INITIAL_COLUMN; y < cols; ++y)
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
         {
-            if (image[x][y] == MISSING_VALUE)
-            {
-                // Found a missing pixel.
-                return Pixel(x, y);
-            }
-        }
+            const double error = std::fabs((double) filledImage.at(x) - exactImage.at(x));
+            squaredErrorSum += error * error;
+            maxError = std::max(maxError, error);
+            ++pixelCount;
+        });
     }
-    throw NoMissingPixelException();
+    const double rmse = (pixelCount == 0) ? 0 : std::sqrt(squaredErrorSum / pixelCount);
+    std::cout << "Fill error against the exact fill: RMSE " << rmse << ", max " << maxError
+              << " (over " << pixelCount << " pixels)" << std::endl;
 }
 
-/**
- * @brief Calculate the hole in the image from a given missing pixel using BFS.
- * @param image The image containing the hole.
- * @param rows The number of rows in the image.
- * @param cols The number of columns in the image.
- * @param missingPixel A missing pixel inside the hole.
- * @param connectivity The pixel connectivity value.
- * @return A Hole class representing the hole in the image.
- */
-static Hole calculateHole(float **image, const int rows, const int cols,
-                          Pixel &missingPixel, const int connectivity)
-{
-    Hole hole;
-
-    // Set data for the BFS algorithm.
-    std::deque<Pixel> pixelQueue;
 
-    auto **visited = new bool *[rows];
-    for (int i = 0; i < rows; ++i)
-    {
-        visited[i] = new bool[cols];
-        for (int j = 0; j < cols; ++j)
-        {
-            visited[i][j] = false;
-        }
-    }
+/*-----=  Image Handling Functions  =-----*/
 
-    // Update data according to the given missing pixel.
-    pixelQueue.push_back(missingPixel);
 
-    while(!pixelQueue.empty())
+/**
+ * @brief Receive an image from the given image path, in its native 8-bit values.
+ * @param imagePath The path of the image.
+ * @param color Whether to decode all the channels of the image, or only its gray levels.
+ * @return A Mat object of type CV_8U, or CV_8UC3 for a color image, of the image.
+ */
+static cv::Mat receiveImage(const char *imagePath, const bool color)
+{
+    INSTRUMENT_SCOPE("receiveImage");
+    cv::Mat image = cv::imread(imagePath, color ? cv::IMREAD_COLOR : cv::IMREAD_GRAYSCALE);
+    if (image.empty())
     {
-        // Get the next pixel from the queue.
-        Pixel currentPixel = pixelQueue.front();
-        pixelQueue.pop_front();
-        // Mark as visited.
-        visited[currentPixel.getX()][currentPixel.getY()] = true;
-
-        // Add the current pixel to the hole.
-        assert(currentPixel.getNeighbours().empty());
-        currentPixel.setNeighbours(connectivity, rows, cols);
-        hole.addHolePixels(currentPixel);
-
-        // Get the pixel neighbours according the the pixel connectivity.
-        currentPixel.setNeighbours(connectivity, rows, cols);
-        // Traverse the neighbours.
-        for (const Pixel &neighbour : currentPixel.getNeighbours())
-        {
-            int currentX = neighbour.getX();
-            int currentY = neighbour.getY();
-            if (!visited[currentX][currentY])
-            {
-                // If this pixel hasn't been visited we process it and mark as visited.
-                visited[currentX][currentY] = true;
-                if (image[currentX][currentY] == MISSING_VALUE)
-                {
-                    // Add this pixel to the queue for next iterations.
-                    pixelQueue.emplace_back(currentX, currentY);
-                }
-                else
-                {
-                    // Don't add this pixel to the queue, instead add it to the boundary.
-                    hole.addHoleBoundary(Pixel(currentX, currentY));
-                }
-            }
-        }
+        // Invalid image argument.
+        std::cerr << "Error: invalid image" << std::endl;
+        exit(EXIT_FAILURE);
     }
+    return image;
+}
 
-    // Clear resources.
-    for (int i = 0; i < rows; ++i)
+/**
+ * @brief Receive the mask of the missing pixels from the given mask path. The mask is a 1-bit
+ *        or an 8-bit image of the size of the image, where a pixel is missing iff it isn't 0.
+ * @param maskPath The path of the mask.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ * @return The mask of the missing pixels.
+ */
+static HoleMask receiveMask(const char *maskPath, const int rows, const int cols)
+{
+    INSTRUMENT_SCOPE("receiveMask");
+    cv::Mat cvMask = cv::imread(maskPath, cv::IMREAD_GRAYSCALE);
+    if (cvMask.empty() || cvMask.rows != rows || cvMask.cols != cols)
     {
-        delete[] visited[i];
-        visited[i] = nullptr;
+        // Invalid mask argument.
+        std::cerr << "Error: invalid mask of " << rows << "x" << cols << " pixels" << std::endl;
+        exit(EXIT_FAILURE);
     }
-    delete[] visited;
-    visited = nullptr;
-
-    return hole;
+    const ByteImage maskImage(cvMask.ptr<unsigned char>(), cvMask.rows, cvMask.cols,
+                              cvMask.step1());
+    return HoleMask::fromMaskImage(maskImage);
 }
 
 /**
- * @brief Apply the default weighted function on the given Pixels.
- * @param lhs The first pixel.
- * @param rhs The second pixel.
- * @return The weighted value of the given pixels.
+ * @brief Normalize the given 8-bit image to the values in [0,1] range, in a single pass which
+ *        converts and scales every pixel.
+ * @param cvImage The 8-bit image, represented as a CV Mat object.
+ * @return A Mat object of type CV_32F of the normalized image.
  */
-static float defaultWeightedFunction(const Pixel &lhs, const Pixel &rhs)
+static cv::Mat normalizeImage(const cv::Mat &cvImage)
 {
-    double norm = std::pow(lhs.getX() - rhs.getX(), 2) + std::pow(lhs.getY() - rhs.getY(), 2);
-    norm = std::sqrt(norm);
-
-    auto weightValue = (float) (1 / (std::pow(norm, z) + epsilon));
-    return weightValue;
+    INSTRUMENT_SCOPE("convertImage");
+    INSTRUMENT_COUNT("bytes allocated", cvImage.total() * sizeof(float));
+    cv::Mat normalizedImage;
+    cvImage.convertTo(normalizedImage, CV_32F, 1.0 / NORMALIZATION_FACTOR);
+    return normalizedImage;
 }
 
 /**
- * @brief Fill the image hole of the given image.
- * @param image A pointer to the image to fix.
- * @param hole The hole in the image.
- * @param weightedFunction The weighted function used in the fill process.
+ * @brief Store the filled pixels of the holes of the given normalized image into the given
+ *        8-bit image, scaled back and rounded in a single pass. The other pixels of the
+ *        normalized image are the pixels of the 8-bit image, so they aren't written.
+ * @param image The filled normalized image.
+ * @param holes The holes in the image.
+ * @param byteImage The 8-bit image to set.
  */
-static void fillImageHole(float ***image, const Hole &hole,
-                          float (*weightedFunction)(const Pixel&, const Pixel&))
+static void storeFilledPixels(const Image &image, const std::vector<Hole> &holes,
+                              ByteImage &byteImage)
 {
-    for (const Pixel &x : hole.getHolePixels())
+    INSTRUMENT_SCOPE("convertImage");
+    for (const Hole &hole : holes)
     {
-        // For every pixel x in the hole we update it's value using the
-        // weighted function and all the pixels in the hole boundary.
-        float numerator = 0;
-        float denominator = 0;
-        for (const Pixel &y : hole.getHoleBoundary())
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
         {
-            float yValue = (*image)[y.getX()][y.getY()];
-            float weightedValue = weightedFunction(x, y);
-            numerator += weightedValue * yValue;
-            denominator += weightedValue;
-        }
-        assert(denominator != 0);
-        float newValue = numerator / denominator;
-        (*image)[x.getX()][x.getY()] = newValue;
+            byteImage.at(x) = toPixelValue<unsigned char>(image.at(x) * NORMALIZATION_FACTOR);
+        });
     }
 }
 
 /**
- * @brief Fill the image hole of the given image.
- * @param image A pointer to the image to fix.
- * @param hole The hole in the image.
- * @param weightedFunction The weighted function used in the fill process.
+ * @brief Write the given image to the given path, if there is one.
+ * @param cvImage The image to write, represented as a CV Mat object.
+ * @param outputPath The path of the image, nullptr to write nothing.
+ * @return 0 if the image was written or there is no path.
  */
-static void neighboursFillImageHole(float ***image, const Hole &hole,
-                                    float (*weightedFunction)(const Pixel&, const Pixel&))
+static int writeImage(const cv::Mat &cvImage, const char *outputPath)
 {
-    for (const Pixel &x : hole.getHolePixels())
+    INSTRUMENT_SCOPE("writeImage");
+    if (outputPath != nullptr && !cv::imwrite(outputPath, cvImage))
     {
-        // For every pixel x in the hole we update it's value using the
-        // weighted function and all the pixels in the hole boundary.
-        float numerator = 0;
-        float denominator = 0;
-
-        assert(!x.getNeighbours().empty());
-        for (const Pixel &y : x.getNeighbours())
-        {
-            float yValue = (*image)[y.getX()][y.getY()];
-            if (yValue == MISSING_VALUE)
-            {
-                continue;
-            }
-
-            float weightedValue = weightedFunction(x, y);
-            numerator += weightedValue * yValue;
-            denominator += weightedValue;
-        }
-        assert(denominator != 0);
-        float newValue = numerator / denominator;
-        (*image)[x.getX()][x.getY()] = newValue;
+        // Invalid output argument.
+        std::cerr << "Error: can't write the filled image " << outputPath << std::endl;
+        exit(EXIT_FAILURE);
     }
+    return EXIT_SUCCESS;
 }
 
-/*-----=  Image Handling Functions  =-----*/
-
-
 /**
- * @brief Receive an image from the given image path.
- * @param imagePath The path of the image.
- * @return A Mat object normalized to the range [0,1] of the image.
+ * @brief Copy the given image into a single contiguous buffer.
+ * @param cvImage The image to copy, represented as a CV Mat object.
+ * @return The copy of the image.
  */
-static cv::Mat receiveImage(const char *imagePath)
+static cv::Mat copyImage(const cv::Mat &cvImage)
 {
-    cv::Mat image = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
-    if (image.empty())
-    {
-        // Invalid image argument.
-        std::cerr << "Error: invalid image" << std::endl;
-        exit(EXIT_FAILURE);
-    }
-    // Normalize image to the values in [0,1] range.
-    image.convertTo(image, CV_32F);
-    image = image / NORMALIZATION_FACTOR;
-    return image;
+    INSTRUMENT_SCOPE("copyImage");
+    INSTRUMENT_COUNT("bytes allocated", cvImage.total() * cvImage.elemSize());
+    return cvImage.clone();
 }
 
 /**
- * @brief Convert a given CV Mat image representation to a 2D-array.
- * @param cvImage The given image to convert, represented as a CV Mat object with
- *                values in the range [0,1].
- * @param rows The number of rows in the image.
- * @param cols The number of columns in the image.
- * @return A 2D-array of type float representing the image.
+ * @brief Wrap a given CV Mat image representation with an Image, without copying its data.
+ *        The CV Mat object must outlive the returned Image.
+ * @tparam T The type of the pixel values, float for CV_32F or unsigned char for CV_8U.
+ * @param cvImage The given image to wrap, represented as a single channel CV Mat object.
+ * @return An Image which refers to the data of the given CV Mat object.
  */
-static float **convertImageToArray(cv::Mat &cvImage, const int rows, const int cols)
+template <typename T>
+static BasicImage<T> wrapImage(cv::Mat &cvImage)
 {
-    auto **image = new float *[rows];
-    for (int i = 0; i < rows; ++i)
-    {
-        image[i] = new float[cols];
-        auto *cvP = cvImage.ptr<float>(i);
-        for (int j = 0; j < cols; ++j)
-        {
-            image[i][j] = cvP[j];
-        }
-    }
+    assert(cvImage.channels() == 1 && cvImage.elemSize1() == sizeof(T));
+    return BasicImage<T>(cvImage.ptr<T>(), cvImage.rows, cvImage.cols, cvImage.step1());
+}
 
-    return image;
+/**
+ * @brief Wrap a given 8-bit CV Mat image representation of interleaved channels with a
+ *        ByteColorImage, without copying its data. The CV Mat object must outlive the returned
+ *        image.
+ * @param cvImage The given image to wrap, represented as a CV_8UC3 (or CV_8UC4) Mat object.
+ * @return A ByteColorImage which refers to the data of the given CV Mat object.
+ */
+static ByteColorImage wrapColorImage(cv::Mat &cvImage)
+{
+    assert(cvImage.channels() <= MAX_CHANNELS && cvImage.elemSize1() == sizeof(unsigned char));
+    return ByteColorImage(cvImage.ptr<unsigned char>(), cvImage.rows, cvImage.cols,
+                          cvImage.channels(), cvImage.step1());
 }
 
 /**
- * @brief Convert a given 2D-array to a CV Mat image representation.
- * @param image The given image to convert, represented as a 2D-array with
- *        values in the range [0,1].
- * @param rows The number of rows in the image.
- * @param cols The number of columns in the image.
- * @return A CV Mat of type float representing the image.
+ * @brief Mark the image hole boundaries of the given image.
+ * @tparam T The type of the pixel values of the image.
+ * @param image The image to mark.
+ * @param hole The hole in the image.
+ * @param markColor The value of the marked pixels.
  */
-static cv::Mat convertArrayToImage(float **image, const int rows, const int cols)
+template <typename T>
+static void markBoundaries(BasicImage<T> &image, const Hole &hole, const T markColor)
 {
-    cv::Mat cvImage(rows, cols, CV_32F);
-    for (int i = 0; i < rows; ++i)
+    INSTRUMENT_SCOPE("markBoundaries");
+    for (const Pixel &x : hole.getHoleBoundary())
     {
-        for (int j = 0; j < cols; ++j)
-        {
-            cvImage.at<float>(i, j) = image[i][j];
-        }
+        image.at(x) = markColor;
     }
-    return cvImage;
 }
 
 /**
- * @brief Mark the image hole boundaries of the given image.
- * @param image A pointer to the image to mark.
+ * @brief Mark the image hole boundaries in all the channels of the given color image.
+ * @param image The image to mark.
  * @param hole The hole in the image.
+ * @param markColor The value of the channels of the marked pixels.
  */
-static void markBoundaries(float ***image, const Hole &hole, const float markColor)
+static void markBoundaries(ByteColorImage &image, const Hole &hole, const unsigned char markColor)
 {
+    INSTRUMENT_SCOPE("markBoundaries");
     for (const Pixel &x : hole.getHoleBoundary())
     {
-        (*image)[x.getX()][x.getY()] = markColor;
+        std::fill(image.at(x), image.at(x) + image.getChannels(), markColor);
     }
 }
 
@@ -462,112 +1058,454 @@ static void displayImage(const cv::Mat &image, const char *windowName)
 static void displayResults(const cv::Mat &originalImage, const cv::Mat &markedImage,
                            const cv::Mat &filledImage)
 {
+    INSTRUMENT_SCOPE("display");
     displayImage(originalImage, "Original");
     displayImage(markedImage, "Boundary");
     displayImage(filledImage, "Filled");
 }
 
 
-/*-----=  Generate Hole Functions  =-----*/
+/*-----=  Batch Functions  =-----*/
+
+
+/**
+ * @brief A single image of the batch, which moves through the stages of the batch pipeline.
+ */
+struct BatchJob
+{
+    size_t line = 0;  // The line of the image in the manifest.
+    std::string imagePath;  // The path of the image.
+    std::string maskPath;  // The path of the mask of the missing pixels.
+    std::string outputPath;  // The path of the filled image.
+    FillConfig config;  // The parameters of the fill of the image.
+    cv::Mat image;  // The decoded image, filled in place.
+    cv::Mat mask;  // The decoded mask, released once the holes are found.
+    std::vector<Hole> holes;  // The holes in the image.
+};
+
+/**
+ * @brief A Type Definition for a queue of the batch jobs between two stages.
+ */
+typedef BoundedQueue<std::unique_ptr<BatchJob>> BatchQueue;
+
+/**
+ * @brief Read the batch manifest from the given path. Every line of the manifest is an image
+ *        path, a mask path, an epsilon value, a z value, a pixel connectivity value and an
+ *        output path, separated by white spaces. Empty lines and lines which start with
+ *        MANIFEST_COMMENT are skipped. The program exits with an error on an invalid line.
+ * @param manifestPath The path of the manifest.
+ * @param config The parameters of the fill, except the values given by the manifest.
+ * @return The jobs of the manifest, by their order in the manifest.
+ */
+static std::vector<std::unique_ptr<BatchJob>> readManifest(const char *manifestPath,
+                                                           const FillConfig &config)
+{
+    std::ifstream manifest(manifestPath);
+    if (!manifest)
+    {
+        // Invalid manifest argument.
+        std::cerr << "Error: can't read the manifest " << manifestPath << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::vector<std::unique_ptr<BatchJob>> jobs;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(manifest, line); ++lineNumber)
+    {
+        std::istringstream fields(line);
+        std::string imagePath;
+        if (!(fields >> imagePath) || imagePath[0] == MANIFEST_COMMENT)
+        {
+            continue;
+        }
+        std::unique_ptr<BatchJob> job(new BatchJob());
+        std::string epsilon;
+        std::string z;
+        std::string connectivity;
+        std::string extra;
+        if (!(fields >> job->maskPath >> epsilon >> z >> connectivity >> job->outputPath) ||
+            (fields >> extra) || validateNumeric(epsilon.c_str()) || validateNumeric(z.c_str()) ||
+            (connectivity != "4" && connectivity != "8"))
+        {
+            // Invalid manifest line.
+            std::cerr << "Error: invalid manifest line " << lineNumber << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        job->line = lineNumber;
+        job->imagePath = imagePath;
+        job->config = config;
+        job->config.epsilon = std::stof(epsilon);
+        job->config.z = std::stof(z);
+        job->config.connectivity = std::stoi(connectivity);
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+/**
+ * @brief Decode the image of the given job and its mask.
+ * @param job The job of the image.
+ * @param color Whether to decode all the channels of the image, or only its gray levels.
+ * @return true if the image and the mask were read and they are of the same size, false
+ *         otherwise.
+ */
+static bool decodeJob(BatchJob &job, const bool color)
+{
+    INSTRUMENT_SCOPE("decode");
+    job.image = cv::imread(job.imagePath, color ? cv::IMREAD_COLOR : cv::IMREAD_GRAYSCALE);
+    job.mask = cv::imread(job.maskPath, cv::IMREAD_GRAYSCALE);
+    return !job.image.empty() && !job.mask.empty() && job.image.rows == job.mask.rows &&
+           job.image.cols == job.mask.cols;
+}
+
+/**
+ * @brief Encode the filled image of the given job to its output path.
+ * @param job The job of the image.
+ * @return true if the image was written, false otherwise.
+ */
+static bool encodeJob(const BatchJob &job)
+{
+    INSTRUMENT_SCOPE("encode");
+    return cv::imwrite(job.outputPath, job.image);
+}
 
+/**
+ * @brief Report an error of a single image of the batch, without stopping the batch. The
+ *        stages run in different threads, so the reports are serialized.
+ * @param job The job of the image.
+ * @param message The error message.
+ */
+static void reportBatchError(const BatchJob &job, const std::string &message)
+{
+    static std::mutex reportMutex;
+    std::lock_guard<std::mutex> lock(reportMutex);
+    std::cerr << "Error: " << message << " (manifest line " << job.line << ")" << std::endl;
+}
 
 /**
- * @brief Generates a random number from the range [lowerBound,upperBound].
- * @param lowerBoundRow The lower bound of the range.
- * @param upperBoundRow The upper bound of the range.
- * @return a random integer from the range [lowerBound,upperBound].
+ * @brief The decode stage of the batch, which reads every image and its mask.
+ * @param jobs The jobs of the manifest.
+ * @param output The queue to the detection stage, closed once all the images are read.
+ * @param failedCount Incremented for every image which can't be read.
+ * @param color Whether to decode all the channels of the images.
  */
-static int generateRandomNumber(const int lowerBound, const int upperBound)
+static void decodeBatch(std::vector<std::unique_ptr<BatchJob>> &jobs, BatchQueue &output,
+                        std::atomic<size_t> &failedCount, const bool color)
 {
-    std::random_device                  rand_dev;
-    std::mt19937                        generator(rand_dev());
-    std::uniform_int_distribution<int>  dist(lowerBound, upperBound);
-    return dist(generator);
+    for (std::unique_ptr<BatchJob> &job : jobs)
+    {
+        if (!decodeJob(*job, color))
+        {
+            reportBatchError(*job, "invalid image or mask " + job->imagePath);
+            ++failedCount;
+            continue;
+        }
+        output.push(std::move(job));
+    }
+    output.close();
 }
 
 /**
- * @brief Generates random hole in a shape of a rectangle.
- * @param image The image to corrupt.
- * @param rows The number of rows in the image.
- * @param cols The number of columns in the image.
+ * @brief The detection stage of the batch, which finds the holes of every image in its mask.
+ * @param input The queue from the decode stage.
+ * @param output The queue to the fill stage, closed once the input is done.
+ */
+static void detectBatch(BatchQueue &input, BatchQueue &output)
+{
+    std::unique_ptr<BatchJob> job;
+    while (input.pop(job))
+    {
+        const ByteImage maskImage = wrapImage<unsigned char>(job->mask);
+        job->holes = findHoles(HoleMask::fromMaskImage(maskImage), job->config.connectivity);
+        job->mask.release();
+        output.push(std::move(job));
+    }
+    output.close();
+}
+
+/**
+ * @brief The fill stage of the batch, which fills the holes of every image in place in its
+ *        native 8-bit values, all the channels of a color image at once. The buffers of the
+ *        filler are reused by all the images.
+ * @param input The queue from the detection stage.
+ * @param output The queue to the encode stage, closed once the input is done.
+ * @param filler The filler of the images.
  */
-static void generateRandomHole(float ***image, const int rows, const int cols)
+static void fillBatch(BatchQueue &input, BatchQueue &output, HoleFiller &filler)
 {
-    // Pick a random indices in the image.
-    const int randomRow1 = generateRandomNumber(INITIAL_ROW, rows - 1);
-    const int randomCol1 = generateRandomNumber(INITIAL_ROW, cols - 1);
-    const int randomRow2 = generateRandomNumber(INITIAL_ROW, rows - 1);
-    const int randomCol2 = generateRandomNumber(INITIAL_ROW, cols - 1);
-    // Set top left and bottom right points.
-    const int topLeftRow = (randomRow1 < randomRow2) ? randomRow1 : randomRow2;
-    const int topLeftCol = (randomCol1 < randomCol2) ? randomCol1 : randomCol2;
-    const int bottomRightRow = (randomRow1 < randomRow2) ? randomRow2 : randomRow1;
-    const int bottomRightCol = (randomCol1 < randomCol2) ? randomCol2 : randomCol1;
-    // Corrupt the image.
-    for (int currentRow = topLeftRow; currentRow <= bottomRightRow; ++currentRow)
+    std::unique_ptr<BatchJob> job;
+    while (input.pop(job))
     {
-        for (int currentCol = topLeftCol; currentCol <= bottomRightCol; ++currentCol)
+        filler.setConfig(job->config);
+        if (job->image.channels() == 1)
+        {
+            ByteImage image = wrapImage<unsigned char>(job->image);
+            filler.fillHoles(image, job->holes);
+        }
+        else
         {
-            (*image)[currentRow][currentCol] = MISSING_VALUE;
+            ByteColorImage image = wrapColorImage(job->image);
+            filler.fillHoles(image, job->holes);
         }
+        job->holes.clear();
+        output.push(std::move(job));
     }
+    output.close();
 }
 
 /**
- * @brief Generate hole in the image from a given array of pixels.
- * @param image The image to corrupt.
- * @param holePixels The array of pixels which describe the hole.
- * @param holeSize The number of pixels in the hole.
+ * @brief The encode stage of the batch, which writes every filled image to its output path.
+ * @param input The queue from the fill stage.
+ * @param filledCount Incremented for every image which is written.
+ * @param failedCount Incremented for every image which can't be written.
  */
-static void generateDefinedHole(float ***image, const Pixel *holePixels, const int holeSize)
+static void encodeBatch(BatchQueue &input, std::atomic<size_t> &filledCount,
+                        std::atomic<size_t> &failedCount)
 {
-    for (int i = 0; i < holeSize; ++i)
+    std::unique_ptr<BatchJob> job;
+    while (input.pop(job))
     {
-        Pixel pixel = holePixels[i];
-        (*image)[pixel.getX()][pixel.getY()] = MISSING_VALUE;
+        if (!encodeJob(*job))
+        {
+            reportBatchError(*job, "can't write the filled image " + job->outputPath);
+            ++failedCount;
+        }
+        else
+        {
+            ++filledCount;
+        }
+        job.reset();
     }
 }
 
+/**
+ * @brief Fill the images of the batch without display. The images move through a pipeline of
+ *        decode, hole detection, fill and encode stages, where every stage runs in its own
+ *        thread and the stages are connected by bounded queues, so the decoding and encoding
+ *        of the images overlap their fills, and at most a few images are in memory at once.
+ *        An image which can't be read or written is reported and skipped.
+ * @param jobs The jobs of the manifest.
+ * @param options The program parameters.
+ * @return 0 if all the images were filled, 1 otherwise.
+ */
+static int runBatch(std::vector<std::unique_ptr<BatchJob>> jobs, const ProgramOptions &options)
+{
+    BatchQueue decodedJobs(BATCH_QUEUE_CAPACITY);
+    BatchQueue detectedJobs(BATCH_QUEUE_CAPACITY);
+    BatchQueue filledJobs(BATCH_QUEUE_CAPACITY);
+    std::atomic<size_t> filledCount(0);
+    std::atomic<size_t> failedCount(0);
+    HoleFiller filler(options.config, options.threadCount);
+
+    std::thread decodeThread(decodeBatch, std::ref(jobs), std::ref(decodedJobs),
+                             std::ref(failedCount), options.color);
+    std::thread detectThread(detectBatch, std::ref(decodedJobs), std::ref(detectedJobs));
+    std::thread encodeThread(encodeBatch, std::ref(filledJobs), std::ref(filledCount),
+                             std::ref(failedCount));
+    fillBatch(detectedJobs, filledJobs, filler);
+    decodeThread.join();
+    detectThread.join();
+    encodeThread.join();
+
+    std::cout << "Batch: " << filledCount << " images filled, " << failedCount << " failed"
+              << std::endl;
+    return (failedCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 
-/*-----=  Resources Functions  =-----*/
+/*-----=  Program Flow Functions  =-----*/
 
 
 /**
- * @brief Copy a given image.
- * @param image The image to copy.
- * @param rows The number of rows in that image.
- * @param cols The number of columns in that image.
- * @return
+ * @brief Generate the holes of the program in the given image, i.e. reproducible holes of the
+ *        shape of the options up to their coverage if requested, and the example hole
+ *        otherwise.
+ * @param image The image to generate the holes in.
+ * @param options The program parameters.
  */
-static float **copyImage(float **image, const int rows, const int cols)
+static void generateImageHoles(Image &image, const ProgramOptions &options)
 {
-    auto **copiedImage = new float *[rows];
-    for (int i = 0; i < rows; ++i)
+    if (options.generateHoles)
     {
-        copiedImage[i] = new float[cols];
-        for (int j = 0; j < cols; ++j)
+        // Generate reproducible holes of the given shape up to the given coverage.
+        HoleGenerator(options.seed).generateHoles(image, options.holeShape, options.holeSize,
+                                                  options.holeCoverage);
+    }
+    else
+    {
+        // Generate hole in this image.
+        // HoleGenerator(std::random_device()()).generateRandomHole(image);
+        // THIS IS MERELY AN EXAMPLE, COMMENT THIS IF NOT NEEDED.
+        Pixel pixelArray[20] = PIXEL_ARRAY_EXAMPLE;
+        HoleGenerator::generateDefinedHole(image, pixelArray, 20);
+    }
+}
+
+/**
+ * @brief Find the holes of the given color image, which are shared by all its channels. The
+ *        missing pixels are given by the mask of the options, or they are generated into a
+ *        plane of the size of the image (see generateImageHoles) and cleared in all the
+ *        channels of the image, as the generated missing pixels of a gray level image are.
+ * @param cvImage The color image, represented as a CV Mat object.
+ * @param options The program parameters.
+ * @return The holes in the image.
+ */
+static std::vector<Hole> findColorHoles(cv::Mat &cvImage, const ProgramOptions &options)
+{
+    if (options.maskPath != nullptr)
+    {
+        const HoleMask mask = receiveMask(options.maskPath, cvImage.rows, cvImage.cols);
+        return findHoles(mask, options.config.connectivity);
+    }
+    Image plane(cvImage.rows, cvImage.cols);
+    generateImageHoles(plane, options);
+    const std::vector<Hole> holes = findHoles(plane, options.config.connectivity);
+    ByteColorImage image = wrapColorImage(cvImage);
+    for (const Hole &hole : holes)
+    {
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
         {
-            copiedImage[i][j] = image[i][j];
-            copiedImage[i][j] = image[i][j];
-        }
+            std::fill(image.at(x), image.at(x) + image.getChannels(), 0);
+        });
+    }
+    return holes;
+}
+
+/**
+ * @brief Fill the holes of all the channels of the given color image in place, in a single
+ *        pass over the pairs of every hole, and report the fill memory if requested.
+ * @param cvImage The image to fill, represented as a CV Mat object.
+ * @param holes The holes in the image.
+ * @param options The program parameters.
+ */
+static void fillColorImage(cv::Mat &cvImage, const std::vector<Hole> &holes,
+                           const ProgramOptions &options)
+{
+    if (holes.empty())
+    {
+        throw NoMissingPixelException();
+    }
+    ByteColorImage image = wrapColorImage(cvImage);
+    HoleFiller filler(options.config, options.threadCount);
+    filler.fillHoles(image, holes);
+    if (options.reportMemory)
+    {
+        std::cout << "Fill scratch memory: " << filler.getScratchSize() << " bytes" << std::endl;
+    }
+}
+
+/**
+ * @brief Fill a copy of the given color image, and display the results of the program.
+ * @param cvImage The image with the holes in it, represented as a CV Mat object.
+ * @param holes The holes in the image.
+ * @param options The program parameters.
+ * @return 0 if the program ended successfully.
+ */
+static int fillColorHolesAndDisplay(cv::Mat &cvImage, const std::vector<Hole> &holes,
+                                    const ProgramOptions &options)
+{
+    // Copy the original image and mark the boundaries in all the channels.
+    cv::Mat cvMarked = copyImage(cvImage);
+    ByteColorImage markedImage = wrapColorImage(cvMarked);
+    for (const Hole &hole : holes)
+    {
+        markBoundaries(markedImage, hole, DEFAULT_MARK_COLOR * NORMALIZATION_FACTOR);
+    }
+
+    // Copy the original image and fill the copy.
+    cv::Mat cvFilled = copyImage(cvImage);
+    fillColorImage(cvFilled, holes, options);
+
+    // Display results.
+    displayResults(cvImage, cvMarked, cvFilled);
+
+    // Clear resources.
+    cvImage.release();
+    cvMarked.release();
+    cvFilled.release();
+    cv::destroyAllWindows();
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Fill the holes of the given image in place, and report the fill if requested. The
+ *        error against the direct exact fill is computed on a copy of the image, which is made
+ *        only if the error is reported.
+ * @tparam T The type of the pixel values, float for CV_32F or unsigned char for CV_8U.
+ * @param cvImage The image to fill, represented as a CV Mat object.
+ * @param holes The holes in the image.
+ * @param options The program parameters.
+ */
+template <typename T>
+static void fillImage(cv::Mat &cvImage, const std::vector<Hole> &holes,
+                      const ProgramOptions &options)
+{
+    if (holes.empty())
+    {
+        throw NoMissingPixelException();
+    }
+    const bool reportError = options.reportError &&
+                             (options.config.strategy != EXACT_FILL ||
+                              options.config.convolution != NEVER_CONVOLUTION);
+    cv::Mat cvExact;
+    if (reportError)
+    {
+        cvExact = copyImage(cvImage);
+    }
+    BasicImage<T> image = wrapImage<T>(cvImage);
+    HoleFiller filler(options.config, options.threadCount);
+    filler.fillHoles(image, holes);
+    if (options.reportMemory)
+    {
+        std::cout << "Fill scratch memory: " << filler.getScratchSize() << " bytes" << std::endl;
+    }
+    if (reportError)
+    {
+        // Compare the fill against the direct exact fill of the copy.
+        BasicImage<T> exactImage = wrapImage<T>(cvExact);
+        FillConfig exactConfig = options.config;
+        exactConfig.strategy = EXACT_FILL;
+        exactConfig.convolution = NEVER_CONVOLUTION;
+        filler.setConfig(exactConfig);
+        filler.fillHoles(exactImage, holes);
+        reportFillError(image, exactImage, holes);
     }
-    return copiedImage;
 }
 
 /**
- * @brief Clear memory allocation for the given image.
- * @param image The image memory to free.
- * @param rows The number of rows in that image.
+ * @brief Fill a copy of the given image, report the fill if requested, and display the
+ *        results of the program.
+ * @tparam T The type of the pixel values, float for CV_32F or unsigned char for CV_8U.
+ * @param cvImage The image with the holes in it, represented as a CV Mat object.
+ * @param holes The holes in the image.
+ * @param options The program parameters.
+ * @param markColor The value of the marked boundary pixels.
+ * @return 0 if the program ended successfully.
  */
-static void clearResources(float ***image, const int rows)
+template <typename T>
+static int fillHolesAndDisplay(cv::Mat &cvImage, const std::vector<Hole> &holes,
+                               const ProgramOptions &options, const T markColor)
 {
-    for (int i = 0; i < rows; ++i)
+    // Copy the original image and mark the boundaries.
+    cv::Mat cvMarked = copyImage(cvImage);
+    BasicImage<T> markedImage = wrapImage<T>(cvMarked);
+    for (const Hole &hole : holes)
     {
-        delete[] (*image)[i];
-        (*image)[i] = nullptr;
+        markBoundaries(markedImage, hole, markColor);
     }
-    delete[] *image;
-    *image = nullptr;
+
+    // Copy the original image and fill the copy.
+    cv::Mat cvFilled = copyImage(cvImage);
+    fillImage<T>(cvFilled, holes, options);
+
+    // Display results.
+    displayResults(cvImage, cvMarked, cvFilled);
+
+    // Clear resources.
+    cvImage.release();
+    cvMarked.release();
+    cvFilled.release();
+    cv::destroyAllWindows();
+    return EXIT_SUCCESS;
 }
 
 
@@ -583,11 +1521,26 @@ static void clearResources(float ***image, const int rows)
  */
 int main(int argc, char *argv[])
 {
+    if (argc >= BATCH_ARGUMENT_COUNT && std::string(argv[1]) == BATCH_OPTION)
+    {
+        // Fill the images of the manifest, the options apply to all of them.
+        ProgramOptions options;
+        parseOptions(argc, argv, BATCH_ARGUMENT_COUNT, options);
+        if (options.tiledRows != 0 || options.maskPath != nullptr || options.generateHoles)
+        {
+            // The images and their masks are given by the manifest.
+            std::cerr << "Error: the batch mode doesn't support --tiled, --mask or --holes"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        return runBatch(readManifest(argv[MANIFEST_ARG_INDEX], options.config), options);
+    }
+
     // Handle program arguments.
-    if (argc != VALID_ARGUMENT_COUNT)
+    if (argc < VALID_ARGUMENT_COUNT)
     {
         // Invalid number of arguments.
-        std::cerr << "Usage: HoleFilling <image_path> <epsilon> <z>" << std::endl;
+        std::cerr << USAGE_MESSAGE << std::endl;
         exit(EXIT_FAILURE);
     }
     const char *imagePath = argv[IMAGE_PATH_ARG_INDEX];
@@ -595,57 +1548,88 @@ int main(int argc, char *argv[])
     const char *zArgument = argv[Z_ARG_INDEX];
     const char *connectivityArgument = argv[CONNECTIVITY_ARG_INDEX];
     validateNumericArguments(epsilonArgument, zArgument, connectivityArgument);
-    epsilon = std::stof(epsilonArgument);
-    z = std::stof(zArgument);
-    assert(epsilon != EPSILON_INITIAL && z != Z_INITIAL);
-    const int connectivity = std::stoi(connectivityArgument);
-
-    // Read the given image and set up data.
-    cv::Mat originalImage = receiveImage(imagePath);
-    int rows = originalImage.rows;
-    int cols = originalImage.cols;
-
-    // Create a corresponding 2D-array of the image.
-    float **image = convertImageToArray(originalImage, rows, cols);
-
-    // Generate hole in this image.
-    // generateRandomHole(&image, rows, cols);
-    // THIS IS MERELY AN EXAMPLE, COMMENT THIS IF NOT NEEDED.
-    Pixel pixelArray[20] = PIXEL_ARRAY_EXAMPLE;
-    generateDefinedHole(&image, pixelArray, 20);
-    cv::Mat cvImage = convertArrayToImage(image, rows, cols);
+    ProgramOptions options;
+    options.config.epsilon = std::stof(epsilonArgument);
+    options.config.z = std::stof(zArgument);
+    options.config.connectivity = std::stoi(connectivityArgument);
+    parseOptions(argc, argv, VALID_ARGUMENT_COUNT, options);
 
-    try
+    if (options.tiledRows != 0)
     {
-        // Find the first missing pixel in the hole.
-        Pixel missingPixel = findMissingPixel(image, rows, cols);
-        // From this pixel calculate the hole using BFS.
-        Hole hole = calculateHole(image, rows, cols, missingPixel, connectivity);
-
-        // Copy the original image and mark the boundaries.
-        auto **markedImage = copyImage(image, rows, cols);
-        markBoundaries(&markedImage, hole, DEFAULT_MARK_COLOR);
-        cv::Mat cvMarked = convertArrayToImage(markedImage, rows, cols);
-
-        // Copy the original image and fill the copy.
-        auto **filledImage = copyImage(image, rows, cols);
-        fillImageHole(&filledImage, hole, defaultWeightedFunction);
-        cv::Mat cvFilled = convertArrayToImage(filledImage, rows, cols);
-
-        // Display results.
-        displayResults(cvImage, cvMarked, cvFilled);
-
-        // Clear resources.
-        clearResources(&filledImage, rows);
-        clearResources(&markedImage, rows);
-        clearResources(&image, rows);
-        originalImage.release();
-        cvImage.release();
-        cvMarked.release();
-        cvFilled.release();
-        cv::destroyAllWindows();
+        // Fill a copy of the raw image tile by tile, without reading the image into memory.
+        // An output path of the raw image itself, by any path, fills the raw image in place.
+        if (!MappedImage::isSameFile(imagePath, options.outputPath) &&
+            !MappedImage::copyFile(imagePath, options.outputPath))
+        {
+            std::cerr << "Error: can't copy the raw image to " << options.outputPath << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        try
+        {
+            MappedImage mappedImage(options.outputPath, options.tiledRows, options.tiledCols);
+            HoleFiller filler(options.config, options.threadCount);
+            filler.fillTiled(mappedImage, options.tileSize, options.halo);
+        }
+        catch (HoleException& exception)
+        {
+            // The raw image is invalid or it can't be mapped.
+            std::cerr << "Error: " << exception.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
         return EXIT_SUCCESS;
     }
+
+    try
+    {
+        if (options.color)
+        {
+            // Fill all the channels of the native 8-bit image at once, with the same holes.
+            cv::Mat cvImage = receiveImage(imagePath, true);
+            const std::vector<Hole> holes = findColorHoles(cvImage, options);
+            if (options.headless)
+            {
+                fillColorImage(cvImage, holes, options);
+                return writeImage(cvImage, options.outputPath);
+            }
+            return fillColorHolesAndDisplay(cvImage, holes, options);
+        }
+
+        if (options.maskPath != nullptr)
+        {
+            // Fill the native 8-bit image, the missing pixels are given by the mask.
+            cv::Mat cvImage = receiveImage(imagePath, false);
+            const HoleMask mask = receiveMask(options.maskPath, cvImage.rows, cvImage.cols);
+            const std::vector<Hole> holes = findHoles(mask, options.config.connectivity);
+            if (options.headless)
+            {
+                // Fill the decoded image in place and write it as it is.
+                fillImage<unsigned char>(cvImage, holes, options);
+                return writeImage(cvImage, options.outputPath);
+            }
+            return fillHolesAndDisplay<unsigned char>(cvImage, holes, options,
+                                                      DEFAULT_MARK_COLOR * NORMALIZATION_FACTOR);
+        }
+
+        // Read the given image and normalize it, the normalized image is modified in place.
+        cv::Mat cvBytes = receiveImage(imagePath, false);
+        cv::Mat cvImage = normalizeImage(cvBytes);
+        Image image = wrapImage<float>(cvImage);
+        generateImageHoles(image, options);
+
+        // Find all the holes in the image and their boundaries.
+        const std::vector<Hole> holes = findHoles(image, options.config.connectivity);
+        if (options.headless)
+        {
+            // Fill in place, and write the filled pixels back into the decoded image, whose
+            // other pixels are the pixels of the normalized image.
+            fillImage<float>(cvImage, holes, options);
+            ByteImage byteImage = wrapImage<unsigned char>(cvBytes);
+            storeFilledPixels(image, holes, byteImage);
+            return writeImage(cvBytes, options.outputPath);
+        }
+        cvBytes.release();
+        return fillHolesAndDisplay<float>(cvImage, holes, options, DEFAULT_MARK_COLOR);
+    }
     catch (HoleException& exception)
     {
         std::cout << exception.what() << std::endl;
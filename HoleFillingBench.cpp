@@ -0,0 +1,471 @@
+/**
+ * @file HoleFillingBench.cpp
+ * @author Itai Tagar
+ *
+ * @brief The benchmark of the hole detection and of the fill strategies, on synthetic images
+ *        and holes of a range of sizes and shapes.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <sys/resource.h>
+#include "Pixel.h"
+#include "Image.h"
+#include "ColorImage.h"
+#include "Hole.h"
+#include "HoleExtractor.h"
+#include "HoleFiller.h"
+#include "HoleGenerator.h"
+#include "FillConfig.h"
+#include "IncrementalFill.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def USAGE_MESSAGE "Usage: HoleFillingBench [options]"
+ * @brief A Macro that sets the usage message of the benchmark.
+ */
+#define USAGE_MESSAGE "Usage: HoleFillingBench [--seed <seed>] [--threads <count>] " \
+                      "[--min-time <seconds>] [--max-hole <size>] [--z <value>]"
+
+/**
+ * @def SEED_OPTION "--seed"
+ * @brief A Macro that sets the option of the seed of the hole generator.
+ */
+#define SEED_OPTION "--seed"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option of the number of threads used in the fills.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def MIN_TIME_OPTION "--min-time"
+ * @brief A Macro that sets the option of the minimal measured time of a benchmark.
+ */
+#define MIN_TIME_OPTION "--min-time"
+
+/**
+ * @def MAX_HOLE_OPTION "--max-hole"
+ * @brief A Macro that sets the option of the largest hole size.
+ */
+#define MAX_HOLE_OPTION "--max-hole"
+
+/**
+ * @def Z_OPTION "--z"
+ * @brief A Macro that sets the option of the z value of the weighted function.
+ */
+#define Z_OPTION "--z"
+
+/**
+ * @def DEFAULT_SEED 1
+ * @brief A Macro that sets the default seed of the hole generator.
+ */
+#define DEFAULT_SEED 1
+
+/**
+ * @def DEFAULT_MIN_TIME 0.2
+ * @brief A Macro that sets the default minimal measured time of a benchmark, in seconds.
+ */
+#define DEFAULT_MIN_TIME 0.2
+
+/**
+ * @def DEFAULT_MAX_HOLE 128
+ * @brief A Macro that sets the default largest hole size, in rows and columns.
+ */
+#define DEFAULT_MAX_HOLE 128
+
+/**
+ * @def MIN_HOLE 16
+ * @brief A Macro that sets the smallest hole size, the sizes are doubled up to the largest.
+ */
+#define MIN_HOLE 16
+
+/**
+ * @def IMAGE_TO_HOLE_RATIO 4
+ * @brief A Macro that sets the ratio of the image size to the hole size.
+ */
+#define IMAGE_TO_HOLE_RATIO 4
+
+/**
+ * @def BRUSH_TO_HOLE_RATIO 4
+ * @brief A Macro that sets the ratio of the hole size to the maximal width of the brush strokes.
+ */
+#define BRUSH_TO_HOLE_RATIO 4
+
+/**
+ * @def STROKE_SIZE 16
+ * @brief A Macro that sets the number of pixels painted by a stroke of the incremental fill.
+ */
+#define STROKE_SIZE 16
+
+/**
+ * @def BENCH_EPSILON 0.01f
+ * @brief A Macro that sets the epsilon value of the weighted function.
+ */
+#define BENCH_EPSILON 0.01f
+
+/**
+ * @def MICROSECONDS_PER_SECOND 1e6
+ * @brief A Macro that sets the number of microseconds in a second.
+ */
+#define MICROSECONDS_PER_SECOND 1e6
+
+/**
+ * @def NANOSECONDS_PER_SECOND 1e9
+ * @brief A Macro that sets the number of nanoseconds in a second.
+ */
+#define NANOSECONDS_PER_SECOND 1e9
+
+/**
+ * @def KILOBYTES_PER_MEGABYTE 1024.0
+ * @brief A Macro that sets the number of kilobytes in a megabyte.
+ */
+#define KILOBYTES_PER_MEGABYTE 1024.0
+
+/**
+ * @def COLOR_CHANNELS 3
+ * @brief A Macro that sets the number of channels of the image of the color fill benchmark.
+ */
+#define COLOR_CHANNELS 3
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The parameters of the benchmark.
+ */
+struct BenchOptions
+{
+    unsigned int seed = DEFAULT_SEED;  // The seed of the hole generator.
+    unsigned int threadCount = 0;  // The number of threads used in the fills.
+    double minTime = DEFAULT_MIN_TIME;  // The minimal measured time of a benchmark.
+    int maxHole = DEFAULT_MAX_HOLE;  // The largest hole size.
+    float z = DEFAULT_Z;  // The z value of the weighted function.
+};
+
+/**
+ * @brief A synthetic image with a single hole in it.
+ */
+struct BenchCase
+{
+    std::string shape;  // The shape of the hole.
+    Image original;  // The image with the hole in it.
+    Pixel missingPixel;  // A missing pixel of the hole.
+    size_t holeSize = 0;  // The number of pixels in the hole.
+    size_t boundarySize = 0;  // The number of pixels in the boundary of the hole.
+};
+
+
+/*-----=  Benchmark Functions  =-----*/
+
+
+/**
+ * @brief Creates an image of the given size with smooth values in [0,1].
+ * @param size The number of rows and columns in the image.
+ * @return The image.
+ */
+static Image createImage(const int size)
+{
+    Image image(size, size);
+    for (int x = INITIAL_ROW; x < size; ++x)
+    {
+        for (int y = INITIAL_COLUMN; y < size; ++y)
+        {
+            image.at(x, y) = 0.5f + 0.25f * std::sin(0.05f * x) + 0.25f * std::cos(0.03f * y);
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Creates the benchmark cases of the given hole size. Every case is an image of
+ *        IMAGE_TO_HOLE_RATIO times the hole size with a single hole at its centre: a square of
+ *        the hole size from generateDefinedHole, and a rectangle, an ellipse and a brush stroke
+ *        within a square of the hole size from generateRandomHole, generateEllipse and
+ *        generateBrushStroke.
+ * @param holeSize The number of rows and columns of the hole.
+ * @param generator The generator of the random holes.
+ * @return The benchmark cases.
+ */
+static std::vector<BenchCase> createCases(const int holeSize, HoleGenerator &generator)
+{
+    const int imageSize = IMAGE_TO_HOLE_RATIO * holeSize;
+    const int holeCorner = (imageSize - holeSize) / 2;
+    std::vector<BenchCase> cases(4);
+
+    cases[0].shape = "square";
+    cases[0].original = createImage(imageSize);
+    std::vector<Pixel> squarePixels;
+    for (int x = 0; x < holeSize; ++x)
+    {
+        for (int y = 0; y < holeSize; ++y)
+        {
+            squarePixels.emplace_back(holeCorner + x, holeCorner + y);
+        }
+    }
+    HoleGenerator::generateDefinedHole(cases[0].original, squarePixels.data(),
+                                       (int) squarePixels.size());
+
+    // The random holes are generated within a window of the hole size at the centre.
+    const std::pair<const char*, HoleShape> shapes[] = {
+            {"random", RECTANGLE_HOLE}, {"ellipse", ELLIPSE_HOLE}, {"brush", BRUSH_STROKE_HOLE}};
+    for (size_t i = 1; i < cases.size(); ++i)
+    {
+        const HoleShape shape = shapes[i - 1].second;
+        cases[i].shape = shapes[i - 1].first;
+        cases[i].original = createImage(imageSize);
+        Image window(cases[i].original.getRow(holeCorner) + holeCorner, holeSize, holeSize,
+                     (size_t) imageSize);
+        if (shape == RECTANGLE_HOLE)
+        {
+            generator.generateRandomHole(window);
+        }
+        else
+        {
+            generator.generateHole(window, shape, shape == BRUSH_STROKE_HOLE ?
+                                                  holeSize / BRUSH_TO_HOLE_RATIO : holeSize);
+        }
+    }
+
+    for (BenchCase &benchCase : cases)
+    {
+        HoleFiller filler((FillConfig()));
+        const std::vector<Hole> holes = filler.findHoles(benchCase.original);
+        benchCase.missingPixel = holes.front().getHolePixel(0);
+        benchCase.holeSize = holes.front().getHoleSize();
+        benchCase.boundarySize = holes.front().getHoleBoundary().size();
+    }
+    return cases;
+}
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ * @return The peak resident set size, in megabytes.
+ */
+static double getPeakMemory()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / KILOBYTES_PER_MEGABYTE;
+}
+
+/**
+ * @brief Runs a benchmark until its measured time is at least the given time. Only the run is
+ *        measured, the preparation of every repetition isn't.
+ * @tparam Prepare The type of the preparation of a repetition.
+ * @tparam Run The type of the measured run.
+ * @param prepare The preparation of a repetition.
+ * @param run The measured run.
+ * @param minTime The minimal measured time, in seconds.
+ * @param repetitions Set to the number of repetitions.
+ * @return The mean time of a repetition, in seconds.
+ */
+template <typename Prepare, typename Run>
+static double runBenchmark(const Prepare &prepare, const Run &run, const double minTime,
+                           size_t &repetitions)
+{
+    double totalTime = 0;
+    repetitions = 0;
+    do
+    {
+        prepare();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        totalTime += std::chrono::duration<double>(end - start).count();
+        ++repetitions;
+    } while (totalTime < minTime);
+    return totalTime / repetitions;
+}
+
+/**
+ * @brief Reports a benchmark as a single row of the results table.
+ * @param name The name of the benchmark.
+ * @param benchCase The benchmark case.
+ * @param pixelCount The number of pixels processed by a repetition.
+ * @param repetitions The number of repetitions.
+ * @param time The mean time of a repetition, in seconds.
+ */
+static void reportBenchmark(const std::string &name, const BenchCase &benchCase,
+                            const size_t pixelCount, const size_t repetitions, const double time)
+{
+    const double pairCount = (double) benchCase.holeSize * benchCase.boundarySize;
+    std::cout << std::left << std::setw(14) << name << std::setw(8) << benchCase.shape
+              << std::right << std::setw(7) << benchCase.original.getRows()
+              << std::setw(9) << benchCase.holeSize << std::setw(9) << benchCase.boundarySize
+              << std::setw(8) << repetitions << std::fixed << std::setprecision(3)
+              << std::setw(12) << time * MICROSECONDS_PER_SECOND << std::setw(12) << pixelCount / time / 1e6
+              << std::setw(10) << time * NANOSECONDS_PER_SECOND / pairCount
+              << std::setprecision(1) << std::setw(10) << getPeakMemory() << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+/**
+ * @brief Runs the benchmarks of the given case: the hole detection by calculateHole, and the
+ *        fill of the hole by every strategy, where the exact fill is the direct fill of every
+ *        pixel (fillImageHole or its vectorized kernel) without a convolution, the exact fill
+ *        of all the channels of a color image with the same values in every channel, and the
+ *        incremental fill of a stroke of boundary pixels which is painted and then erased.
+ * @param benchCase The benchmark case.
+ * @param options The parameters of the benchmark.
+ */
+static void runCase(const BenchCase &benchCase, const BenchOptions &options)
+{
+    size_t repetitions = 0;
+    HoleExtractor extractor(DEFAULT_CONNECTIVITY);
+    const double detectTime = runBenchmark([] {}, [&]
+    {
+        extractor.calculateHole(benchCase.original, benchCase.missingPixel);
+    }, options.minTime, repetitions);
+    reportBenchmark("calculateHole", benchCase, benchCase.holeSize + benchCase.boundarySize,
+                    repetitions, detectTime);
+
+    const std::pair<const char*, FillStrategy> strategies[] = {
+            {"exact", EXACT_FILL}, {"neighbours", NEIGHBOURS_FILL},
+            {"approximate", APPROXIMATE_FILL}, {"pyramid", PYRAMID_FILL}, {"auto", AUTO_FILL}};
+    FillConfig config;
+    config.epsilon = BENCH_EPSILON;
+    config.z = options.z;
+    config.convolution = NEVER_CONVOLUTION;
+    HoleFiller filler(config, options.threadCount);
+    const std::vector<Hole> holes = filler.findHoles(benchCase.original);
+    Image image = benchCase.original.clone();
+    for (const auto &strategy : strategies)
+    {
+        config.strategy = strategy.second;
+        filler.setConfig(config);
+        const double fillTime = runBenchmark([&]
+        {
+            // Restore the hole, which was filled by the previous repetition.
+            holes.front().forEachHolePixel([&](const size_t, const Pixel &x)
+            {
+                image.at(x) = MISSING_VALUE;
+            });
+        }, [&]
+        {
+            filler.fillHoles(image, holes);
+        }, options.minTime, repetitions);
+        reportBenchmark(strategy.first, benchCase, benchCase.holeSize, repetitions, fillTime);
+    }
+
+    ColorImage colorImage(image.getRows(), image.getCols(), COLOR_CHANNELS);
+    for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+    {
+        for (int y = INITIAL_COLUMN; y < image.getCols(); ++y)
+        {
+            std::fill(colorImage.at(x, y), colorImage.at(x, y) + COLOR_CHANNELS,
+                      benchCase.original.at(x, y));
+        }
+    }
+    config.strategy = EXACT_FILL;
+    filler.setConfig(config);
+    // The hole pixels of a color image are given by the holes, so they need no restoring.
+    const double colorTime = runBenchmark([] {}, [&]
+    {
+        filler.fillHoles(colorImage, holes);
+    }, options.minTime, repetitions);
+    reportBenchmark("exact-color", benchCase, benchCase.holeSize, repetitions, colorTime);
+
+    IncrementalFill incrementalFill(benchCase.original, config, options.threadCount);
+    const holeSet &boundary = holes.front().getHoleBoundary();
+    const std::vector<Pixel> stroke(boundary.begin(), boundary.begin() +
+                                    std::min(boundary.size(), (size_t) STROKE_SIZE));
+    const double strokeTime = runBenchmark([] {}, [&]
+    {
+        incrementalFill.addHolePixels(stroke);
+        incrementalFill.removeHolePixels(stroke);
+    }, options.minTime, repetitions);
+    reportBenchmark("incremental", benchCase, 2 * stroke.size(), repetitions, strokeTime);
+}
+
+
+/*-----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the benchmark, and reports for every benchmark the mean
+ *        time of a repetition, the processed pixels per second, the nanoseconds per pair of a
+ *        hole pixel and a boundary pixel, and the peak resident set size so far.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @return 0 if the benchmark ended successfully, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << USAGE_MESSAGE << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        try
+        {
+            if (option == SEED_OPTION)
+            {
+                options.seed = (unsigned int) std::stoul(argv[i + 1]);
+            }
+            else if (option == THREADS_OPTION)
+            {
+                options.threadCount = (unsigned int) std::stoul(argv[i + 1]);
+            }
+            else if (option == MIN_TIME_OPTION)
+            {
+                options.minTime = std::stod(argv[i + 1]);
+            }
+            else if (option == MAX_HOLE_OPTION)
+            {
+                options.maxHole = std::stoi(argv[i + 1]);
+            }
+            else if (option == Z_OPTION)
+            {
+                options.z = std::stof(argv[i + 1]);
+            }
+            else
+            {
+                std::cerr << USAGE_MESSAGE << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        catch (const std::exception &exception)
+        {
+            // Invalid option value.
+            std::cerr << "Error: invalid value of " << option << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    std::cout << "Seed " << options.seed << ", z " << options.z << ", epsilon " << BENCH_EPSILON
+              << ", connectivity " << DEFAULT_CONNECTIVITY << std::endl;
+    std::cout << std::left << std::setw(14) << "benchmark" << std::setw(8) << "shape"
+              << std::right << std::setw(7) << "image" << std::setw(9) << "hole"
+              << std::setw(9) << "boundary" << std::setw(8) << "reps" << std::setw(12) << "us/rep"
+              << std::setw(12) << "Mpixels/s" << std::setw(10) << "ns/pair"
+              << std::setw(10) << "peak MB" << std::endl;
+    HoleGenerator generator(options.seed);
+    for (int holeSize = MIN_HOLE; holeSize <= options.maxHole; holeSize *= 2)
+    {
+        for (const BenchCase &benchCase : createCases(holeSize, generator))
+        {
+            runCase(benchCase, options);
+        }
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
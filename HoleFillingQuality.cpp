@@ -0,0 +1,1054 @@
+/**
+ * @file HoleFillingQuality.cpp
+ * @author Itai Tagar
+ *
+ * @brief The quality harness of the fill strategies, which punches seeded holes into a corpus
+ *        of images and reports the time and the error of every strategy against the original
+ *        pixels, as CSV or JSON.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include "Pixel.h"
+#include "Image.h"
+#include "ColorImage.h"
+#include "HoleMask.h"
+#include "Hole.h"
+#include "HoleFiller.h"
+#include "HoleGenerator.h"
+#include "FillConfig.h"
+#include "FillKernel.h"
+#include "GpuFill.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def USAGE_MESSAGE "Usage: HoleFillingQuality [options] [<image.pgm> ...]"
+ * @brief A Macro that sets the usage message of the quality harness.
+ */
+#define USAGE_MESSAGE "Usage: HoleFillingQuality [--seed <seed>] [--threads <count>] " \
+                      "[--min-time <seconds>] [--max-hole <size>] [--max-square <side>] " \
+                      "[--coverage <fraction>] " \
+                      "[--z <value>] [--epsilon <value>] [--size <size>] [--format csv|json] " \
+                      "[<image.pgm> ...]"
+
+/**
+ * @def SEED_OPTION "--seed"
+ * @brief A Macro that sets the option of the seed of the hole generator.
+ */
+#define SEED_OPTION "--seed"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option of the number of threads used in the fills.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def MIN_TIME_OPTION "--min-time"
+ * @brief A Macro that sets the option of the minimal measured time of a fill.
+ */
+#define MIN_TIME_OPTION "--min-time"
+
+/**
+ * @def MAX_HOLE_OPTION "--max-hole"
+ * @brief A Macro that sets the option of the largest hole size.
+ */
+#define MAX_HOLE_OPTION "--max-hole"
+
+/**
+ * @def MAX_SQUARE_OPTION "--max-square"
+ * @brief A Macro that sets the option of the largest side of the single square holes.
+ */
+#define MAX_SQUARE_OPTION "--max-square"
+
+/**
+ * @def COVERAGE_OPTION "--coverage"
+ * @brief A Macro that sets the option of the fraction of the missing pixels of an image.
+ */
+#define COVERAGE_OPTION "--coverage"
+
+/**
+ * @def Z_OPTION "--z"
+ * @brief A Macro that sets the option of the z value of the weighted function.
+ */
+#define Z_OPTION "--z"
+
+/**
+ * @def EPSILON_OPTION "--epsilon"
+ * @brief A Macro that sets the option of the epsilon value of the weighted function.
+ */
+#define EPSILON_OPTION "--epsilon"
+
+/**
+ * @def SIZE_OPTION "--size"
+ * @brief A Macro that sets the option of the size of the synthetic images.
+ */
+#define SIZE_OPTION "--size"
+
+/**
+ * @def FORMAT_OPTION "--format"
+ * @brief A Macro that sets the option of the format of the results.
+ */
+#define FORMAT_OPTION "--format"
+
+/**
+ * @def OPTION_PREFIX "--"
+ * @brief A Macro that sets the prefix of an option, any other argument is an image path.
+ */
+#define OPTION_PREFIX "--"
+
+/**
+ * @def CSV_FORMAT "csv"
+ * @brief A Macro that sets the name of the CSV format of the results.
+ */
+#define CSV_FORMAT "csv"
+
+/**
+ * @def JSON_FORMAT "json"
+ * @brief A Macro that sets the name of the JSON format of the results.
+ */
+#define JSON_FORMAT "json"
+
+/**
+ * @def PGM_MAGIC "P5"
+ * @brief A Macro that sets the magic number of a binary PGM image.
+ */
+#define PGM_MAGIC "P5"
+
+/**
+ * @def PGM_COMMENT '#'
+ * @brief A Macro that sets the character which begins a comment in a PGM header.
+ */
+#define PGM_COMMENT '#'
+
+/**
+ * @def MAX_BYTE_VALUE 255
+ * @brief A Macro that sets the largest value of a PGM image of a byte per pixel.
+ */
+#define MAX_BYTE_VALUE 255
+
+/**
+ * @def MAX_SHORT_VALUE 65535
+ * @brief A Macro that sets the largest value of a PGM image of 2 bytes per pixel.
+ */
+#define MAX_SHORT_VALUE 65535
+
+/**
+ * @def DEFAULT_SEED 1
+ * @brief A Macro that sets the default seed of the hole generator and the synthetic images.
+ */
+#define DEFAULT_SEED 1
+
+/**
+ * @def DEFAULT_MIN_TIME 0.1
+ * @brief A Macro that sets the default minimal measured time of a fill, in seconds.
+ */
+#define DEFAULT_MIN_TIME 0.1
+
+/**
+ * @def DEFAULT_MAX_HOLE 64
+ * @brief A Macro that sets the default largest hole size.
+ */
+#define DEFAULT_MAX_HOLE 64
+
+/**
+ * @def DEFAULT_MAX_SQUARE 384
+ * @brief A Macro that sets the default largest side of the single square holes.
+ */
+#define DEFAULT_MAX_SQUARE 384
+
+/**
+ * @def DEFAULT_COVERAGE 0.05
+ * @brief A Macro that sets the default fraction of the missing pixels of an image.
+ */
+#define DEFAULT_COVERAGE 0.05
+
+/**
+ * @def DEFAULT_SIZE 512
+ * @brief A Macro that sets the default number of rows and columns of the synthetic images. The
+ *        holes of a case of the default coverage have about 13000 pixels, more than the pyramid
+ *        fills exactly, so the pyramid builds coarser levels.
+ */
+#define DEFAULT_SIZE 512
+
+/**
+ * @def QUALITY_EPSILON 0.01f
+ * @brief A Macro that sets the default epsilon value of the weighted function.
+ */
+#define QUALITY_EPSILON 0.01f
+
+/**
+ * @def MIN_HOLE 8
+ * @brief A Macro that sets the smallest hole size.
+ */
+#define MIN_HOLE 8
+
+/**
+ * @def MIN_SQUARE 96
+ * @brief A Macro that sets the smallest side of the single square holes. The sides double from
+ *        it, so the holes of the default sides have about 3.5M, 28M and 227M pairs of a hole
+ *        pixel and a boundary pixel, on both sides of the pairs of a hole which is filled on
+ *        the GPU (4M) and of a hole which the automatic strategy approximates (67M), and they
+ *        cross the cost of the convolution.
+ */
+#define MIN_SQUARE 96
+
+/**
+ * @def TABLE_Z_OFFSET 0.01f
+ * @brief A Macro that sets the offset of the z value of the weight table row from a z value
+ *        with a fill kernel, since only a z value without a kernel is filled by the table.
+ */
+#define TABLE_Z_OFFSET 0.01f
+
+/**
+ * @def BRUSH_TO_HOLE_RATIO 4
+ * @brief A Macro that sets the ratio of the hole size to the brush size of a brush stroke.
+ */
+#define BRUSH_TO_HOLE_RATIO 4
+
+/**
+ * @def BAND_SIZE 24
+ * @brief A Macro that sets the width of a band of the synthetic image of edges.
+ */
+#define BAND_SIZE 24
+
+/**
+ * @def BAND_LEVELS 4
+ * @brief A Macro that sets the number of distinct values of the bands of the image of edges.
+ */
+#define BAND_LEVELS 4
+
+/**
+ * @def NOISE_AMPLITUDE 0.1f
+ * @brief A Macro that sets the amplitude of the noise of the synthetic image of texture.
+ */
+#define NOISE_AMPLITUDE 0.1f
+
+/**
+ * @def CHECK_IMAGE_SIZE 192
+ * @brief A Macro that sets the number of rows and columns of the images of the checks.
+ */
+#define CHECK_IMAGE_SIZE 192
+
+/**
+ * @def CHECK_HOLE_SIZE 64
+ * @brief A Macro that sets the number of rows and columns of the square hole of the checks.
+ */
+#define CHECK_HOLE_SIZE 64
+
+/**
+ * @def CHECK_PYRAMID_HOLE_SIZE 96
+ * @brief A Macro that sets the number of rows and columns of the square hole of the checks of
+ *        the pyramid fill, large enough that the pyramid builds coarser levels.
+ */
+#define CHECK_PYRAMID_HOLE_SIZE 96
+
+/**
+ * @def CHECK_CHANNELS 3
+ * @brief A Macro that sets the number of channels of the color image of the checks.
+ */
+#define CHECK_CHANNELS 3
+
+/**
+ * @def CHECK_TOLERANCE 1e-4f
+ * @brief A Macro that sets the rounding error allowed by the checks, e.g. of the convolution.
+ */
+#define CHECK_TOLERANCE 1e-4f
+
+/**
+ * @def PEAK_VALUE 1.0
+ * @brief A Macro that sets the largest value of a normalized pixel, the peak of the PSNR.
+ */
+#define PEAK_VALUE 1.0
+
+/**
+ * @def MICROSECONDS_PER_SECOND 1e6
+ * @brief A Macro that sets the number of microseconds in a second.
+ */
+#define MICROSECONDS_PER_SECOND 1e6
+
+/**
+ * @def NANOSECONDS_PER_SECOND 1e9
+ * @brief A Macro that sets the number of nanoseconds in a second.
+ */
+#define NANOSECONDS_PER_SECOND 1e9
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The parameters of the quality harness.
+ */
+struct QualityOptions
+{
+    unsigned int seed = DEFAULT_SEED;  // The seed of the hole generator and the synthetic images.
+    unsigned int threadCount = 0;  // The number of threads used in the fills.
+    double minTime = DEFAULT_MIN_TIME;  // The minimal measured time of a fill.
+    int maxHole = DEFAULT_MAX_HOLE;  // The largest hole size.
+    int maxSquare = DEFAULT_MAX_SQUARE;  // The largest side of the single square holes.
+    double coverage = DEFAULT_COVERAGE;  // The fraction of the missing pixels of an image.
+    float z = DEFAULT_Z;  // The z value of the weighted function.
+    float epsilon = QUALITY_EPSILON;  // The epsilon value of the weighted function.
+    int size = DEFAULT_SIZE;  // The number of rows and columns of the synthetic images.
+    std::string format = CSV_FORMAT;  // The format of the results.
+    std::vector<std::string> paths;  // The PGM images of the corpus, synthetic if empty.
+};
+
+/**
+ * @brief An image of the corpus, whose pixels are the ground truth of the fills.
+ */
+struct CorpusImage
+{
+    std::string name;  // The path of the image, or the name of the synthetic image.
+    Image original;  // The pixels of the image, normalized into [0,1].
+};
+
+/**
+ * @brief The time and the error of a fill of the holes of an image by a single strategy.
+ */
+struct QualityResult
+{
+    std::string image;  // The name of the image.
+    std::string shape;  // The shape of the holes.
+    int holeSize = 0;  // The maximal width and height of a hole.
+    std::string strategy;  // The name of the fill strategy.
+    size_t holeCount = 0;  // The number of holes.
+    size_t holePixels = 0;  // The number of missing pixels.
+    double pairCount = 0;  // The number of pairs of a hole pixel and a boundary pixel.
+    size_t repetitions = 0;  // The number of measured fills.
+    double time = 0;  // The mean time of a fill, in seconds.
+    double rmse = 0;  // The root mean square error against the original pixels.
+    double maxError = 0;  // The largest absolute error against the original pixels.
+    double exactRmse = 0;  // The root mean square difference from the exact fill.
+    bool isExact = false;  // Whether the filled pixels are identical to the exact fill.
+};
+
+
+/*-----=  Corpus Functions  =-----*/
+
+
+/**
+ * @brief Skips the whitespace and the comments of a PGM header.
+ * @param stream The stream of the PGM image.
+ */
+static void skipHeaderSpace(std::istream &stream)
+{
+    while (stream)
+    {
+        const int next = stream.peek();
+        if (next == PGM_COMMENT)
+        {
+            stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        else if (std::isspace(next))
+        {
+            stream.get();
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Reads a binary PGM image of 8 or 16 bits into an image normalized into [0,1].
+ * @param path The path of the PGM image.
+ * @param image Set to the normalized image.
+ * @return true if the image was read, false otherwise.
+ */
+static bool readPgm(const std::string &path, Image &image)
+{
+    std::ifstream stream(path, std::ios::binary);
+    std::string magic;
+    int cols = 0, rows = 0, maxValue = 0;
+    stream >> magic;
+    skipHeaderSpace(stream);
+    stream >> cols;
+    skipHeaderSpace(stream);
+    stream >> rows;
+    skipHeaderSpace(stream);
+    stream >> maxValue;
+    if (!stream || magic != PGM_MAGIC || cols <= 0 || rows <= 0 || maxValue <= 0 ||
+        maxValue > MAX_SHORT_VALUE)
+    {
+        return false;
+    }
+    // A single whitespace character separates the header from the pixels.
+    stream.get();
+
+    const size_t bytesPerValue = maxValue > MAX_BYTE_VALUE ? 2 : 1;
+    std::vector<unsigned char> row((size_t) cols * bytesPerValue);
+    image = Image(rows, cols);
+    for (int x = INITIAL_ROW; x < rows; ++x)
+    {
+        if (!stream.read((char*) row.data(), (std::streamsize) row.size()))
+        {
+            return false;
+        }
+        for (int y = INITIAL_COLUMN; y < cols; ++y)
+        {
+            // The values of 16 bits are big-endian.
+            const int value = bytesPerValue == 1 ? row[y] : (row[2 * y] << 8) | row[2 * y + 1];
+            image.at(x, y) = (float) std::min(value, maxValue) / maxValue;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Creates the synthetic corpus: a smooth image, an image of bands with sharp edges
+ *        between them, and a textured image of smooth values with seeded noise.
+ * @param size The number of rows and columns of the images.
+ * @param seed The seed of the noise.
+ * @return The images of the corpus.
+ */
+static std::vector<CorpusImage> createCorpus(const int size, const unsigned int seed)
+{
+    std::vector<CorpusImage> corpus(3);
+    corpus[0].name = "smooth";
+    corpus[1].name = "edges";
+    corpus[2].name = "texture";
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> noise(-NOISE_AMPLITUDE, NOISE_AMPLITUDE);
+    for (CorpusImage &corpusImage : corpus)
+    {
+        corpusImage.original = Image(size, size);
+    }
+    for (int x = INITIAL_ROW; x < size; ++x)
+    {
+        for (int y = INITIAL_COLUMN; y < size; ++y)
+        {
+            const float smooth = 0.5f + 0.25f * std::sin(0.05f * x) + 0.25f * std::cos(0.03f * y);
+            corpus[0].original.at(x, y) = smooth;
+            corpus[1].original.at(x, y) = (float) ((x / BAND_SIZE + 2 * (y / BAND_SIZE)) %
+                                                   BAND_LEVELS) / (BAND_LEVELS - 1);
+            corpus[2].original.at(x, y) = std::min(1.0f, std::max(0.0f, smooth + noise(engine)));
+        }
+    }
+    return corpus;
+}
+
+
+/*-----=  Harness Functions  =-----*/
+
+
+/**
+ * @brief Runs a fill until its measured time is at least the given time. Only the fill is
+ *        measured, the preparation of every repetition isn't.
+ * @tparam Prepare The type of the preparation of a repetition.
+ * @tparam Run The type of the measured fill.
+ * @param prepare The preparation of a repetition.
+ * @param run The measured fill.
+ * @param minTime The minimal measured time, in seconds.
+ * @param repetitions Set to the number of repetitions.
+ * @return The mean time of a repetition, in seconds.
+ */
+template <typename Prepare, typename Run>
+static double runTimed(const Prepare &prepare, const Run &run, const double minTime,
+                       size_t &repetitions)
+{
+    double totalTime = 0;
+    repetitions = 0;
+    do
+    {
+        prepare();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        totalTime += std::chrono::duration<double>(end - start).count();
+        ++repetitions;
+    } while (totalTime < minTime);
+    return totalTime / repetitions;
+}
+
+/**
+ * @brief Computes the error of the hole pixels of a filled image against the original pixels
+ *        and against the exact fill, and whether they are identical to the exact fill.
+ * @param holes The holes of the image.
+ * @param filled The filled image.
+ * @param original The original image.
+ * @param exact The image filled by the exact fill.
+ * @param result Set to the errors of the fill.
+ */
+static void measureError(const std::vector<Hole> &holes, const Image &filled,
+                         const Image &original, const Image &exact, QualityResult &result)
+{
+    double squaredError = 0, squaredExactError = 0, maxError = 0;
+    bool isExact = true;
+    for (const Hole &hole : holes)
+    {
+        hole.forEachHolePixel([&](const size_t, const Pixel &x)
+        {
+            const double error = (double) filled.at(x) - original.at(x);
+            const double exactError = (double) filled.at(x) - exact.at(x);
+            squaredError += error * error;
+            squaredExactError += exactError * exactError;
+            maxError = std::max(maxError, std::abs(error));
+            isExact = isExact && filled.at(x) == exact.at(x);
+        });
+    }
+    result.rmse = std::sqrt(squaredError / result.holePixels);
+    result.exactRmse = std::sqrt(squaredExactError / result.holePixels);
+    result.maxError = maxError;
+    result.isExact = isExact;
+}
+
+/**
+ * @brief Returns the fills of every case: every strategy, and then the exact fill by every one
+ *        of it's paths, so the rows of a case show the thresholds of the cost model from both
+ *        sides. The exact fill is the first, since the other fills are measured against it.
+ *        The paths are the direct fill on the CPU, the convolution, the weight table and the
+ *        GPU if there is a device. The weight table fills a z value without a fill kernel, so
+ *        it's row fills by the nearest such z value (see TABLE_Z_OFFSET), and it's difference
+ *        from the exact fill includes the difference of the weights.
+ * @param options The parameters of the quality harness.
+ * @return The names and the parameters of the fills.
+ */
+static std::vector<std::pair<const char*, FillConfig>> getFills(const QualityOptions &options)
+{
+    FillConfig config;
+    config.epsilon = options.epsilon;
+    config.z = options.z;
+    std::vector<std::pair<const char*, FillConfig>> fills;
+    const std::pair<const char*, FillStrategy> strategies[] = {
+            {"exact", EXACT_FILL}, {"neighbours", NEIGHBOURS_FILL},
+            {"approximate", APPROXIMATE_FILL}, {"pyramid", PYRAMID_FILL}, {"auto", AUTO_FILL}};
+    for (const auto &strategy : strategies)
+    {
+        config.strategy = strategy.second;
+        fills.emplace_back(strategy.first, config);
+    }
+
+    config.strategy = EXACT_FILL;
+    FillConfig direct = config;
+    direct.convolution = NEVER_CONVOLUTION;
+    direct.device = CPU_DEVICE;
+    fills.emplace_back("direct", direct);
+    FillConfig convolution = config;
+    convolution.convolution = ALWAYS_CONVOLUTION;
+    fills.emplace_back("convolution", convolution);
+    FillConfig table = direct;
+    if (FillKernel(table.epsilon, table.z).isSpecialised())
+    {
+        table.z += TABLE_Z_OFFSET;
+    }
+    fills.emplace_back("table", table);
+    if (GpuFill::isAvailable())
+    {
+        FillConfig gpu = direct;
+        gpu.device = GPU_DEVICE;
+        fills.emplace_back("gpu", gpu);
+    }
+    return fills;
+}
+
+/**
+ * @brief Sets the pixels of a square hole of the given side at the centre of the given image
+ *        to MISSING_VALUE.
+ * @param image The image.
+ * @param side The number of rows and columns of the hole.
+ */
+static void punchSquareHole(Image &image, const int side)
+{
+    const int cornerX = (image.getRows() - side) / 2;
+    const int cornerY = (image.getCols() - side) / 2;
+    for (int x = cornerX; x < cornerX + side; ++x)
+    {
+        std::fill(image.getRow(x) + cornerY, image.getRow(x) + cornerY + side,
+                  (float) MISSING_VALUE);
+    }
+}
+
+/**
+ * @brief Fills the holes of the given corrupted image by every fill, and adds the time and the
+ *        error of every fill to the results.
+ * @param corpusImage The image of the corpus.
+ * @param shape The name of the shape of the holes.
+ * @param holeSize The maximal width and height of a hole.
+ * @param corrupted The image of the corpus with the holes.
+ * @param fills The names and the parameters of the fills, the exact fill first.
+ * @param options The parameters of the quality harness.
+ * @param filler The filler of the holes.
+ * @param results The results to add to.
+ */
+static void runCase(const CorpusImage &corpusImage, const char *shape, const int holeSize,
+                    const Image &corrupted,
+                    const std::vector<std::pair<const char*, FillConfig>> &fills,
+                    const QualityOptions &options, HoleFiller &filler,
+                    std::vector<QualityResult> &results)
+{
+    filler.setConfig(fills.front().second);
+    const std::vector<Hole> holes = filler.findHoles(corrupted);
+    if (holes.empty())
+    {
+        return;
+    }
+
+    QualityResult caseResult;
+    caseResult.image = corpusImage.name;
+    caseResult.shape = shape;
+    caseResult.holeSize = holeSize;
+    caseResult.holeCount = holes.size();
+    for (const Hole &hole : holes)
+    {
+        caseResult.holePixels += hole.getHoleSize();
+        caseResult.pairCount += (double) hole.getHoleSize() * hole.getHoleBoundary().size();
+    }
+
+    Image exact;
+    Image image = corrupted.clone();
+    for (const auto &fill : fills)
+    {
+        filler.setConfig(fill.second);
+        QualityResult result = caseResult;
+        result.strategy = fill.first;
+        result.time = runTimed([&]
+        {
+            // Restore the holes, which were filled by the previous repetition.
+            for (const Hole &hole : holes)
+            {
+                hole.forEachHolePixel([&](const size_t, const Pixel &x)
+                {
+                    image.at(x) = MISSING_VALUE;
+                });
+            }
+        }, [&]
+        {
+            filler.fillHoles(image, holes);
+        }, options.minTime, result.repetitions);
+        if (&fill == &fills.front())
+        {
+            exact = image.clone();
+        }
+        measureError(holes, image, corpusImage.original, exact, result);
+        results.push_back(result);
+    }
+}
+
+/**
+ * @brief Runs the cases of the given image of the corpus. For every shape of holes and every
+ *        hole size, seeded holes are punched into the image up to the coverage, so a case has
+ *        the same holes in every run. Then a single square hole of every side from MIN_SQUARE
+ *        up to the largest side is punched at the centre of the image, if it fits.
+ * @param corpusImage The image of the corpus.
+ * @param fills The names and the parameters of the fills, the exact fill first.
+ * @param options The parameters of the quality harness.
+ * @param filler The filler of the holes.
+ * @param results The results to add to.
+ */
+static void runCases(const CorpusImage &corpusImage,
+                     const std::vector<std::pair<const char*, FillConfig>> &fills,
+                     const QualityOptions &options, HoleFiller &filler,
+                     std::vector<QualityResult> &results)
+{
+    const std::pair<const char*, HoleShape> shapes[] = {
+            {"rectangle", RECTANGLE_HOLE}, {"ellipse", ELLIPSE_HOLE},
+            {"brush", BRUSH_STROKE_HOLE}};
+    for (const auto &shape : shapes)
+    {
+        for (int holeSize = MIN_HOLE; holeSize <= options.maxHole; holeSize *= 2)
+        {
+            Image corrupted = corpusImage.original.clone();
+            HoleGenerator generator(options.seed);
+            generator.generateHoles(corrupted, shape.second, shape.second == BRUSH_STROKE_HOLE ?
+                                                             holeSize / BRUSH_TO_HOLE_RATIO :
+                                                             holeSize,
+                                    options.coverage);
+            runCase(corpusImage, shape.first, holeSize, corrupted, fills, options, filler,
+                    results);
+        }
+    }
+    for (int side = MIN_SQUARE; side <= options.maxSquare; side *= 2)
+    {
+        // The hole needs a boundary on every side.
+        if (side + 2 > corpusImage.original.getRows() || side + 2 > corpusImage.original.getCols())
+        {
+            break;
+        }
+        Image corrupted = corpusImage.original.clone();
+        punchSquareHole(corrupted, side);
+        runCase(corpusImage, "square", side, corrupted, fills, options, filler, results);
+    }
+}
+
+
+/*-----=  Check Functions  =-----*/
+
+
+/**
+ * @brief Creates the image of the checks, the synthetic image of edges with a square hole at
+ *        its centre.
+ * @param seed The seed of the synthetic images.
+ * @param holeSize The number of rows and columns of the hole.
+ * @param original Set to the image without the hole.
+ * @return The image with the hole.
+ */
+static Image createCheckImage(const unsigned int seed, const int holeSize, Image &original)
+{
+    original = std::move(createCorpus(CHECK_IMAGE_SIZE, seed)[1].original);
+    Image image = original.clone();
+    punchSquareHole(image, holeSize);
+    return image;
+}
+
+/**
+ * @brief Checks that the gaussian fill of a large hole, where the weights of the pixels far
+ *        from the boundary underflow, is finite and within the values of the image, by every
+ *        strategy which supports the gaussian weight and by the convolution.
+ * @param options The parameters of the quality harness.
+ * @param filler The filler of the holes.
+ * @return true if the check passed, false otherwise.
+ */
+static bool checkGaussianFill(const QualityOptions &options, HoleFiller &filler)
+{
+    const std::pair<const char*, FillStrategy> strategies[] = {
+            {"exact", EXACT_FILL}, {"convolution", EXACT_FILL}, {"neighbours", NEIGHBOURS_FILL},
+            {"pyramid", PYRAMID_FILL}, {"auto", AUTO_FILL}};
+    Image original;
+    const Image holeImage = createCheckImage(options.seed, CHECK_HOLE_SIZE, original);
+    bool passed = true;
+    for (const auto &strategy : strategies)
+    {
+        FillConfig config;
+        config.weight = GAUSSIAN_WEIGHT;
+        config.strategy = strategy.second;
+        config.convolution = (std::string(strategy.first) == "convolution") ?
+                             ALWAYS_CONVOLUTION : NEVER_CONVOLUTION;
+        filler.setConfig(config);
+        Image image = holeImage.clone();
+        filler.fill(image);
+        for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+        {
+            for (int y = INITIAL_COLUMN; y < image.getCols(); ++y)
+            {
+                // A value out of the range (or NaN) isn't a weighted mean of the boundary.
+                if (!(image.at(x, y) >= -CHECK_TOLERANCE &&
+                      image.at(x, y) <= PEAK_VALUE + CHECK_TOLERANCE))
+                {
+                    std::cerr << "Check failed: the gaussian fill by " << strategy.first
+                              << " gives " << image.at(x, y) << " at " << Pixel(x, y)
+                              << std::endl;
+                    passed = false;
+                    x = image.getRows();
+                    break;
+                }
+            }
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief Checks that the pyramid fill of a float color image through a mask matches the
+ *        pyramid fill of every channel alone. The hole pixels of the color image keep their
+ *        original values, as the holes of a mask may have any values, so a fill which reads
+ *        them instead of the boundary doesn't match.
+ * @param options The parameters of the quality harness.
+ * @param filler The filler of the holes.
+ * @return true if the check passed, false otherwise.
+ */
+static bool checkColorPyramidFill(const QualityOptions &options, HoleFiller &filler)
+{
+    Image original;
+    const Image holeImage = createCheckImage(options.seed, CHECK_PYRAMID_HOLE_SIZE, original);
+    const HoleMask mask = HoleMask::fromImage(holeImage);
+    ColorImage colorImage(original.getRows(), original.getCols(), CHECK_CHANNELS);
+    for (int x = INITIAL_ROW; x < original.getRows(); ++x)
+    {
+        for (int y = INITIAL_COLUMN; y < original.getCols(); ++y)
+        {
+            for (int c = 0; c < CHECK_CHANNELS; ++c)
+            {
+                colorImage.at(x, y)[c] = (original.at(x, y) + c) / CHECK_CHANNELS;
+            }
+        }
+    }
+
+    FillConfig config;
+    config.strategy = PYRAMID_FILL;
+    config.epsilon = options.epsilon;
+    config.z = options.z;
+    filler.setConfig(config);
+    filler.fill(colorImage, mask);
+    bool passed = true;
+    for (int c = 0; c < CHECK_CHANNELS; ++c)
+    {
+        Image plane = holeImage.clone();
+        for (int x = INITIAL_ROW; x < plane.getRows(); ++x)
+        {
+            for (int y = INITIAL_COLUMN; y < plane.getCols(); ++y)
+            {
+                if (!mask.isMissing(x, y))
+                {
+                    plane.at(x, y) = colorImage.at(x, y)[c];
+                }
+            }
+        }
+        filler.fill(plane);
+        for (int x = INITIAL_ROW; x < plane.getRows(); ++x)
+        {
+            for (int y = INITIAL_COLUMN; y < plane.getCols(); ++y)
+            {
+                if (!(std::fabs(colorImage.at(x, y)[c] - plane.at(x, y)) <= CHECK_TOLERANCE))
+                {
+                    std::cerr << "Check failed: the pyramid fill of channel " << c
+                              << " of a color image gives " << colorImage.at(x, y)[c] << " at "
+                              << Pixel(x, y) << " instead of " << plane.at(x, y) << std::endl;
+                    passed = false;
+                    x = plane.getRows();
+                    break;
+                }
+            }
+        }
+    }
+    return passed;
+}
+
+
+/*-----=  Output Functions  =-----*/
+
+
+/**
+ * @brief Returns the peak signal to noise ratio of the given error.
+ * @param rmse The root mean square error of the normalized pixels.
+ * @return The PSNR in decibels, infinite for no error.
+ */
+static double getPsnr(const double rmse)
+{
+    return rmse > 0 ? 20 * std::log10(PEAK_VALUE / rmse) : std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Writes the results as CSV, a header row and a row of every fill.
+ * @param results The results.
+ */
+static void writeCsv(const std::vector<QualityResult> &results)
+{
+    std::cout << "image,shape,hole_size,strategy,holes,hole_pixels,pairs,repetitions,"
+                 "time_us,mpixels_per_s,ns_per_pair,rmse,psnr_db,max_error,exact_rmse,is_exact"
+              << std::endl;
+    for (const QualityResult &result : results)
+    {
+        std::cout << result.image << ',' << result.shape << ',' << result.holeSize << ','
+                  << result.strategy << ',' << result.holeCount << ',' << result.holePixels
+                  << ',' << (size_t) result.pairCount << ',' << result.repetitions << ','
+                  << result.time * MICROSECONDS_PER_SECOND << ','
+                  << result.holePixels / result.time / 1e6 << ','
+                  << result.time * NANOSECONDS_PER_SECOND / result.pairCount << ','
+                  << result.rmse << ',' << getPsnr(result.rmse) << ',' << result.maxError << ','
+                  << result.exactRmse << ',' << result.isExact << std::endl;
+    }
+}
+
+/**
+ * @brief Writes a string as a JSON string, escaping it's quotes and backslashes.
+ * @param value The string.
+ */
+static void writeJsonString(const std::string &value)
+{
+    std::cout << '"';
+    for (const char character : value)
+    {
+        if (character == '"' || character == '\\')
+        {
+            std::cout << '\\';
+        }
+        std::cout << character;
+    }
+    std::cout << '"';
+}
+
+/**
+ * @brief Writes the results as JSON, an object of the parameters and an array of the fills.
+ *        A PSNR of no error, which is infinite, is written as null.
+ * @param results The results.
+ * @param options The parameters of the quality harness.
+ */
+static void writeJson(const std::vector<QualityResult> &results, const QualityOptions &options)
+{
+    std::cout << "{\"seed\": " << options.seed << ", \"z\": " << options.z << ", \"epsilon\": "
+              << options.epsilon << ", \"coverage\": " << options.coverage
+              << ", \"connectivity\": " << DEFAULT_CONNECTIVITY << ", \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const QualityResult &result = results[i];
+        const double psnr = getPsnr(result.rmse);
+        std::cout << (i == 0 ? "" : ",") << "\n  {\"image\": ";
+        writeJsonString(result.image);
+        std::cout << ", \"shape\": \"" << result.shape << "\", \"hole_size\": " << result.holeSize
+                  << ", \"strategy\": \"" << result.strategy << "\", \"holes\": "
+                  << result.holeCount << ", \"hole_pixels\": " << result.holePixels
+                  << ", \"pairs\": " << (size_t) result.pairCount << ", \"repetitions\": "
+                  << result.repetitions << ", \"time_us\": " << result.time * MICROSECONDS_PER_SECOND
+                  << ", \"mpixels_per_s\": " << result.holePixels / result.time / 1e6
+                  << ", \"ns_per_pair\": " << result.time * NANOSECONDS_PER_SECOND / result.pairCount
+                  << ", \"rmse\": " << result.rmse << ", \"psnr_db\": ";
+        if (std::isinf(psnr))
+        {
+            std::cout << "null";
+        }
+        else
+        {
+            std::cout << psnr;
+        }
+        std::cout << ", \"max_error\": " << result.maxError << ", \"exact_rmse\": "
+                  << result.exactRmse << ", \"is_exact\": " << (result.isExact ? "true" : "false")
+                  << '}';
+    }
+    std::cout << "\n]}" << std::endl;
+}
+
+
+/*-----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the quality harness. For every image of the corpus (the
+ *        given PGM images, or the synthetic images), every shape of the holes and every hole
+ *        size it punches seeded holes into the image, and then single square holes (see
+ *        runCases), fills them by every strategy and every path of the exact fill, and reports
+ *        the time of the fill, the hole pixels per second, the nanoseconds per pair of a hole
+ *        pixel and a boundary pixel, the RMSE, PSNR and maximal error against the original
+ *        pixels, the RMSE against the exact fill and whether the fill is the exact fill. Then
+ *        it runs the checks of the fills, see the Check Functions, which report their failures
+ *        to stderr.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @return 0 if the harness ended successfully and all the checks passed, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    QualityOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (option.compare(0, 2, OPTION_PREFIX) != 0)
+        {
+            options.paths.push_back(option);
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << USAGE_MESSAGE << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        const std::string value = argv[++i];
+        try
+        {
+            if (option == SEED_OPTION)
+            {
+                options.seed = (unsigned int) std::stoul(value);
+            }
+            else if (option == THREADS_OPTION)
+            {
+                options.threadCount = (unsigned int) std::stoul(value);
+            }
+            else if (option == MIN_TIME_OPTION)
+            {
+                options.minTime = std::stod(value);
+            }
+            else if (option == MAX_HOLE_OPTION)
+            {
+                options.maxHole = std::stoi(value);
+            }
+            else if (option == MAX_SQUARE_OPTION)
+            {
+                options.maxSquare = std::stoi(value);
+            }
+            else if (option == COVERAGE_OPTION)
+            {
+                options.coverage = std::stod(value);
+            }
+            else if (option == Z_OPTION)
+            {
+                options.z = std::stof(value);
+            }
+            else if (option == EPSILON_OPTION)
+            {
+                options.epsilon = std::stof(value);
+            }
+            else if (option == SIZE_OPTION)
+            {
+                options.size = std::stoi(value);
+            }
+            else if (option == FORMAT_OPTION && (value == CSV_FORMAT || value == JSON_FORMAT))
+            {
+                options.format = value;
+            }
+            else
+            {
+                std::cerr << USAGE_MESSAGE << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        catch (const std::exception &exception)
+        {
+            // Invalid option value.
+            std::cerr << "Error: invalid value of " << option << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (options.coverage < 0 || options.coverage > 1 || options.size <= 0)
+    {
+        std::cerr << USAGE_MESSAGE << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<CorpusImage> corpus;
+    if (options.paths.empty())
+    {
+        corpus = createCorpus(options.size, options.seed);
+    }
+    for (const std::string &path : options.paths)
+    {
+        CorpusImage corpusImage;
+        corpusImage.name = path;
+        if (!readPgm(path, corpusImage.original))
+        {
+            std::cerr << "Error: can't read the PGM image " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        corpus.push_back(std::move(corpusImage));
+    }
+
+    const std::vector<std::pair<const char*, FillConfig>> fills = getFills(options);
+    HoleFiller filler((FillConfig()), options.threadCount);
+    std::vector<QualityResult> results;
+    for (const CorpusImage &corpusImage : corpus)
+    {
+        runCases(corpusImage, fills, options, filler, results);
+    }
+
+    if (options.format == JSON_FORMAT)
+    {
+        writeJson(results, options);
+    }
+    else
+    {
+        writeCsv(results);
+    }
+
+    bool passed = true;
+    passed = checkGaussianFill(options, filler) && passed;
+    passed = checkColorPyramidFill(options, filler) && passed;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file HoleGenerator.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the HoleGenerator Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cmath>
+#include "HoleGenerator.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def TWO_PI 6.283185307179586
+ * @brief A Macro that sets the full angle, in radians.
+ */
+#define TWO_PI 6.283185307179586
+
+/**
+ * @def BRUSH_MAX_TURN 0.5
+ * @brief A Macro that sets the maximal change of the direction of a brush stroke in a step, in
+ *        radians.
+ */
+#define BRUSH_MAX_TURN 0.5
+
+/**
+ * @def BRUSH_LENGTH_RATIO 4
+ * @brief A Macro that sets the maximal length of a brush stroke, as a multiple of the maximal
+ *        brush width.
+ */
+#define BRUSH_LENGTH_RATIO 4
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the HoleGenerator.
+ * @param seed The seed of the random engine.
+ */
+HoleGenerator::HoleGenerator(const unsigned int seed) : _generator(seed)
+{
+
+}
+
+/**
+ * @brief Generates a random number from the range [lowerBound,upperBound].
+ * @param lowerBound The lower bound of the range.
+ * @param upperBound The upper bound of the range.
+ * @return a random integer from the range [lowerBound,upperBound].
+ */
+int HoleGenerator::generateRandomNumber(const int lowerBound, const int upperBound)
+{
+    std::uniform_int_distribution<int> dist(lowerBound, upperBound);
+    return dist(_generator);
+}
+
+/**
+ * @brief Generates random hole in a shape of a rectangle.
+ * @param image The image to corrupt.
+ */
+void HoleGenerator::generateRandomHole(Image &image)
+{
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    // Pick a random indices in the image.
+    const int randomRow1 = generateRandomNumber(INITIAL_ROW, rows - 1);
+    const int randomCol1 = generateRandomNumber(INITIAL_COLUMN, cols - 1);
+    const int randomRow2 = generateRandomNumber(INITIAL_ROW, rows - 1);
+    const int randomCol2 = generateRandomNumber(INITIAL_COLUMN, cols - 1);
+    // Set top left and bottom right points.
+    const int topLeftRow = (randomRow1 < randomRow2) ? randomRow1 : randomRow2;
+    const int topLeftCol = (randomCol1 < randomCol2) ? randomCol1 : randomCol2;
+    const int bottomRightRow = (randomRow1 < randomRow2) ? randomRow2 : randomRow1;
+    const int bottomRightCol = (randomCol1 < randomCol2) ? randomCol2 : randomCol1;
+    // Corrupt the image.
+    for (int currentRow = topLeftRow; currentRow <= bottomRightRow; ++currentRow)
+    {
+        for (int currentCol = topLeftCol; currentCol <= bottomRightCol; ++currentCol)
+        {
+            image.at(currentRow, currentCol) = MISSING_VALUE;
+        }
+    }
+}
+
+/**
+ * @brief Generate hole in the image from a given array of pixels.
+ * @param image The image to corrupt.
+ * @param holePixels The array of pixels which describe the hole.
+ * @param holeSize The number of pixels in the hole.
+ */
+void HoleGenerator::generateDefinedHole(Image &image, const Pixel *holePixels,
+                                        const int holeSize)
+{
+    for (int i = 0; i < holeSize; ++i)
+    {
+        image.at(holePixels[i]) = MISSING_VALUE;
+    }
+}
+
+/**
+ * @brief Generates a rectangle hole at a random location.
+ * @param image The image to corrupt.
+ * @param maxSize The maximal number of rows and columns of the rectangle.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::generateRectangle(Image &image, const int maxSize)
+{
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    const int height = generateRandomNumber(1, std::max(maxSize, 1));
+    const int width = generateRandomNumber(1, std::max(maxSize, 1));
+    const int topLeftRow = generateRandomNumber(INITIAL_ROW, rows - 1);
+    const int topLeftCol = generateRandomNumber(INITIAL_COLUMN, cols - 1);
+    const int bottomRightRow = std::min(topLeftRow + height, rows);
+    const int bottomRightCol = std::min(topLeftCol + width, cols);
+    size_t corrupted = 0;
+    for (int currentRow = topLeftRow; currentRow < bottomRightRow; ++currentRow)
+    {
+        float *row = image.getRow(currentRow);
+        for (int currentCol = topLeftCol; currentCol < bottomRightCol; ++currentCol)
+        {
+            corrupted += (row[currentCol] != MISSING_VALUE);
+            row[currentCol] = MISSING_VALUE;
+        }
+    }
+    return corrupted;
+}
+
+/**
+ * @brief Generates an ellipse hole at a random location.
+ * @param image The image to corrupt.
+ * @param maxSize The maximal width and height of the ellipse.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::generateEllipse(Image &image, const int maxSize)
+{
+    const int height = generateRandomNumber(1, std::max(maxSize, 1));
+    const int width = generateRandomNumber(1, std::max(maxSize, 1));
+    // The centre is a pixel, so every row of the ellipse contains it's column and the ellipse
+    // is connected.
+    const int centreRow = generateRandomNumber(INITIAL_ROW, image.getRows() - 1);
+    const int centreCol = generateRandomNumber(INITIAL_COLUMN, image.getCols() - 1);
+    return corruptEllipse(image, centreRow, centreCol, height / 2.0, width / 2.0);
+}
+
+/**
+ * @brief Generates a brush stroke hole, a random walk of a round brush from a random
+ *        location, which steps by half the brush radius so the stroke is connected.
+ * @param image The image to corrupt.
+ * @param maxSize The maximal width of the brush, the stroke is up to 4 times longer.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::generateBrushStroke(Image &image, const int maxSize)
+{
+    const int rows = image.getRows();
+    const int cols = image.getCols();
+    const int width = generateRandomNumber(1, std::max(maxSize, 1));
+    const int length = generateRandomNumber(width, BRUSH_LENGTH_RATIO * std::max(maxSize, 1));
+    const double radius = std::max(width / 2.0, 1.0);
+    // The brush is centred on pixels, and a step moves it by at most it's radius (or to an
+    // 8-neighbour, whose brush shares a 4-neighbour with it), so every brush overlaps the last.
+    const int step = std::max((int) (radius / 2), 1);
+    std::uniform_real_distribution<double> turnDist(-BRUSH_MAX_TURN, BRUSH_MAX_TURN);
+    double direction = std::uniform_real_distribution<double>(0, TWO_PI)(_generator);
+    int centreRow = generateRandomNumber(INITIAL_ROW, rows - 1);
+    int centreCol = generateRandomNumber(INITIAL_COLUMN, cols - 1);
+    size_t corrupted = corruptEllipse(image, centreRow, centreCol, radius, radius);
+    for (int walked = step; walked <= length; walked += step)
+    {
+        direction += turnDist(_generator);
+        centreRow += (int) std::lround(step * std::cos(direction));
+        centreCol += (int) std::lround(step * std::sin(direction));
+        // Keep the brush in the image, which moves it no further from the last brush.
+        centreRow = std::min(std::max(centreRow, INITIAL_ROW), rows - 1);
+        centreCol = std::min(std::max(centreCol, INITIAL_COLUMN), cols - 1);
+        corrupted += corruptEllipse(image, centreRow, centreCol, radius, radius);
+    }
+    return corrupted;
+}
+
+/**
+ * @brief Generates a pinhole, a single missing pixel at a random location.
+ * @param image The image to corrupt.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::generatePinhole(Image &image)
+{
+    const int row = generateRandomNumber(INITIAL_ROW, image.getRows() - 1);
+    const int col = generateRandomNumber(INITIAL_COLUMN, image.getCols() - 1);
+    const size_t corrupted = (image.at(row, col) != MISSING_VALUE);
+    image.at(row, col) = MISSING_VALUE;
+    return corrupted;
+}
+
+/**
+ * @brief Generates a hole of the given shape at a random location.
+ * @param image The image to corrupt.
+ * @param shape The shape of the hole.
+ * @param maxSize The maximal size of the hole, ignored by the pinholes.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::generateHole(Image &image, const HoleShape shape, const int maxSize)
+{
+    switch (shape)
+    {
+        case RECTANGLE_HOLE:
+            return generateRectangle(image, maxSize);
+        case ELLIPSE_HOLE:
+            return generateEllipse(image, maxSize);
+        case BRUSH_STROKE_HOLE:
+            return generateBrushStroke(image, maxSize);
+        default:
+            return generatePinhole(image);
+    }
+}
+
+/**
+ * @brief Generates holes of the given shape until the given fraction of the image is
+ *        missing. The holes may overlap, and the missing pixels of the image count as well.
+ * @param image The image to corrupt.
+ * @param shape The shape of the holes.
+ * @param maxSize The maximal size of a hole, ignored by the pinholes.
+ * @param coverage The fraction of the missing pixels, in [0,1].
+ * @return The number of holes generated.
+ */
+size_t HoleGenerator::generateHoles(Image &image, const HoleShape shape, const int maxSize,
+                                    const double coverage)
+{
+    const size_t pixelCount = (size_t) image.getRows() * image.getCols();
+    const size_t target = (size_t) std::ceil(std::min(std::max(coverage, 0.0), 1.0) * pixelCount);
+    size_t missing = 0;
+    for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+    {
+        const float *row = image.getRow(x);
+        missing += std::count(row, row + image.getCols(), MISSING_VALUE);
+    }
+    size_t holeCount = 0;
+    while (missing < target)
+    {
+        missing += generateHole(image, shape, maxSize);
+        ++holeCount;
+    }
+    return holeCount;
+}
+
+/**
+ * @brief Corrupts the pixels of an axis-aligned ellipse, clipped to the image.
+ * @param image The image to corrupt.
+ * @param centreX The row of the centre.
+ * @param centreY The column of the centre.
+ * @param radiusX The radius along the rows.
+ * @param radiusY The radius along the columns.
+ * @return The number of pixels which became missing.
+ */
+size_t HoleGenerator::corruptEllipse(Image &image, const double centreX, const double centreY,
+                                     const double radiusX, const double radiusY)
+{
+    const int firstRow = std::max((int) std::ceil(centreX - radiusX), INITIAL_ROW);
+    const int lastRow = std::min((int) std::floor(centreX + radiusX), image.getRows() - 1);
+    size_t corrupted = 0;
+    for (int x = firstRow; x <= lastRow; ++x)
+    {
+        const double dx = (x - centreX) / radiusX;
+        const double halfWidth = radiusY * std::sqrt(std::max(1 - dx * dx, 0.0));
+        const int firstCol = std::max((int) std::ceil(centreY - halfWidth), INITIAL_COLUMN);
+        const int lastCol = std::min((int) std::floor(centreY + halfWidth), image.getCols() - 1);
+        float *row = image.getRow(x);
+        for (int y = firstCol; y <= lastCol; ++y)
+        {
+            corrupted += (row[y] != MISSING_VALUE);
+            row[y] = MISSING_VALUE;
+        }
+    }
+    return corrupted;
+}
\ No newline at end of file
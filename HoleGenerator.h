@@ -0,0 +1,150 @@
+/**
+ * @file HoleGenerator.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the HoleGenerator Class.
+ */
+
+
+#ifndef HOLEGENERATOR_H
+#define HOLEGENERATOR_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <random>
+#include "Pixel.h"
+#include "Image.h"
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The shapes of the synthetic holes.
+ */
+enum HoleShape
+{
+    RECTANGLE_HOLE,  // An axis-aligned rectangle.
+    ELLIPSE_HOLE,  // An axis-aligned ellipse.
+    BRUSH_STROKE_HOLE,  // A random walk of a round brush.
+    PINHOLE_HOLE  // A single missing pixel.
+};
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class which corrupts images by generating holes of missing pixels in them. All the
+ *        random holes are drawn from a single engine seeded once, so the holes of a seed are
+ *        reproducible and generating a hole doesn't create a new engine. The shaped holes are
+ *        clipped to the image, their cost is the number of pixels they corrupt, and they
+ *        return the number of pixels which became missing, so many holes can be generated in
+ *        an image up to a coverage target (see generateHoles).
+ */
+class HoleGenerator
+{
+public:
+    /**
+     * @brief A Constructor for the HoleGenerator.
+     * @param seed The seed of the random engine.
+     */
+    explicit HoleGenerator(const unsigned int seed);
+
+    /**
+     * @brief Generates a random number from the range [lowerBound,upperBound].
+     * @param lowerBound The lower bound of the range.
+     * @param upperBound The upper bound of the range.
+     * @return a random integer from the range [lowerBound,upperBound].
+     */
+    int generateRandomNumber(const int lowerBound, const int upperBound);
+
+    /**
+     * @brief Generates random hole in a shape of a rectangle.
+     * @param image The image to corrupt.
+     */
+    void generateRandomHole(Image &image);
+
+    /**
+     * @brief Generates a rectangle hole at a random location.
+     * @param image The image to corrupt.
+     * @param maxSize The maximal number of rows and columns of the rectangle.
+     * @return The number of pixels which became missing.
+     */
+    size_t generateRectangle(Image &image, const int maxSize);
+
+    /**
+     * @brief Generates an ellipse hole at a random location.
+     * @param image The image to corrupt.
+     * @param maxSize The maximal width and height of the ellipse.
+     * @return The number of pixels which became missing.
+     */
+    size_t generateEllipse(Image &image, const int maxSize);
+
+    /**
+     * @brief Generates a brush stroke hole, a random walk of a round brush from a random
+     *        location, which steps by half the brush radius so the stroke is connected.
+     * @param image The image to corrupt.
+     * @param maxSize The maximal width of the brush, the stroke is up to 4 times longer.
+     * @return The number of pixels which became missing.
+     */
+    size_t generateBrushStroke(Image &image, const int maxSize);
+
+    /**
+     * @brief Generates a pinhole, a single missing pixel at a random location.
+     * @param image The image to corrupt.
+     * @return The number of pixels which became missing.
+     */
+    size_t generatePinhole(Image &image);
+
+    /**
+     * @brief Generates a hole of the given shape at a random location.
+     * @param image The image to corrupt.
+     * @param shape The shape of the hole.
+     * @param maxSize The maximal size of the hole, ignored by the pinholes.
+     * @return The number of pixels which became missing.
+     */
+    size_t generateHole(Image &image, const HoleShape shape, const int maxSize);
+
+    /**
+     * @brief Generates holes of the given shape until the given fraction of the image is
+     *        missing. The holes may overlap, and the missing pixels of the image count as well.
+     * @param image The image to corrupt.
+     * @param shape The shape of the holes.
+     * @param maxSize The maximal size of a hole, ignored by the pinholes.
+     * @param coverage The fraction of the missing pixels, in [0,1].
+     * @return The number of holes generated.
+     */
+    size_t generateHoles(Image &image, const HoleShape shape, const int maxSize,
+                         const double coverage);
+
+    /**
+     * @brief Generate hole in the image from a given array of pixels.
+     * @param image The image to corrupt.
+     * @param holePixels The array of pixels which describe the hole.
+     * @param holeSize The number of pixels in the hole.
+     */
+    static void generateDefinedHole(Image &image, const Pixel *holePixels, const int holeSize);
+
+private:
+    /**
+     * @brief Corrupts the pixels of an axis-aligned ellipse, clipped to the image.
+     * @param image The image to corrupt.
+     * @param centreX The row of the centre.
+     * @param centreY The column of the centre.
+     * @param radiusX The radius along the rows.
+     * @param radiusY The radius along the columns.
+     * @return The number of pixels which became missing.
+     */
+    static size_t corruptEllipse(Image &image, const double centreX, const double centreY,
+                                 const double radiusX, const double radiusY);
+
+    std::mt19937 _generator;  // The random engine of the holes.
+
+};
+
+
+#endif
\ No newline at end of file
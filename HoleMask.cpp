@@ -0,0 +1,131 @@
+/**
+ * @file HoleMask.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the HoleMask Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include "HoleMask.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Default Constructor for the HoleMask which creates an empty mask.
+ */
+HoleMask::HoleMask() : _rows(0), _cols(0), _rowWords(0)
+{
+
+}
+
+/**
+ * @brief A Constructor for the HoleMask, which creates a mask of the given size without
+ *        missing pixels.
+ * @param rows The number of rows in the mask.
+ * @param cols The number of columns in the mask.
+ */
+HoleMask::HoleMask(const int rows, const int cols) : _rows(0), _cols(0), _rowWords(0)
+{
+    reset(rows, cols);
+}
+
+/**
+ * @brief Creates the mask of the missing pixels of the given image, i.e. the pixels whose
+ *        value is MISSING_VALUE.
+ * @param image The image with the missing pixels in it.
+ * @return The mask of the missing pixels.
+ */
+HoleMask HoleMask::fromImage(const Image &image)
+{
+    HoleMask mask;
+    mask.assign(image);
+    return mask;
+}
+
+/**
+ * @brief Creates the mask of the given mask image, where a pixel is missing iff its value
+ *        is not 0. This reads both 1-bit and 8-bit masks, as 1-bit masks are decoded to
+ *        the values 0 and 255.
+ * @param maskImage The mask image.
+ * @return The mask of the missing pixels.
+ */
+HoleMask HoleMask::fromMaskImage(const ByteImage &maskImage)
+{
+    HoleMask mask;
+    mask.assign(maskImage);
+    return mask;
+}
+
+/**
+ * @brief Resizes the mask to the given size without missing pixels, reusing its words.
+ * @param rows The number of rows in the mask.
+ * @param cols The number of columns in the mask.
+ */
+void HoleMask::reset(const int rows, const int cols)
+{
+    _rows = rows;
+    _cols = cols;
+    _rowWords = ((size_t) cols + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+    _words.assign((size_t) rows * _rowWords, 0);
+}
+
+/**
+ * @brief Sets the mask to the missing pixels of the given image, see fromImage. The words
+ *        of the mask are reused, so a mask can be set for many images without allocations.
+ * @param image The image with the missing pixels in it.
+ */
+void HoleMask::assign(const Image &image)
+{
+    INSTRUMENT_SCOPE("findMissingPixels");
+    reset(image.getRows(), image.getCols());
+    for (int x = INITIAL_ROW; x < _rows; ++x)
+    {
+        const float *row = image.getRow(x);
+        uint64_t *words = _words.data() + x * _rowWords;
+        for (int y = INITIAL_COLUMN; y < _cols; ++y)
+        {
+            words[y / MASK_WORD_BITS] |= (uint64_t) (row[y] == MISSING_VALUE) <<
+                                         (y % MASK_WORD_BITS);
+        }
+    }
+}
+
+/**
+ * @brief Sets the mask to the given mask image, see fromMaskImage. The words of the mask are
+ *        reused, so a mask can be set for many images without allocations.
+ * @param maskImage The mask image.
+ */
+void HoleMask::assign(const ByteImage &maskImage)
+{
+    INSTRUMENT_SCOPE("findMissingPixels");
+    reset(maskImage.getRows(), maskImage.getCols());
+    for (int x = INITIAL_ROW; x < _rows; ++x)
+    {
+        const unsigned char *row = maskImage.getRow(x);
+        uint64_t *words = _words.data() + x * _rowWords;
+        for (int y = INITIAL_COLUMN; y < _cols; ++y)
+        {
+            words[y / MASK_WORD_BITS] |= (uint64_t) (row[y] != 0) << (y % MASK_WORD_BITS);
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of missing pixels in the mask.
+ * @return The number of missing pixels.
+ */
+size_t HoleMask::countMissing() const
+{
+    size_t missingCount = 0;
+    for (const uint64_t word : _words)
+    {
+        missingCount += (size_t) __builtin_popcountll(word);
+    }
+    return missingCount;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file HoleMask.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the HoleMask Class.
+ */
+
+
+#ifndef HOLEMASK_H
+#define HOLEMASK_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Image.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MASK_WORD_BITS 64
+ * @brief A Macro that sets the number of pixels in a single word of the mask.
+ */
+#define MASK_WORD_BITS 64
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing the missing pixels of an image as a packed bitset, where bit y%64
+ *        of word y/64 of a row is set iff pixel y of the row is missing. Every row starts at a
+ *        new word, and the bits after the last column are always clear, so the scans of the
+ *        holes skip a word of 64 known pixels at once instead of comparing every pixel.
+ */
+class HoleMask
+{
+public:
+    /**
+     * @brief A Default Constructor for the HoleMask which creates an empty mask.
+     */
+    HoleMask();
+
+    /**
+     * @brief A Constructor for the HoleMask, which creates a mask of the given size without
+     *        missing pixels.
+     * @param rows The number of rows in the mask.
+     * @param cols The number of columns in the mask.
+     */
+    HoleMask(const int rows, const int cols);
+
+    /**
+     * @brief Creates the mask of the missing pixels of the given image, i.e. the pixels whose
+     *        value is MISSING_VALUE.
+     * @param image The image with the missing pixels in it.
+     * @return The mask of the missing pixels.
+     */
+    static HoleMask fromImage(const Image &image);
+
+    /**
+     * @brief Creates the mask of the given mask image, where a pixel is missing iff its value
+     *        is not 0. This reads both 1-bit and 8-bit masks, as 1-bit masks are decoded to
+     *        the values 0 and 255.
+     * @param maskImage The mask image.
+     * @return The mask of the missing pixels.
+     */
+    static HoleMask fromMaskImage(const ByteImage &maskImage);
+
+    /**
+     * @brief Sets the mask to the missing pixels of the given image, see fromImage. The words
+     *        of the mask are reused, so a mask can be set for many images without allocations.
+     * @param image The image with the missing pixels in it.
+     */
+    void assign(const Image &image);
+
+    /**
+     * @brief Sets the mask to the given mask image, see fromMaskImage. The words of the mask are
+     *        reused, so a mask can be set for many images without allocations.
+     * @param maskImage The mask image.
+     */
+    void assign(const ByteImage &maskImage);
+
+    /**
+     * @brief Returns the number of rows in the mask.
+     * @return The number of rows in the mask.
+     */
+    int getRows() const { return _rows; }
+
+    /**
+     * @brief Returns the number of columns in the mask.
+     * @return The number of columns in the mask.
+     */
+    int getCols() const { return _cols; }
+
+    /**
+     * @brief Returns the number of words in every row of the mask.
+     * @return The number of words in a row.
+     */
+    size_t getRowWords() const { return _rowWords; }
+
+    /**
+     * @brief Returns a pointer to the words of the given row.
+     * @param x The row number.
+     * @return A pointer to the first word of the row.
+     */
+    const uint64_t *getRow(const int x) const { return _words.data() + x * _rowWords; }
+
+    /**
+     * @brief Returns whether the pixel at the given coordinates is missing.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     * @return true if the pixel is missing, false otherwise.
+     */
+    bool isMissing(const int x, const int y) const
+    {
+        return (getRow(x)[y / MASK_WORD_BITS] >> (y % MASK_WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief Sets the pixel at the given coordinates as missing.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     */
+    void setMissing(const int x, const int y)
+    {
+        _words[x * _rowWords + y / MASK_WORD_BITS] |= (uint64_t) 1 << (y % MASK_WORD_BITS);
+    }
+
+    /**
+     * @brief Returns the number of missing pixels in the mask.
+     * @return The number of missing pixels.
+     */
+    size_t countMissing() const;
+
+private:
+    /**
+     * @brief Resizes the mask to the given size without missing pixels, reusing its words.
+     * @param rows The number of rows in the mask.
+     * @param cols The number of columns in the mask.
+     */
+    void reset(const int rows, const int cols);
+
+    std::vector<uint64_t> _words;  // The words of the rows, row after row.
+    int _rows;  // The number of rows in the mask.
+    int _cols;  // The number of columns in the mask.
+    size_t _rowWords;  // The number of words in every row.
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * @file HoleSchedule.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the HoleSchedule Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include "HoleSchedule.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief Schedules the given holes on the given number of threads.
+ * @param holes The holes in the image.
+ * @param excludedHoles The holes which are filled elsewhere (e.g. on the GPU), by their
+ *        order in the holes.
+ * @param threadCount The number of threads of the fill.
+ * @param minSplitCost The minimal cost of a hole which is split, 0 to split every hole.
+ */
+void HoleSchedule::assign(const std::vector<Hole> &holes,
+                          const std::vector<const Hole*> &excludedHoles,
+                          const unsigned int threadCount, const double minSplitCost)
+{
+    _splitHoles.clear();
+    _batchedHoles.clear();
+    _batchStarts.clear();
+
+    double totalCost = 0;
+    size_t nextExcludedHole = 0;
+    for (const Hole &hole : holes)
+    {
+        if (nextExcludedHole < excludedHoles.size() && excludedHoles[nextExcludedHole] == &hole)
+        {
+            ++nextExcludedHole;
+            continue;
+        }
+        if (hole.getHoleSize() != 0)
+        {
+            _batchedHoles.push_back(&hole);
+            totalCost += getCost(hole);
+        }
+    }
+
+    // A hole which would take more than the share of a thread on its own is split as well,
+    // since the other threads would wait for it at the end of the batches.
+    const double threadShare = totalCost / std::max(threadCount, 1u);
+    auto isSplit = [&](const Hole *hole)
+    {
+        const double cost = getCost(*hole);
+        return cost >= minSplitCost || (threadCount > 1 && cost >= threadShare);
+    };
+    std::stable_sort(_batchedHoles.begin(), _batchedHoles.end(), [](const Hole *lhs,
+                                                                     const Hole *rhs)
+    {
+        return getCost(*lhs) > getCost(*rhs);
+    });
+    auto firstBatched = std::find_if_not(_batchedHoles.begin(), _batchedHoles.end(), isSplit);
+    _splitHoles.assign(_batchedHoles.begin(), firstBatched);
+    _batchedHoles.erase(_batchedHoles.begin(), firstBatched);
+
+    double batchCost = 0;
+    for (size_t i = 0; i < _batchedHoles.size(); ++i)
+    {
+        if (i == 0 || batchCost >= SCHEDULE_BATCH_PAIRS)
+        {
+            _batchStarts.push_back(i);
+            batchCost = 0;
+        }
+        batchCost += getCost(*_batchedHoles[i]);
+    }
+    _batchStarts.push_back(_batchedHoles.size());
+    if (_batchedHoles.empty())
+    {
+        _batchStarts.clear();
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file HoleSchedule.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the HoleSchedule Class.
+ */
+
+
+#ifndef HOLESCHEDULE_H
+#define HOLESCHEDULE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Hole.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def SCHEDULE_SPLIT_PAIRS 262144
+ * @brief A Macro that sets the minimal number of hole and boundary pixel pairs of a hole which
+ *        is split across the threads. It is far below the pairs of a hole which is filled as
+ *        a convolution or on the GPU, so the batched holes are always filled directly.
+ */
+#define SCHEDULE_SPLIT_PAIRS 262144
+
+/**
+ * @def SCHEDULE_BATCH_PAIRS 65536
+ * @brief A Macro that sets the number of hole and boundary pixel pairs above which a batch of
+ *        small holes is closed, so a thread takes thousands of tiny holes in a few tasks.
+ */
+#define SCHEDULE_BATCH_PAIRS 65536
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing the order in which the independent holes of an image are filled
+ *        by a pool of threads, by the cost of every hole (its number of hole and boundary pixel
+ *        pairs, i.e. the work of the exact fill). A hole which costs enough to keep all the
+ *        threads busy, or a large share of the image, is split: it is filled by all the threads
+ *        together. The other holes are batched: they are sorted by descending cost and grouped
+ *        into batches of about SCHEDULE_BATCH_PAIRS, and every batch is filled by a single
+ *        thread, which takes the next batch once it is done. The costly batches come first, so
+ *        the cheap batches at the end even out the threads.
+ *        The schedule keeps its buffers, so it is reused by the fills of many images.
+ */
+class HoleSchedule
+{
+public:
+    /**
+     * @brief Returns the estimated cost of filling the given hole, i.e. the number of pairs of
+     *        a hole pixel and a boundary pixel.
+     * @param hole The hole.
+     * @return The estimated cost of the hole.
+     */
+    static double getCost(const Hole &hole)
+    {
+        return (double) hole.getHoleSize() * hole.getHoleBoundary().size();
+    }
+
+    /**
+     * @brief Schedules the given holes on the given number of threads.
+     * @param holes The holes in the image.
+     * @param excludedHoles The holes which are filled elsewhere (e.g. on the GPU), by their
+     *        order in the holes.
+     * @param threadCount The number of threads of the fill.
+     * @param minSplitCost The minimal cost of a hole which is split, 0 to split every hole.
+     */
+    void assign(const std::vector<Hole> &holes, const std::vector<const Hole*> &excludedHoles,
+                const unsigned int threadCount, const double minSplitCost = SCHEDULE_SPLIT_PAIRS);
+
+    /**
+     * @brief Returns the holes which are filled by all the threads, by descending cost.
+     * @return The split holes.
+     */
+    const std::vector<const Hole*> &getSplitHoles() const { return _splitHoles; }
+
+    /**
+     * @brief Returns the number of batches of small holes.
+     * @return The number of batches.
+     */
+    size_t getBatchCount() const { return _batchStarts.empty() ? 0 : _batchStarts.size() - 1; }
+
+    /**
+     * @brief Returns the first hole of the given batch.
+     * @param batch The index of the batch.
+     * @return A pointer to the first hole of the batch.
+     */
+    const Hole* const *batchBegin(const size_t batch) const
+    {
+        return _batchedHoles.data() + _batchStarts[batch];
+    }
+
+    /**
+     * @brief Returns the end of the holes of the given batch.
+     * @param batch The index of the batch.
+     * @return A pointer past the last hole of the batch.
+     */
+    const Hole* const *batchEnd(const size_t batch) const
+    {
+        return _batchedHoles.data() + _batchStarts[batch + 1];
+    }
+
+private:
+    std::vector<const Hole*> _splitHoles;  // The holes filled by all the threads.
+    std::vector<const Hole*> _batchedHoles;  // The holes filled by a single thread.
+    std::vector<size_t> _batchStarts;  // Batch k is [_batchStarts[k], _batchStarts[k+1]).
+
+};
+
+
+#endif
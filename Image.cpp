@@ -0,0 +1,117 @@
+/**
+ * @file Image.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the Image Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <utility>
+#include "Image.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Default Constructor for the Image which creates an empty image.
+ */
+template <typename T>
+BasicImage<T>::BasicImage() : _data(nullptr), _rows(0), _cols(0), _stride(0)
+{
+
+}
+
+/**
+ * @brief A Constructor for the Image, which allocates a new zero initialized buffer
+ *        of the given size owned by this image.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ */
+template <typename T>
+BasicImage<T>::BasicImage(const int rows, const int cols) : _buffer((size_t) rows * cols, 0),
+                                                            _data(_buffer.data()), _rows(rows),
+                                                            _cols(cols), _stride((size_t) cols)
+{
+
+}
+
+/**
+ * @brief A Constructor for the Image, which wraps a given external buffer without copying it.
+ * @param data The external buffer of the image.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ * @param stride The number of values between the beginning of two consecutive rows.
+ */
+template <typename T>
+BasicImage<T>::BasicImage(T *data, const int rows, const int cols, const size_t stride) :
+        _data(data), _rows(rows), _cols(cols), _stride(stride)
+{
+
+}
+
+/**
+ * @brief A Move Constructor for the Image.
+ * @param other The image to move from.
+ */
+template <typename T>
+BasicImage<T>::BasicImage(BasicImage &&other) : _buffer(std::move(other._buffer)),
+                                                _data(other._data), _rows(other._rows),
+                                                _cols(other._cols), _stride(other._stride)
+{
+    other._data = nullptr;
+    other._rows = 0;
+    other._cols = 0;
+    other._stride = 0;
+}
+
+/**
+ * @brief Move assignment operator for the Image.
+ * @param other The image to move from.
+ * @return A reference to this image.
+ */
+template <typename T>
+BasicImage<T>& BasicImage<T>::operator=(BasicImage &&other)
+{
+    if (this != &other)
+    {
+        _buffer = std::move(other._buffer);
+        _data = other._data;
+        _rows = other._rows;
+        _cols = other._cols;
+        _stride = other._stride;
+        other._data = nullptr;
+        other._rows = 0;
+        other._cols = 0;
+        other._stride = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Creates a deep copy of this image, which owns a contiguous buffer.
+ * @return The copied image.
+ */
+template <typename T>
+BasicImage<T> BasicImage<T>::clone() const
+{
+    BasicImage copiedImage(_rows, _cols);
+    for (int x = 0; x < _rows; ++x)
+    {
+        const T *sourceRow = getRow(x);
+        std::copy(sourceRow, sourceRow + _cols, copiedImage.getRow(x));
+    }
+    return copiedImage;
+}
+
+
+/*-----=  Explicit Instantiations  =-----*/
+
+
+template class BasicImage<float>;
+template class BasicImage<unsigned short>;
+template class BasicImage<unsigned char>;
\ No newline at end of file
@@ -0,0 +1,244 @@
+/**
+ * @file Image.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the Image Class.
+ */
+
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "Pixel.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MISSING_VALUE -1
+ * @brief A Macro that sets the value of a missing pixel.
+ */
+#define MISSING_VALUE (-1)
+
+/**
+ * @def INITIAL_ROW 0
+ * @brief A Macro that sets the value of the first row coordinate in the image.
+ */
+#define INITIAL_ROW 0
+
+/**
+ * @def INITIAL_COLUMN 0
+ * @brief A Macro that sets the value of the first column coordinate in the image.
+ */
+#define INITIAL_COLUMN 0
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a single channel image of values of the given type, stored as one
+ *        contiguous row-major buffer with a stride (the number of values between two consecutive
+ *        rows). The image either owns its buffer, or wraps an external buffer (e.g. the data of
+ *        a CV Mat object) without copying it, in which case the external buffer must outlive
+ *        the image.
+ * @tparam T The type of the pixel values, float, unsigned short or unsigned char.
+ */
+template <typename T>
+class BasicImage
+{
+public:
+    /**
+     * @brief A Default Constructor for the Image which creates an empty image.
+     */
+    BasicImage();
+
+    /**
+     * @brief A Constructor for the Image, which allocates a new zero initialized buffer
+     *        of the given size owned by this image.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     */
+    BasicImage(const int rows, const int cols);
+
+    /**
+     * @brief A Constructor for the Image, which wraps a given external buffer without copying it.
+     * @param data The external buffer of the image.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     * @param stride The number of values between the beginning of two consecutive rows.
+     */
+    BasicImage(T *data, const int rows, const int cols, const size_t stride);
+
+    /**
+     * @brief A Move Constructor for the Image.
+     * @param other The image to move from.
+     */
+    BasicImage(BasicImage &&other);
+
+    /**
+     * @brief Move assignment operator for the Image.
+     * @param other The image to move from.
+     * @return A reference to this image.
+     */
+    BasicImage& operator=(BasicImage &&other);
+
+    /**
+     * @brief Images are not copied implicitly, use clone() for an explicit deep copy.
+     */
+    BasicImage(const BasicImage &other) = delete;
+
+    /**
+     * @brief Images are not copied implicitly, use clone() for an explicit deep copy.
+     */
+    BasicImage& operator=(const BasicImage &other) = delete;
+
+    /**
+     * @brief Creates a deep copy of this image, which owns a contiguous buffer.
+     * @return The copied image.
+     */
+    BasicImage clone() const;
+
+    /**
+     * @brief Returns the number of rows in the image.
+     * @return The number of rows in the image.
+     */
+    int getRows() const { return _rows; }
+
+    /**
+     * @brief Returns the number of columns in the image.
+     * @return The number of columns in the image.
+     */
+    int getCols() const { return _cols; }
+
+    /**
+     * @brief Returns the number of values between the beginning of two consecutive rows.
+     * @return The stride of the image.
+     */
+    size_t getStride() const { return _stride; }
+
+    /**
+     * @brief Returns a pointer to the beginning of the given row.
+     * @param x The row number.
+     * @return A pointer to the first pixel in the row.
+     */
+    T *getRow(const int x) { return _data + x * _stride; }
+
+    /**
+     * @brief Returns a pointer to the beginning of the given row.
+     * @param x The row number.
+     * @return A pointer to the first pixel in the row.
+     */
+    const T *getRow(const int x) const { return _data + x * _stride; }
+
+    /**
+     * @brief Returns the value of the pixel at the given coordinates.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     * @return A reference to the pixel value.
+     */
+    T &at(const int x, const int y) { return _data[x * _stride + y]; }
+
+    /**
+     * @brief Returns the value of the pixel at the given coordinates.
+     * @param x The X coordinate of the pixel.
+     * @param y The Y coordinate of the pixel.
+     * @return A reference to the pixel value.
+     */
+    const T &at(const int x, const int y) const { return _data[x * _stride + y]; }
+
+    /**
+     * @brief Returns the value of the given pixel.
+     * @param pixel The pixel in the image.
+     * @return A reference to the pixel value.
+     */
+    T &at(const Pixel &pixel) { return at(pixel.getX(), pixel.getY()); }
+
+    /**
+     * @brief Returns the value of the given pixel.
+     * @param pixel The pixel in the image.
+     * @return A reference to the pixel value.
+     */
+    const T &at(const Pixel &pixel) const { return at(pixel.getX(), pixel.getY()); }
+
+private:
+    std::vector<T> _buffer;  // The owned buffer, empty when wrapping an external buffer.
+    T *_data;  // The first pixel of the image.
+    int _rows;  // The number of rows in the image.
+    int _cols;  // The number of columns in the image.
+    size_t _stride;  // The number of values between two consecutive rows.
+
+};
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A Type Definition for an image of floats, the image the fill works on by default.
+ */
+typedef BasicImage<float> Image;
+
+/**
+ * @brief A Type Definition for an image of 16-bit values, e.g. the native data of a CV_16U Mat
+ *        object.
+ */
+typedef BasicImage<unsigned short> ShortImage;
+
+/**
+ * @brief A Type Definition for an image of bytes, e.g. the native data of a CV_8U Mat object.
+ */
+typedef BasicImage<unsigned char> ByteImage;
+
+
+/*-----=  Value Conversion Functions  =-----*/
+
+
+/**
+ * @brief Converts a filled value to a pixel value of the given type.
+ * @tparam T The type of the pixel values.
+ * @param value The filled value.
+ * @return The pixel value.
+ */
+template <typename T>
+inline T toPixelValue(const float value)
+{
+    return value;
+}
+
+/**
+ * @brief Converts a filled value to a byte pixel value, rounded to the nearest byte. A filled
+ *        value is a weighted mean of byte values, but it is clamped against rounding errors.
+ * @param value The filled value.
+ * @return The pixel value.
+ */
+template <>
+inline unsigned char toPixelValue<unsigned char>(const float value)
+{
+    return (unsigned char) std::min(std::max(std::lround(value), 0L), 255L);
+}
+
+/**
+ * @brief Converts a filled value to a 16-bit pixel value, rounded to the nearest integer. A
+ *        filled value is a weighted mean of 16-bit values, but it is clamped against rounding
+ *        errors.
+ * @param value The filled value.
+ * @return The pixel value.
+ */
+template <>
+inline unsigned short toPixelValue<unsigned short>(const float value)
+{
+    return (unsigned short) std::min(std::max(std::lround(value), 0L), 65535L);
+}
+
+
+#endif
\ No newline at end of file
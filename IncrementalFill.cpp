@@ -0,0 +1,428 @@
+/**
+ * @file IncrementalFill.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the IncrementalFill Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include "IncrementalFill.h"
+#include "WeightFunctions.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def NO_SLOT -1
+ * @brief A Macro that sets the slot of a pixel which isn't in the hole or in the boundary.
+ */
+#define NO_SLOT (-1)
+
+/**
+ * @def MAX_INTEGER_Z 4
+ * @brief A Macro that sets the maximal integer z value with a compile time weighted function.
+ */
+#define MAX_INTEGER_Z 4
+
+/**
+ * @def FILL_CHUNK_SIZE 64
+ * @brief A Macro that sets the number of new hole pixels filled by a single task of a thread.
+ */
+#define FILL_CHUNK_SIZE 64
+
+/**
+ * @def DELTA_CHUNK_SIZE 1024
+ * @brief A Macro that sets the number of hole pixels updated by the changes of the boundary
+ *        in a single task of a thread, which is larger since a change is a few pixels.
+ */
+#define DELTA_CHUNK_SIZE 1024
+
+
+/*-----=  Static Functions  =-----*/
+
+
+/**
+ * @brief Visits the neighbours of the given pixel in the image by the given connectivity.
+ * @tparam Visitor The type of the visitor, a callable object with the signature
+ *         void(int x, int y).
+ * @param pixel The pixel.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ * @param connectivity The pixel connectivity value.
+ * @param visitor The visitor of the neighbours.
+ */
+template <typename Visitor>
+static void visitNeighbours(const Pixel &pixel, const int rows, const int cols,
+                            const int connectivity, const Visitor &visitor)
+{
+    if (connectivity == 8)
+    {
+        forEachNeighbour<8>(pixel, rows, cols, visitor);
+    }
+    else
+    {
+        forEachNeighbour<4>(pixel, rows, cols, visitor);
+    }
+}
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the IncrementalFill. The missing pixels of the image are the
+ *        initial hole, which is filled entirely.
+ * @param image The image, which is copied.
+ * @param config The parameters of the fill.
+ * @param threadCount The number of threads used in the fill, 0 for all the hardware threads.
+ */
+IncrementalFill::IncrementalFill(const Image &image, const FillConfig &config,
+                                 const unsigned int threadCount) :
+        _config(config), _threadPool(threadCount), _original(image.clone()),
+        _image(image.clone()), _kernel(config.epsilon, config.z)
+{
+    const size_t pixelCount = (size_t) image.getRows() * image.getCols();
+    _holeSlots.assign(pixelCount, NO_SLOT);
+    _boundarySlots.assign(pixelCount, NO_SLOT);
+    _holeNeighbours.assign(pixelCount, 0);
+    std::vector<Pixel> missingPixels;
+    for (int x = INITIAL_ROW; x < image.getRows(); ++x)
+    {
+        for (int y = INITIAL_COLUMN; y < image.getCols(); ++y)
+        {
+            if (image.at(x, y) == MISSING_VALUE)
+            {
+                missingPixels.emplace_back(x, y);
+            }
+        }
+    }
+    addHolePixels(missingPixels);
+}
+
+/**
+ * @brief Adds the given pixels to the hole and updates the fill. Pixels which are already
+ *        in the hole are skipped.
+ * @param pixels The pixels to add, inside the image.
+ */
+void IncrementalFill::addHolePixels(const std::vector<Pixel> &pixels)
+{
+    INSTRUMENT_SCOPE("addHolePixels");
+    const size_t firstNewPixel = _holePixels.size();
+    for (const Pixel &pixel : pixels)
+    {
+        const size_t index = getIndex(pixel);
+        if (_holeSlots[index] != NO_SLOT)
+        {
+            continue;
+        }
+        if (_boundarySlots[index] != NO_SLOT)
+        {
+            // A boundary pixel which becomes missing leaves the boundary.
+            removeBoundaryPixel(pixel);
+        }
+        _holeSlots[index] = (int) _holePixels.size();
+        _holePixels.push_back(pixel);
+        _numerators.push_back(0);
+        _denominators.push_back(0);
+    }
+
+    // The known neighbours of the new hole pixels join the boundary.
+    for (size_t i = firstNewPixel; i < _holePixels.size(); ++i)
+    {
+        visitNeighbours(_holePixels[i], _original.getRows(), _original.getCols(),
+                        _config.connectivity, [&](const int x, const int y)
+        {
+            const Pixel neighbour(x, y);
+            const size_t index = getIndex(neighbour);
+            ++_holeNeighbours[index];
+            if (_holeSlots[index] == NO_SLOT && _boundarySlots[index] == NO_SLOT)
+            {
+                addBoundaryPixel(neighbour);
+            }
+        });
+    }
+    refill(firstNewPixel);
+}
+
+/**
+ * @brief Removes the given pixels from the hole, which get their values of the image back,
+ *        and updates the fill. Pixels which aren't in the hole, or which are missing in the
+ *        image itself, are skipped.
+ * @param pixels The pixels to remove, inside the image.
+ */
+void IncrementalFill::removeHolePixels(const std::vector<Pixel> &pixels)
+{
+    INSTRUMENT_SCOPE("removeHolePixels");
+    std::vector<Pixel> removedPixels;
+    for (const Pixel &pixel : pixels)
+    {
+        const size_t index = getIndex(pixel);
+        if (_holeSlots[index] == NO_SLOT || _original.at(pixel) == MISSING_VALUE)
+        {
+            continue;
+        }
+        // Move the last hole pixel to the slot of the removed pixel.
+        const int slot = _holeSlots[index];
+        _holePixels[slot] = _holePixels.back();
+        _numerators[slot] = _numerators.back();
+        _denominators[slot] = _denominators.back();
+        _holeSlots[getIndex(_holePixels[slot])] = slot;
+        _holePixels.pop_back();
+        _numerators.pop_back();
+        _denominators.pop_back();
+        _holeSlots[index] = NO_SLOT;
+        _image.at(pixel) = _original.at(pixel);
+        removedPixels.push_back(pixel);
+    }
+
+    // The boundary pixels which no longer neighbour the hole leave the boundary, and the
+    // removed pixels which still neighbour it join the boundary.
+    for (const Pixel &pixel : removedPixels)
+    {
+        visitNeighbours(pixel, _original.getRows(), _original.getCols(), _config.connectivity,
+                        [&](const int x, const int y)
+        {
+            const Pixel neighbour(x, y);
+            const size_t index = getIndex(neighbour);
+            if (--_holeNeighbours[index] == 0 && _boundarySlots[index] != NO_SLOT)
+            {
+                removeBoundaryPixel(neighbour);
+            }
+        });
+    }
+    for (const Pixel &pixel : removedPixels)
+    {
+        if (_holeNeighbours[getIndex(pixel)] > 0)
+        {
+            addBoundaryPixel(pixel);
+        }
+    }
+    refill(_holePixels.size());
+}
+
+/**
+ * @brief Adds the given known pixel to the boundary, and to the pixels which joined it.
+ * @param pixel The pixel.
+ */
+void IncrementalFill::addBoundaryPixel(const Pixel &pixel)
+{
+    _boundarySlots[getIndex(pixel)] = (int) _boundaryPixels.size();
+    _boundaryPixels.push_back(pixel);
+    _joinedBoundary.push_back(pixel);
+}
+
+/**
+ * @brief Removes the given pixel from the boundary, and adds it to the pixels which left it.
+ * @param pixel The pixel, in the boundary.
+ */
+void IncrementalFill::removeBoundaryPixel(const Pixel &pixel)
+{
+    // Move the last boundary pixel to the slot of the removed pixel.
+    const size_t index = getIndex(pixel);
+    const int slot = _boundarySlots[index];
+    _boundaryPixels[slot] = _boundaryPixels.back();
+    _boundarySlots[getIndex(_boundaryPixels[slot])] = slot;
+    _boundaryPixels.pop_back();
+    _boundarySlots[index] = NO_SLOT;
+    _leftBoundary.push_back(pixel);
+}
+
+/**
+ * @brief Updates the fill by the changes of the boundary, with the weighted function of
+ *        the parameters.
+ * @param firstNewPixel The index of the first hole pixel which isn't filled yet, the hole
+ *        pixels from it are computed over the entire boundary.
+ */
+void IncrementalFill::refill(const size_t firstNewPixel)
+{
+    INSTRUMENT_COUNT("weight evaluations",
+                     firstNewPixel * (_joinedBoundary.size() + _leftBoundary.size()) +
+                     (_holePixels.size() - firstNewPixel) * _boundaryPixels.size());
+    if (_config.weight == GAUSSIAN_WEIGHT)
+    {
+        refill(firstNewPixel, GaussianWeight(std::max(_config.sigma, MIN_SIGMA)));
+    }
+    else if (_kernel.isSpecialised())
+    {
+        kernelRefill(firstNewPixel);
+    }
+    else
+    {
+        const int integerZ = (int) _config.z;
+        if (integerZ != _config.z || integerZ < 1 || integerZ > MAX_INTEGER_Z)
+        {
+            refill(firstNewPixel, InversePowerWeight(_config.epsilon, _config.z));
+        }
+        else
+        {
+            switch (integerZ)
+            {
+                case 1:
+                    refill(firstNewPixel, IntegerInversePowerWeight<1>(_config.epsilon));
+                    break;
+                case 2:
+                    refill(firstNewPixel, IntegerInversePowerWeight<2>(_config.epsilon));
+                    break;
+                case 3:
+                    refill(firstNewPixel, IntegerInversePowerWeight<3>(_config.epsilon));
+                    break;
+                default:
+                    refill(firstNewPixel, IntegerInversePowerWeight<4>(_config.epsilon));
+                    break;
+            }
+        }
+    }
+    _joinedBoundary.clear();
+    _leftBoundary.clear();
+}
+
+/**
+ * @brief Updates the fill by the changes of the boundary: the pixels which joined the
+ *        boundary are added to, and the pixels which left it are subtracted from, every
+ *        filled hole pixel, the new hole pixels are computed over the entire boundary, and
+ *        the values of the hole pixels are written to the image.
+ * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+ * @param firstNewPixel The index of the first hole pixel which isn't filled yet.
+ * @param weightedFunction The weighted function used in the fill process.
+ */
+template <typename WeightFunction>
+void IncrementalFill::refill(const size_t firstNewPixel, const WeightFunction &weightedFunction)
+{
+    // The boundary pixels are known, so their values are the values of the image.
+    if (!_joinedBoundary.empty() || !_leftBoundary.empty())
+    {
+        _threadPool.parallelFor(firstNewPixel, DELTA_CHUNK_SIZE, [&](const size_t begin,
+                                                                     const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Pixel &x = _holePixels[i];
+                float numerator = 0;
+                float denominator = 0;
+                for (const Pixel &y : _joinedBoundary)
+                {
+                    const float weightedValue = weightedFunction(x, y);
+                    numerator += weightedValue * _original.at(y);
+                    denominator += weightedValue;
+                }
+                for (const Pixel &y : _leftBoundary)
+                {
+                    const float weightedValue = weightedFunction(x, y);
+                    numerator -= weightedValue * _original.at(y);
+                    denominator -= weightedValue;
+                }
+                _numerators[i] += numerator;
+                _denominators[i] += denominator;
+                writeValue(i);
+            }
+        });
+    }
+
+    _boundaryValues.clear();
+    for (const Pixel &y : _boundaryPixels)
+    {
+        _boundaryValues.push_back(_original.at(y));
+    }
+    _threadPool.parallelFor(_holePixels.size() - firstNewPixel, FILL_CHUNK_SIZE,
+                            [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = firstNewPixel + begin; i < firstNewPixel + end; ++i)
+        {
+            const Pixel &x = _holePixels[i];
+            float numerator = 0;
+            float denominator = 0;
+            for (size_t j = 0; j < _boundaryPixels.size(); ++j)
+            {
+                const float weightedValue = weightedFunction(x, _boundaryPixels[j]);
+                numerator += weightedValue * _boundaryValues[j];
+                denominator += weightedValue;
+            }
+            _numerators[i] = numerator;
+            _denominators[i] = denominator;
+            writeValue(i);
+        }
+    });
+}
+
+/**
+ * @brief Updates the fill by the changes of the boundary like refill, with the vectorized
+ *        fill kernel of the default weighted function.
+ * @param firstNewPixel The index of the first hole pixel which isn't filled yet.
+ */
+void IncrementalFill::kernelRefill(const size_t firstNewPixel)
+{
+    if (!_joinedBoundary.empty() || !_leftBoundary.empty())
+    {
+        _joinedArrays.assign(_original, _joinedBoundary);
+        _leftArrays.assign(_original, _leftBoundary);
+        _threadPool.parallelFor(firstNewPixel, DELTA_CHUNK_SIZE, [&](const size_t begin,
+                                                                     const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float joinedNumerator = 0;
+                float joinedDenominator = 0;
+                float leftNumerator = 0;
+                float leftDenominator = 0;
+                _kernel.accumulate(_joinedArrays, 0, _joinedArrays.size(), _holePixels[i],
+                                   joinedNumerator, joinedDenominator);
+                _kernel.accumulate(_leftArrays, 0, _leftArrays.size(), _holePixels[i],
+                                   leftNumerator, leftDenominator);
+                _numerators[i] += (double) joinedNumerator - leftNumerator;
+                _denominators[i] += (double) joinedDenominator - leftDenominator;
+                writeValue(i);
+            }
+        });
+    }
+
+    _boundaryArrays.assign(_original, _boundaryPixels);
+    _threadPool.parallelFor(_holePixels.size() - firstNewPixel, FILL_CHUNK_SIZE,
+                            [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = firstNewPixel + begin; i < firstNewPixel + end; ++i)
+        {
+            float numerator = 0;
+            float denominator = 0;
+            _kernel.accumulate(_boundaryArrays, 0, _boundaryArrays.size(), _holePixels[i],
+                               numerator, denominator);
+            _numerators[i] = numerator;
+            _denominators[i] = denominator;
+            writeValue(i);
+        }
+    });
+}
+
+/**
+ * @brief Writes the value of the given hole pixel from it's sums to the image. A pixel whose
+ *        weights all underflowed takes the limit of the fill, see MIN_WEIGHT_SUM.
+ * @param index The index of the hole pixel.
+ */
+void IncrementalFill::writeValue(const size_t index)
+{
+    const Pixel &x = _holePixels[index];
+    if (_boundaryPixels.empty())
+    {
+        // A hole without a boundary stays missing.
+        _image.at(x) = MISSING_VALUE;
+    }
+    else if (_denominators[index] < MIN_WEIGHT_SUM)
+    {
+        float sum = 0;
+        int count = 0;
+        forEachNearestPixel(x, _boundaryPixels, [&](const size_t j)
+        {
+            sum += _original.at(_boundaryPixels[j]);
+            ++count;
+        });
+        _image.at(x) = sum / count;
+    }
+    else
+    {
+        _image.at(x) = (float) (_numerators[index] / _denominators[index]);
+    }
+}
\ No newline at end of file
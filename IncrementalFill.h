@@ -0,0 +1,177 @@
+/**
+ * @file IncrementalFill.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the IncrementalFill Class.
+ */
+
+
+#ifndef INCREMENTALFILL_H
+#define INCREMENTALFILL_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <vector>
+#include "Pixel.h"
+#include "Image.h"
+#include "FillConfig.h"
+#include "ThreadPool.h"
+#include "Hole.h"
+#include "FillKernel.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing an exact fill of a hole which is painted a few pixels at a time,
+ *        e.g. by the strokes of an interactive tool. The fill keeps the numerator and the
+ *        denominator of every hole pixel, and when the hole changes, the contribution of every
+ *        pixel which joined or left the boundary is added to or subtracted from the hole pixels
+ *        which were already filled, and only the new hole pixels are computed over the entire
+ *        boundary. So the cost of a change is set by the number of pixels it changes, times the
+ *        size of the hole or its boundary, instead of the size of the hole times its boundary.
+ *        The painted pixels are filled as a single hole, whose boundary is every known pixel
+ *        which neighbours one of them, so the fill matches the exact fill while the painted
+ *        pixels are connected.
+ */
+class IncrementalFill
+{
+public:
+    /**
+     * @brief A Constructor for the IncrementalFill. The missing pixels of the image are the
+     *        initial hole, which is filled entirely.
+     * @param image The image, which is copied.
+     * @param config The parameters of the fill.
+     * @param threadCount The number of threads used in the fill, 0 for all the hardware threads.
+     */
+    IncrementalFill(const Image &image, const FillConfig &config,
+                    const unsigned int threadCount = 0);
+
+    /**
+     * @brief The fill owns its threads, so it can't be copied.
+     */
+    IncrementalFill(const IncrementalFill &other) = delete;
+
+    /**
+     * @brief The fill owns its threads, so it can't be copied.
+     */
+    IncrementalFill& operator=(const IncrementalFill &other) = delete;
+
+    /**
+     * @brief Adds the given pixels to the hole and updates the fill. Pixels which are already
+     *        in the hole are skipped.
+     * @param pixels The pixels to add, inside the image.
+     */
+    void addHolePixels(const std::vector<Pixel> &pixels);
+
+    /**
+     * @brief Removes the given pixels from the hole, which get their values of the image back,
+     *        and updates the fill. Pixels which aren't in the hole, or which are missing in the
+     *        image itself, are skipped.
+     * @param pixels The pixels to remove, inside the image.
+     */
+    void removeHolePixels(const std::vector<Pixel> &pixels);
+
+    /**
+     * @brief Returns the filled image, i.e. the image with the current hole filled.
+     * @return The filled image.
+     */
+    const Image &getImage() const { return _image; }
+
+    /**
+     * @brief Returns the pixels of the hole, in no particular order.
+     * @return The pixels of the hole.
+     */
+    const std::vector<Pixel> &getHolePixels() const { return _holePixels; }
+
+    /**
+     * @brief Returns the pixels of the boundary of the hole, in no particular order.
+     * @return The pixels of the boundary.
+     */
+    const holeSet &getHoleBoundary() const { return _boundaryPixels; }
+
+private:
+    /**
+     * @brief Returns the index of the given pixel in the planes.
+     * @param pixel The pixel.
+     * @return The index of the pixel.
+     */
+    size_t getIndex(const Pixel &pixel) const
+    {
+        return (size_t) pixel.getX() * _original.getCols() + pixel.getY();
+    }
+
+    /**
+     * @brief Adds the given known pixel to the boundary, and to the pixels which joined it.
+     * @param pixel The pixel.
+     */
+    void addBoundaryPixel(const Pixel &pixel);
+
+    /**
+     * @brief Removes the given pixel from the boundary, and adds it to the pixels which left it.
+     * @param pixel The pixel, in the boundary.
+     */
+    void removeBoundaryPixel(const Pixel &pixel);
+
+    /**
+     * @brief Updates the fill by the changes of the boundary, with the weighted function of
+     *        the parameters.
+     * @param firstNewPixel The index of the first hole pixel which isn't filled yet, the hole
+     *        pixels from it are computed over the entire boundary.
+     */
+    void refill(const size_t firstNewPixel);
+
+    /**
+     * @brief Updates the fill by the changes of the boundary: the pixels which joined the
+     *        boundary are added to, and the pixels which left it are subtracted from, every
+     *        filled hole pixel, the new hole pixels are computed over the entire boundary, and
+     *        the values of the hole pixels are written to the image.
+     * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+     * @param firstNewPixel The index of the first hole pixel which isn't filled yet.
+     * @param weightedFunction The weighted function used in the fill process.
+     */
+    template <typename WeightFunction>
+    void refill(const size_t firstNewPixel, const WeightFunction &weightedFunction);
+
+    /**
+     * @brief Updates the fill by the changes of the boundary like refill, with the vectorized
+     *        fill kernel of the default weighted function.
+     * @param firstNewPixel The index of the first hole pixel which isn't filled yet.
+     */
+    void kernelRefill(const size_t firstNewPixel);
+
+    /**
+     * @brief Writes the value of the given hole pixel from it's sums to the image.
+     * @param index The index of the hole pixel.
+     */
+    void writeValue(const size_t index);
+
+    FillConfig _config;  // The parameters of the fill.
+    ThreadPool _threadPool;  // The threads used in the fill.
+    Image _original;  // The pixel values of the image, before the fill.
+    Image _image;  // The image with the hole filled.
+    std::vector<int> _holeSlots;  // The index of every pixel in the hole pixels, or -1.
+    std::vector<int> _boundarySlots;  // The index of every pixel in the boundary, or -1.
+    std::vector<unsigned char> _holeNeighbours;  // The number of hole pixels every pixel
+                                                 // neighbours.
+    std::vector<Pixel> _holePixels;  // The pixels of the hole.
+    std::vector<double> _numerators;  // The sum of the weighted boundary values of every
+                                      // hole pixel.
+    std::vector<double> _denominators;  // The sum of the weights of every hole pixel.
+    holeSet _boundaryPixels;  // The pixels of the boundary.
+    holeSet _joinedBoundary;  // The pixels which joined the boundary in a change.
+    holeSet _leftBoundary;  // The pixels which left the boundary in a change.
+    std::vector<float> _boundaryValues;  // The values of the boundary pixels.
+    FillKernel _kernel;  // The fill kernel of the default weighted function.
+    BoundaryArrays _boundaryArrays;  // The boundary, packed for the fill kernel.
+    BoundaryArrays _joinedArrays;  // The pixels which joined the boundary, packed.
+    BoundaryArrays _leftArrays;  // The pixels which left the boundary, packed.
+
+};
+
+
+#endif
\ No newline at end of file
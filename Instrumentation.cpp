@@ -0,0 +1,296 @@
+/**
+ * @file Instrumentation.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the instrumentation implementation, which is empty unless the program is
+ *        built with HOLEFILLING_INSTRUMENTATION defined.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include "Instrumentation.h"
+
+#ifdef HOLEFILLING_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def NANOSECONDS_PER_MICROSECOND 1e3
+ * @brief A Macro that sets the number of nanoseconds in a microsecond, the unit of the output.
+ */
+#define NANOSECONDS_PER_MICROSECOND 1e3
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A single stage which ended.
+ */
+struct StageRecord
+{
+    const char *name;  // The name of the stage.
+    int threadIndex;  // The index of the thread which ran the stage.
+    int64_t begin;  // The time at which the stage began.
+    int64_t end;  // The time at which the stage ended.
+};
+
+/**
+ * @brief The records of the process, which write the outputs which are set when they are
+ *        destroyed, i.e. when the process exits.
+ */
+struct InstrumentationRecords
+{
+    /**
+     * @brief A Destructor for the InstrumentationRecords, which writes the outputs.
+     */
+    ~InstrumentationRecords();
+
+    std::mutex mutex;  // Protects the records.
+    std::vector<StageRecord> stages;  // The stages, by the order in which they ended.
+    std::map<std::string, uint64_t> counters;  // The counters, by their names.
+    std::atomic<int> threadCount{0};  // The number of threads which recorded a stage.
+    std::string jsonPath;  // The path of the JSON summary, empty if not written.
+    std::string tracePath;  // The path of the Chrome trace, empty if not written.
+};
+
+
+/*-----=  Static Functions  =-----*/
+
+
+/**
+ * @brief Returns the records of the process.
+ * @return The records of the process.
+ */
+static InstrumentationRecords &getRecords()
+{
+    static InstrumentationRecords records;
+    return records;
+}
+
+/**
+ * @brief Returns the index of the calling thread, from 0 by the order of the first stage of
+ *        every thread.
+ * @return The index of the calling thread.
+ */
+static int getThreadIndex()
+{
+    thread_local const int threadIndex = getRecords().threadCount++;
+    return threadIndex;
+}
+
+/**
+ * @brief Returns the given time in microseconds, the unit of the output.
+ * @param time The time in nanoseconds.
+ * @return The time in microseconds.
+ */
+static double toMicroseconds(const int64_t time)
+{
+    return time / NANOSECONDS_PER_MICROSECOND;
+}
+
+/**
+ * @brief Writes the given string as a JSON string. The names are string literals of the
+ *        program, so only quotes and backslashes are escaped.
+ * @param output The output stream.
+ * @param value The string.
+ */
+static void writeJsonString(std::ostream &output, const std::string &value)
+{
+    output << '"';
+    for (const char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            output << '\\';
+        }
+        output << c;
+    }
+    output << '"';
+}
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Destructor for the InstrumentationRecords, which writes the outputs.
+ */
+InstrumentationRecords::~InstrumentationRecords()
+{
+    if (!jsonPath.empty() && !Instrumentation::writeJson(jsonPath.c_str()))
+    {
+        std::cerr << "Error: can't write the instrumentation to " << jsonPath << std::endl;
+    }
+    if (!tracePath.empty() && !Instrumentation::writeTrace(tracePath.c_str()))
+    {
+        std::cerr << "Error: can't write the trace to " << tracePath << std::endl;
+    }
+}
+
+/**
+ * @brief Returns the time since the start of the process.
+ * @return The time since the start of the process, in nanoseconds.
+ */
+int64_t Instrumentation::now()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Records a stage which ended in the calling thread.
+ * @param name The name of the stage, a string literal.
+ * @param begin The time at which the stage began, see now.
+ * @param end The time at which the stage ended, see now.
+ */
+void Instrumentation::addStage(const char *name, const int64_t begin, const int64_t end)
+{
+    const int threadIndex = getThreadIndex();
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    records.stages.push_back({name, threadIndex, begin, end});
+}
+
+/**
+ * @brief Adds the given value to the counter of the given name.
+ * @param name The name of the counter, a string literal.
+ * @param value The value to add.
+ */
+void Instrumentation::addCount(const char *name, const uint64_t value)
+{
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    records.counters[name] += value;
+}
+
+/**
+ * @brief Writes the summary of the stages (their count, total and maximal time) and the
+ *        counters as JSON.
+ * @param path The path of the JSON file.
+ * @return true if the file was written, false otherwise.
+ */
+bool Instrumentation::writeJson(const char *path)
+{
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    struct StageSummary
+    {
+        size_t count = 0;
+        int64_t total = 0;
+        int64_t max = 0;
+    };
+    std::map<std::string, StageSummary> summaries;
+    for (const StageRecord &stage : records.stages)
+    {
+        StageSummary &summary = summaries[stage.name];
+        ++summary.count;
+        summary.total += stage.end - stage.begin;
+        summary.max = std::max(summary.max, stage.end - stage.begin);
+    }
+
+    std::ofstream output(path, std::ios::trunc);
+    output << std::fixed << std::setprecision(3);
+    output << "{\n  \"stages\": {";
+    const char *separator = "\n";
+    for (const auto &summary : summaries)
+    {
+        output << separator << "    ";
+        writeJsonString(output, summary.first);
+        output << ": {\"count\": " << summary.second.count << ", \"total_us\": "
+               << toMicroseconds(summary.second.total) << ", \"max_us\": "
+               << toMicroseconds(summary.second.max) << "}";
+        separator = ",\n";
+    }
+    output << "\n  },\n  \"counters\": {";
+    separator = "\n";
+    for (const auto &counter : records.counters)
+    {
+        output << separator << "    ";
+        writeJsonString(output, counter.first);
+        output << ": " << counter.second;
+        separator = ",\n";
+    }
+    output << "\n  }\n}" << std::endl;
+    return (bool) output;
+}
+
+/**
+ * @brief Writes every stage as a complete event and the counters as counter events in
+ *        the Chrome trace event format.
+ * @param path The path of the trace file.
+ * @return true if the file was written, false otherwise.
+ */
+bool Instrumentation::writeTrace(const char *path)
+{
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    const pid_t processId = getpid();
+    int64_t lastEnd = 0;
+    std::ofstream output(path, std::ios::trunc);
+    output << std::fixed << std::setprecision(3);
+    output << "{\"traceEvents\": [";
+    const char *separator = "\n";
+    for (const StageRecord &stage : records.stages)
+    {
+        output << separator << "  {\"name\": ";
+        writeJsonString(output, stage.name);
+        output << ", \"ph\": \"X\", \"ts\": " << toMicroseconds(stage.begin) << ", \"dur\": "
+               << toMicroseconds(stage.end - stage.begin) << ", \"pid\": " << processId
+               << ", \"tid\": " << stage.threadIndex << "}";
+        lastEnd = std::max(lastEnd, stage.end);
+        separator = ",\n";
+    }
+    for (const auto &counter : records.counters)
+    {
+        output << separator << "  {\"name\": ";
+        writeJsonString(output, counter.first);
+        output << ", \"ph\": \"C\", \"ts\": " << toMicroseconds(lastEnd) << ", \"pid\": "
+               << processId << ", \"args\": {\"value\": " << counter.second << "}}";
+        separator = ",\n";
+    }
+    output << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+    return (bool) output;
+}
+
+/**
+ * @brief Sets the path of the JSON summary, which is written when the process exits.
+ * @param path The path of the JSON file.
+ */
+void Instrumentation::setJsonOutput(const char *path)
+{
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    records.jsonPath = path;
+}
+
+/**
+ * @brief Sets the path of the Chrome trace, which is written when the process exits.
+ * @param path The path of the trace file.
+ */
+void Instrumentation::setTraceOutput(const char *path)
+{
+    InstrumentationRecords &records = getRecords();
+    std::lock_guard<std::mutex> lock(records.mutex);
+    records.tracePath = path;
+}
+
+
+#endif
\ No newline at end of file
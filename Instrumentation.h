@@ -0,0 +1,164 @@
+/**
+ * @file Instrumentation.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the instrumentation of the stages of the hole filling: scoped
+ *        timers and counters, which are compiled out entirely unless the program is built
+ *        with HOLEFILLING_INSTRUMENTATION defined (make INSTRUMENT=1).
+ */
+
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def INSTRUMENT_CONCAT(a, b)
+ * @brief A Macro that concatenates two tokens after expanding them.
+ */
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_TOKENS(a, b)
+
+/**
+ * @def INSTRUMENT_CONCAT_TOKENS(a, b)
+ * @brief A Macro that concatenates two tokens.
+ */
+#define INSTRUMENT_CONCAT_TOKENS(a, b) a##b
+
+#ifdef HOLEFILLING_INSTRUMENTATION
+
+/**
+ * @def INSTRUMENT_SCOPE(name)
+ * @brief A Macro that times the rest of the enclosing scope as a stage of the given name.
+ */
+#define INSTRUMENT_SCOPE(name) \
+        const ScopedTimer INSTRUMENT_CONCAT(scopedTimer, __LINE__)(name)
+
+/**
+ * @def INSTRUMENT_COUNT(name, value)
+ * @brief A Macro that adds the given value to the counter of the given name.
+ */
+#define INSTRUMENT_COUNT(name, value) Instrumentation::addCount(name, value)
+
+#else
+
+// The instrumentation is compiled out, so the stages and the counters cost nothing.
+#define INSTRUMENT_SCOPE(name) do {} while (0)
+
+#define INSTRUMENT_COUNT(name, value) do {} while (0)
+
+#endif
+
+
+#ifdef HOLEFILLING_INSTRUMENTATION
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstdint>
+
+
+/*-----=  Class Declarations  =-----*/
+
+
+/**
+ * @brief A Class which collects the timed stages and the counters of the process, from all
+ *        the threads. A stage is recorded once it ends, and the records are written at the
+ *        end of the run as a JSON summary or as Chrome trace events (chrome://tracing or
+ *        Perfetto), so the instrumentation costs a lock per stage and not per pixel. The
+ *        outputs which are set are written when the process exits, even by exit().
+ */
+class Instrumentation
+{
+public:
+    /**
+     * @brief Returns the time since the start of the process.
+     * @return The time since the start of the process, in nanoseconds.
+     */
+    static int64_t now();
+
+    /**
+     * @brief Records a stage which ended in the calling thread.
+     * @param name The name of the stage, a string literal.
+     * @param begin The time at which the stage began, see now.
+     * @param end The time at which the stage ended, see now.
+     */
+    static void addStage(const char *name, const int64_t begin, const int64_t end);
+
+    /**
+     * @brief Adds the given value to the counter of the given name.
+     * @param name The name of the counter, a string literal.
+     * @param value The value to add.
+     */
+    static void addCount(const char *name, const uint64_t value);
+
+    /**
+     * @brief Writes the summary of the stages (their count, total and maximal time) and the
+     *        counters as JSON.
+     * @param path The path of the JSON file.
+     * @return true if the file was written, false otherwise.
+     */
+    static bool writeJson(const char *path);
+
+    /**
+     * @brief Writes every stage as a complete event and the counters as counter events in
+     *        the Chrome trace event format.
+     * @param path The path of the trace file.
+     * @return true if the file was written, false otherwise.
+     */
+    static bool writeTrace(const char *path);
+
+    /**
+     * @brief Sets the path of the JSON summary, which is written when the process exits.
+     * @param path The path of the JSON file.
+     */
+    static void setJsonOutput(const char *path);
+
+    /**
+     * @brief Sets the path of the Chrome trace, which is written when the process exits.
+     * @param path The path of the trace file.
+     */
+    static void setTraceOutput(const char *path);
+};
+
+/**
+ * @brief A Class which times its own lifetime as a stage, see INSTRUMENT_SCOPE.
+ */
+class ScopedTimer
+{
+public:
+    /**
+     * @brief A Constructor for the ScopedTimer, which begins the stage.
+     * @param name The name of the stage, a string literal.
+     */
+    explicit ScopedTimer(const char *name) : _name(name), _begin(Instrumentation::now()) {}
+
+    /**
+     * @brief A Destructor for the ScopedTimer, which ends the stage.
+     */
+    ~ScopedTimer() { Instrumentation::addStage(_name, _begin, Instrumentation::now()); }
+
+    /**
+     * @brief A timer times a single scope, so it can't be copied.
+     */
+    ScopedTimer(const ScopedTimer &other) = delete;
+
+    /**
+     * @brief A timer times a single scope, so it can't be copied.
+     */
+    ScopedTimer& operator=(const ScopedTimer &other) = delete;
+
+private:
+    const char *_name;  // The name of the stage.
+    int64_t _begin;  // The time at which the stage began.
+
+};
+
+
+#endif
+
+
+#endif
\ No newline at end of file
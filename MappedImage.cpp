@@ -0,0 +1,158 @@
+/**
+ * @file MappedImage.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the MappedImage Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <fstream>
+#include <vector>
+#include <cassert>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedImage.h"
+#include "HoleException.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def COPY_BUFFER_SIZE 1048576
+ * @brief A Macro that sets the number of bytes in the buffer used to copy a file.
+ */
+#define COPY_BUFFER_SIZE 1048576
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the MappedImage, which maps the given file for reading and
+ *        writing.
+ * @throws InvalidRawImageException If the file can't be opened or its size doesn't match the
+ *         given size of the image.
+ * @throws MappingFailedException If the file can't be mapped.
+ * @param path The path of the raw file.
+ * @param rows The number of rows in the image.
+ * @param cols The number of columns in the image.
+ */
+MappedImage::MappedImage(const char *path, const int rows, const int cols) :
+        _data(nullptr), _size((size_t) rows * cols * sizeof(float)), _rows(rows), _cols(cols)
+{
+    const int file = open(path, O_RDWR);
+    struct stat fileStatus;
+    if (file < 0)
+    {
+        throw InvalidRawImageException();
+    }
+    if (fstat(file, &fileStatus) != 0 || (size_t) fileStatus.st_size != _size)
+    {
+        // Invalid raw image.
+        close(file);
+        throw InvalidRawImageException();
+    }
+    void *mapping = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+    {
+        throw MappingFailedException();
+    }
+    _data = static_cast<float*>(mapping);
+}
+
+/**
+ * @brief A Destructor for the MappedImage, which writes back and unmaps the file.
+ */
+MappedImage::~MappedImage()
+{
+    msync(_data, _size, MS_SYNC);
+    munmap(_data, _size);
+}
+
+/**
+ * @brief Returns a view of the given window of the image, without copying it.
+ * @param x The first row of the window.
+ * @param y The first column of the window.
+ * @param rows The number of rows in the window.
+ * @param cols The number of columns in the window.
+ * @return An Image which refers to the window in the mapping.
+ */
+Image MappedImage::getWindow(const int x, const int y, const int rows, const int cols)
+{
+    assert(x >= 0 && y >= 0 && x + rows <= _rows && y + cols <= _cols);
+    return Image(_data + (size_t) x * _cols + y, rows, cols, (size_t) _cols);
+}
+
+/**
+ * @brief Writes the given rows back to the file, and drops their pages from memory. The
+ *        rows may still be viewed, in which case they are read back from the file.
+ * @param begin The first row to release.
+ * @param end The row after the last row to release.
+ */
+void MappedImage::releaseRows(const int begin, const int end)
+{
+    // The range must start on a page, so it is extended back to the page of the first row.
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t first = ((size_t) begin * _cols * sizeof(float)) / pageSize * pageSize;
+    const size_t last = (size_t) end * _cols * sizeof(float);
+    if (last <= first)
+    {
+        return;
+    }
+    char *pages = reinterpret_cast<char*>(_data) + first;
+    msync(pages, last - first, MS_SYNC);
+    madvise(pages, last - first, MADV_DONTNEED);
+}
+
+/**
+ * @brief Copies a file by streaming it through a fixed size buffer. A file isn't copied
+ *        onto itself, since it would be truncated before it is read.
+ * @param sourcePath The path of the file to copy.
+ * @param destinationPath The path of the copy.
+ * @return true if the file was copied, false otherwise.
+ */
+bool MappedImage::copyFile(const char *sourcePath, const char *destinationPath)
+{
+    if (isSameFile(sourcePath, destinationPath))
+    {
+        return false;
+    }
+    std::ifstream source(sourcePath, std::ios::binary);
+    std::ofstream destination(destinationPath, std::ios::binary | std::ios::trunc);
+    if (!source || !destination)
+    {
+        return false;
+    }
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+    while (source)
+    {
+        source.read(buffer.data(), buffer.size());
+        destination.write(buffer.data(), source.gcount());
+    }
+    return source.eof() && (bool) destination;
+}
+
+/**
+ * @brief Returns whether the given paths refer to the same existing file. The files are
+ *        compared by their device and inode, so different paths of a file (e.g. a relative
+ *        and an absolute path, or a link) are the same file.
+ * @param lhsPath The first path.
+ * @param rhsPath The second path.
+ * @return true if both paths refer to the same file, false otherwise.
+ */
+bool MappedImage::isSameFile(const char *lhsPath, const char *rhsPath)
+{
+    struct stat lhsStatus, rhsStatus;
+    if (stat(lhsPath, &lhsStatus) != 0 || stat(rhsPath, &rhsStatus) != 0)
+    {
+        return false;
+    }
+    return lhsStatus.st_dev == rhsStatus.st_dev && lhsStatus.st_ino == rhsStatus.st_ino;
+}
\ No newline at end of file
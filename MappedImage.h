@@ -0,0 +1,118 @@
+/**
+ * @file MappedImage.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the MappedImage Class.
+ */
+
+
+#ifndef MAPPEDIMAGE_H
+#define MAPPEDIMAGE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include "Image.h"
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a single channel image stored in a raw file of floats (row-major,
+ *        without a header), which is memory mapped instead of being read into memory.
+ *        Windows of the image are viewed as Images without copying them, and the pages of rows
+ *        which are done are written back and dropped, so the memory used by the mapping is set
+ *        by the windows in use and not by the size of the image.
+ */
+class MappedImage
+{
+public:
+    /**
+     * @brief A Constructor for the MappedImage, which maps the given file for reading and
+     *        writing.
+     * @throws InvalidRawImageException If the file can't be opened or its size doesn't match
+     *         the given size of the image.
+     * @throws MappingFailedException If the file can't be mapped.
+     * @param path The path of the raw file.
+     * @param rows The number of rows in the image.
+     * @param cols The number of columns in the image.
+     */
+    MappedImage(const char *path, const int rows, const int cols);
+
+    /**
+     * @brief A Destructor for the MappedImage, which writes back and unmaps the file.
+     */
+    ~MappedImage();
+
+    /**
+     * @brief The image owns its mapping, so it can't be copied.
+     */
+    MappedImage(const MappedImage &other) = delete;
+
+    /**
+     * @brief The image owns its mapping, so it can't be copied.
+     */
+    MappedImage& operator=(const MappedImage &other) = delete;
+
+    /**
+     * @brief Returns the number of rows in the image.
+     * @return The number of rows in the image.
+     */
+    int getRows() const { return _rows; }
+
+    /**
+     * @brief Returns the number of columns in the image.
+     * @return The number of columns in the image.
+     */
+    int getCols() const { return _cols; }
+
+    /**
+     * @brief Returns a view of the given window of the image, without copying it.
+     * @param x The first row of the window.
+     * @param y The first column of the window.
+     * @param rows The number of rows in the window.
+     * @param cols The number of columns in the window.
+     * @return An Image which refers to the window in the mapping.
+     */
+    Image getWindow(const int x, const int y, const int rows, const int cols);
+
+    /**
+     * @brief Writes the given rows back to the file, and drops their pages from memory. The
+     *        rows may still be viewed, in which case they are read back from the file.
+     * @param begin The first row to release.
+     * @param end The row after the last row to release.
+     */
+    void releaseRows(const int begin, const int end);
+
+    /**
+     * @brief Copies a file by streaming it through a fixed size buffer. A file isn't copied
+     *        onto itself, since it would be truncated before it is read.
+     * @param sourcePath The path of the file to copy.
+     * @param destinationPath The path of the copy.
+     * @return true if the file was copied, false otherwise.
+     */
+    static bool copyFile(const char *sourcePath, const char *destinationPath);
+
+    /**
+     * @brief Returns whether the given paths refer to the same existing file. The files are
+     *        compared by their device and inode, so different paths of a file (e.g. a relative
+     *        and an absolute path, or a link) are the same file.
+     * @param lhsPath The first path.
+     * @param rhsPath The second path.
+     * @return true if both paths refer to the same file, false otherwise.
+     */
+    static bool isSameFile(const char *lhsPath, const char *rhsPath);
+
+private:
+    float *_data;  // The first pixel of the mapping.
+    size_t _size;  // The number of bytes in the mapping.
+    int _rows;  // The number of rows in the image.
+    int _cols;  // The number of columns in the image.
+
+};
+
+
+#endif
\ No newline at end of file
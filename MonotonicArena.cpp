@@ -0,0 +1,60 @@
+/**
+ * @file MonotonicArena.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the MonotonicArena Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include "MonotonicArena.h"
+#include "Instrumentation.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief Allocates memory from the arena.
+ * @param bytes The number of bytes to allocate.
+ * @param alignment The alignment of the memory, at most alignof(std::max_align_t).
+ * @return The allocated memory, valid until the next reset.
+ */
+void *MonotonicArena::allocate(const size_t bytes, const size_t alignment)
+{
+    const size_t offset = (_used + alignment - 1) / alignment * alignment;
+    if (offset + bytes <= _capacity)
+    {
+        _used = offset + bytes;
+        return _block.get() + offset;
+    }
+
+    // The block is full, the allocation gets a block of its own until the next reset. A new
+    // block is aligned for any fundamental type.
+    INSTRUMENT_COUNT("bytes allocated", bytes);
+    _overflowBlocks.emplace_back(new unsigned char[std::max(bytes, (size_t) 1)]);
+    _overflowSize += bytes;
+    return _overflowBlocks.back().get();
+}
+
+/**
+ * @brief Releases all the allocations at once, and makes sure the block has room for the
+ *        given number of bytes and for everything allocated since the last reset.
+ * @param capacity The number of bytes the next allocations are expected to take.
+ */
+void MonotonicArena::reset(const size_t capacity)
+{
+    const size_t demand = std::max(capacity, _used + _overflowSize);
+    if (demand > _capacity)
+    {
+        INSTRUMENT_COUNT("bytes allocated", demand);
+        _block.reset(new unsigned char[demand]);
+        _capacity = demand;
+    }
+    _overflowBlocks.clear();
+    _overflowSize = 0;
+    _used = 0;
+}
\ No newline at end of file
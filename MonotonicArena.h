@@ -0,0 +1,183 @@
+/**
+ * @file MonotonicArena.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the MonotonicArena Class and its ArenaAllocator.
+ */
+
+
+#ifndef MONOTONICARENA_H
+#define MONOTONICARENA_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+
+/*-----=  Class Declarations  =-----*/
+
+
+/**
+ * @brief A Class representing a monotonic arena: the allocations bump a pointer in a single
+ *        block, they are never freed on their own, and they are all released at once by reset.
+ *        An allocation which doesn't fit the block gets a block of its own, and the next reset
+ *        grows the block to everything allocated since the last reset, so an arena which is
+ *        reset with a capacity hint (or which sees the same demand every time) allocates
+ *        nothing once it is warm.
+ */
+class MonotonicArena
+{
+public:
+    /**
+     * @brief A Constructor for the MonotonicArena, without a block.
+     */
+    MonotonicArena() : _capacity(0), _used(0), _overflowSize(0) {}
+
+    /**
+     * @brief The arena owns the memory of its allocations, so it can't be copied.
+     */
+    MonotonicArena(const MonotonicArena &other) = delete;
+
+    /**
+     * @brief The arena owns the memory of its allocations, so it can't be copied.
+     */
+    MonotonicArena& operator=(const MonotonicArena &other) = delete;
+
+    /**
+     * @brief Allocates memory from the arena.
+     * @param bytes The number of bytes to allocate.
+     * @param alignment The alignment of the memory, at most alignof(std::max_align_t).
+     * @return The allocated memory, valid until the next reset.
+     */
+    void *allocate(const size_t bytes, const size_t alignment);
+
+    /**
+     * @brief Releases all the allocations at once, and makes sure the block has room for the
+     *        given number of bytes and for everything allocated since the last reset.
+     * @param capacity The number of bytes the next allocations are expected to take.
+     */
+    void reset(const size_t capacity);
+
+    /**
+     * @brief Returns the number of bytes of the block of the arena.
+     * @return The number of bytes of the block.
+     */
+    size_t getCapacity() const { return _capacity; }
+
+private:
+    std::unique_ptr<unsigned char[]> _block;  // The block the allocations bump through.
+    size_t _capacity;  // The number of bytes of the block.
+    size_t _used;  // The number of bytes of the block which are allocated.
+    std::vector<std::unique_ptr<unsigned char[]>> _overflowBlocks;  // The blocks of the
+                                                                    // allocations which didn't
+                                                                    // fit the block.
+    size_t _overflowSize;  // The number of bytes of the overflow blocks.
+
+};
+
+/**
+ * @brief A Class of an allocator which allocates from a MonotonicArena, so the containers
+ *        which use it are released with the arena. An allocator without an arena uses the
+ *        heap, and a copy of a container always uses the heap, so the copies of a container
+ *        don't depend on the arena.
+ * @tparam T The type of the allocated objects.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    /**
+     * @brief A Constructor for the ArenaAllocator.
+     * @param arena The arena to allocate from, nullptr for the heap.
+     */
+    explicit ArenaAllocator(MonotonicArena *arena = nullptr) : _arena(arena) {}
+
+    /**
+     * @brief A Constructor for the ArenaAllocator from an allocator of another type.
+     * @tparam U The type of the objects of the other allocator.
+     * @param other The other allocator.
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other.getArena()) {}
+
+    /**
+     * @brief Returns the arena of the allocator.
+     * @return The arena of the allocator, nullptr for the heap.
+     */
+    MonotonicArena *getArena() const { return _arena; }
+
+    /**
+     * @brief Allocates memory for the given number of objects.
+     * @param count The number of objects.
+     * @return The allocated memory.
+     */
+    T *allocate(const size_t count)
+    {
+        if (_arena == nullptr)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Deallocates the given memory, which is a no-op for an arena.
+     * @param pointer The memory to deallocate.
+     * @param count The number of objects.
+     */
+    void deallocate(T *pointer, const size_t count)
+    {
+        (void) count;
+        if (_arena == nullptr)
+        {
+            ::operator delete(pointer);
+        }
+    }
+
+    /**
+     * @brief Returns the allocator of a copy of a container, which uses the heap.
+     * @return The allocator of the copy.
+     */
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+private:
+    MonotonicArena *_arena;  // The arena to allocate from, nullptr for the heap.
+
+};
+
+/**
+ * @brief operator == for two allocators, which are equal if they use the same arena.
+ * @param lhs The first allocator.
+ * @param rhs The second allocator.
+ * @return true if they use the same arena, false otherwise.
+ */
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs)
+{
+    return lhs.getArena() == rhs.getArena();
+}
+
+/**
+ * @brief operator != for two allocators, which are equal if they use the same arena.
+ * @param lhs The first allocator.
+ * @param rhs The second allocator.
+ * @return true if they use different arenas, false otherwise.
+ */
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+
+#endif
\ No newline at end of file
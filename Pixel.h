@@ -13,8 +13,19 @@
 /*-----=  Includes  =-----*/
 
 
+#include <cstdint>
 #include <iostream>
-#include <vector>
+#include <type_traits>
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MAX_CONNECTIVITY 8
+ * @brief A Macro that sets the maximal pixel connectivity value.
+ */
+#define MAX_CONNECTIVITY 8
 
 
 /*-----=  Class Declaration  =-----*/
@@ -24,6 +35,8 @@
  * @brief A Class representing a single Pixel with X and Y coordinates.
  *        X refers to row number where X=0 is the topmost row.
  *        Y refers to column number where Y=0 is the leftmost column.
+ *        The Pixel is a compact trivially copyable pair of coordinates, its neighbours are
+ *        computed on demand using the neighbours offsets table (see forEachNeighbour).
  */
 class Pixel
 {
@@ -31,7 +44,7 @@ public:
     /**
      * @brief A Default Constructor for the Pixel which sets a pixel at (0,0).
      */
-    Pixel();
+    constexpr Pixel() : _x(0), _y(0) {}
 
     /**
      * @brief A Constructor for the Pixel, which receive 2 coordinates
@@ -39,34 +52,19 @@ public:
      * @param x The X coordinate in the plane.
      * @param y The Y coordinate in the plane.
      */
-    Pixel(const int x, const int y);
+    constexpr Pixel(const int x, const int y) : _x(x), _y(y) {}
 
     /**
      * @brief Returns the X coordinate value.
      * @return The X coordinate value.
      */
-    int getX() const { return _x; };
+    constexpr int getX() const { return _x; };
 
     /**
      * @brief Returns the Y coordinate value.
      * @return The Y coordinate value.
      */
-    int getY() const { return _y; };
-
-    /**
-     * @brief Returns the Pixel's neighbours.
-     * @return The Pixel's neighbours.
-     */
-    std::vector<Pixel> getNeighbours() const { return _neighbours; };
-
-    /**
-     * @brief Set the neighbours of the Pixel according to the given connectivity value.
-     *        The function ignore neighbours that are outside of the image boundaries.
-     * @param connectivity The pixel connectivity value.
-     * @param maxX The max value in the X coordinates.
-     * @param maxY The max value in the Y coordinates.
-     */
-    void setNeighbours(const int connectivity, const int maxX, const int maxY);
+    constexpr int getY() const { return _y; };
 
     /**
      * @brief operator << for stream insertion.
@@ -77,11 +75,52 @@ public:
     friend std::ostream& operator<<(std::ostream &os, const Pixel &pixel);
 
 private:
-    int _x;  // The X coordinate value for the Pixel.
-    int _y;  // The Y coordinate value for the Pixel.
-    std::vector<Pixel> _neighbours;  // The Pixel's neighbours.
+    int32_t _x;  // The X coordinate value for the Pixel.
+    int32_t _y;  // The Y coordinate value for the Pixel.
 
 };
 
+static_assert(std::is_trivially_copyable<Pixel>::value, "Pixel should be trivially copyable");
+static_assert(sizeof(Pixel) == 2 * sizeof(int32_t), "Pixel should be a pair of coordinates");
+
+
+/*-----=  Neighbours  =-----*/
+
+
+/**
+ * @brief The offsets of the neighbours of a pixel. The first 4 offsets are the
+ *        4-connectivity neighbours, and all the 8 offsets are the 8-connectivity neighbours.
+ */
+constexpr Pixel NEIGHBOUR_OFFSETS[MAX_CONNECTIVITY] = {Pixel(1, 0), Pixel(0, 1), Pixel(-1, 0),
+                                                       Pixel(0, -1), Pixel(1, 1), Pixel(1, -1),
+                                                       Pixel(-1, -1), Pixel(-1, 1)};
+
+/**
+ * @brief Calls the given visitor with every neighbour of the given pixel according to the
+ *        given connectivity value, which is known at compile time. The function ignore
+ *        neighbours that are outside of the image boundaries.
+ * @tparam Connectivity The pixel connectivity value, 4 or 8.
+ * @tparam Visitor A callable which receives the X and Y coordinates of a neighbour.
+ * @param pixel The pixel to visit its neighbours.
+ * @param maxX The max value in the X coordinates.
+ * @param maxY The max value in the Y coordinates.
+ * @param visitor The visitor to call with every neighbour.
+ */
+template <int Connectivity, typename Visitor>
+inline void forEachNeighbour(const Pixel &pixel, const int maxX, const int maxY, Visitor visitor)
+{
+    static_assert(Connectivity == 4 || Connectivity == 8, "Connectivity should be 4 or 8");
+    for (int i = 0; i < Connectivity; ++i)
+    {
+        const int x = pixel.getX() + NEIGHBOUR_OFFSETS[i].getX();
+        const int y = pixel.getY() + NEIGHBOUR_OFFSETS[i].getY();
+        if (x >= 0 && x < maxX && y >= 0 && y < maxY)
+        {
+            // If this neighbour is in the image.
+            visitor(x, y);
+        }
+    }
+}
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the ThreadPool Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include "ThreadPool.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Constructor for the ThreadPool.
+ * @param threadCount The number of threads running the loops, including the calling
+ *        thread. A value of 0 uses the number of hardware threads.
+ */
+ThreadPool::ThreadPool(const unsigned int threadCount) : _task(nullptr), _count(0), _chunkSize(1),
+                                                         _nextIndex(0), _activeWorkers(0),
+                                                         _loopNumber(0), _stopped(false)
+{
+    unsigned int totalThreads = threadCount;
+    if (totalThreads == 0)
+    {
+        totalThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    for (unsigned int i = 1; i < totalThreads; ++i)
+    {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @brief A Destructor for the ThreadPool, which joins all the threads.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _loopStarted.notify_all();
+    for (std::thread &worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Runs the given task on all the indices in the range [0,count) and returns once
+ *        all of them are done.
+ * @param count The number of indices.
+ * @param chunkSize The number of indices which are processed by a single task call.
+ * @param task The task to run.
+ */
+void ThreadPool::parallelFor(const size_t count, const size_t chunkSize, const RangeTask &task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    const size_t effectiveChunkSize = std::max(chunkSize, (size_t) 1);
+    if (_workers.empty() || count <= effectiveChunkSize)
+    {
+        // Nothing to share with the workers.
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _count = count;
+        _chunkSize = effectiveChunkSize;
+        _nextIndex = 0;
+        _activeWorkers = (unsigned int) _workers.size();
+        ++_loopNumber;
+    }
+    _loopStarted.notify_all();
+
+    // The calling thread takes chunks as well.
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _loopFinished.wait(lock, [this] { return _activeWorkers == 0; });
+    _task = nullptr;
+}
+
+/**
+ * @brief The loop of every worker thread, which waits for loops and runs their chunks.
+ */
+void ThreadPool::workerLoop()
+{
+    unsigned long lastLoop = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _loopStarted.wait(lock, [this, lastLoop] { return _stopped || _loopNumber != lastLoop; });
+            if (_stopped)
+            {
+                return;
+            }
+            lastLoop = _loopNumber;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_activeWorkers;
+            if (_activeWorkers == 0)
+            {
+                _loopFinished.notify_one();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs chunks of the current loop until there are no chunks left.
+ */
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        const size_t begin = _nextIndex.fetch_add(_chunkSize);
+        if (begin >= _count)
+        {
+            return;
+        }
+        (*_task)(begin, std::min(begin + _chunkSize, _count));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file ThreadPool.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the ThreadPool Class.
+ */
+
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*-----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A Type Definition for a task which processes the indices in the range [begin,end).
+ */
+typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a fixed pool of threads which runs parallel loops.
+ *        A loop is split into chunks of indices, and every thread (including the calling
+ *        thread) repeatedly takes the next chunk until all the chunks are done, so threads
+ *        which finish cheap chunks early keep taking work from the rest of the loop.
+ *        Loops must not be nested, i.e. a task must not call parallelFor of its own pool.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief A Constructor for the ThreadPool.
+     * @param threadCount The number of threads running the loops, including the calling
+     *        thread. A value of 0 uses the number of hardware threads.
+     */
+    explicit ThreadPool(const unsigned int threadCount);
+
+    /**
+     * @brief A Destructor for the ThreadPool, which joins all the threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief The pool owns its threads, so it can't be copied.
+     */
+    ThreadPool(const ThreadPool &other) = delete;
+
+    /**
+     * @brief The pool owns its threads, so it can't be copied.
+     */
+    ThreadPool& operator=(const ThreadPool &other) = delete;
+
+    /**
+     * @brief Returns the number of threads running the loops, including the calling thread.
+     * @return The number of threads running the loops.
+     */
+    unsigned int getThreadCount() const { return (unsigned int) _workers.size() + 1; }
+
+    /**
+     * @brief Runs the given task on all the indices in the range [0,count) and returns once
+     *        all of them are done.
+     * @param count The number of indices.
+     * @param chunkSize The number of indices which are processed by a single task call.
+     * @param task The task to run.
+     */
+    void parallelFor(const size_t count, const size_t chunkSize, const RangeTask &task);
+
+private:
+    /**
+     * @brief The loop of every worker thread, which waits for loops and runs their chunks.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Runs chunks of the current loop until there are no chunks left.
+     */
+    void runChunks();
+
+    std::vector<std::thread> _workers;  // The worker threads.
+    std::mutex _mutex;  // Protects the state of the current loop.
+    std::condition_variable _loopStarted;  // Notified when a loop starts or the pool stops.
+    std::condition_variable _loopFinished;  // Notified when all the workers finish a loop.
+    const RangeTask *_task;  // The task of the current loop.
+    size_t _count;  // The number of indices of the current loop.
+    size_t _chunkSize;  // The chunk size of the current loop.
+    std::atomic<size_t> _nextIndex;  // The first index of the next chunk to run.
+    unsigned int _activeWorkers;  // The number of workers still running the current loop.
+    unsigned long _loopNumber;  // The number of loops started, used to wake the workers.
+    bool _stopped;  // Whether the pool is being destroyed.
+
+};
+
+
+#endif
\ No newline at end of file
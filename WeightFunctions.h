@@ -0,0 +1,232 @@
+/**
+ * @file WeightFunctions.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the weighted functions used to fill the holes.
+ *        A weighted function is any callable object with the signature
+ *        float(const Pixel &lhs, const Pixel &rhs), e.g. one of the classes below, a user
+ *        functor or a function pointer. The fill functions are templates over the weighted
+ *        function, so the weight is inlined in their inner loops. The exact fill tabulates
+ *        the weight by the offsets (|dx|,|dy|), so a weighted function must depend on them
+ *        alone, see WeightTable.h.
+ */
+
+
+#ifndef WEIGHTFUNCTIONS_H
+#define WEIGHTFUNCTIONS_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include "Pixel.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MIN_WEIGHT_SUM FLT_MIN
+ * @brief A Macro that sets the smallest sum of the weights of a pixel which a fill divides by.
+ *        A weighted function which decays faster than any power, like the gaussian, underflows
+ *        to 0 far from the boundary, and a pixel whose weights sum to less is filled by the
+ *        limit of the fill, the mean of its nearest boundary pixels (see forEachNearestPixel).
+ */
+#define MIN_WEIGHT_SUM FLT_MIN
+
+
+/*-----=  Weight Helper Functions  =-----*/
+
+
+/**
+ * @brief Returns the squared distance between the given pixels.
+ * @param lhs The first pixel.
+ * @param rhs The second pixel.
+ * @return The squared distance between the pixels.
+ */
+inline float squaredDistance(const Pixel &lhs, const Pixel &rhs)
+{
+    const float dx = (float) (lhs.getX() - rhs.getX());
+    const float dy = (float) (lhs.getY() - rhs.getY());
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Visits the indices of the given pixels which are nearest to the given pixel. Their
+ *        mean value is the limit of the fill of the pixel when all the weights underflow, see
+ *        MIN_WEIGHT_SUM.
+ * @tparam Pixels The type of the container of the pixels.
+ * @tparam Visitor The type of the visitor, void(size_t index).
+ * @param pixel The pixel.
+ * @param pixels The pixels, not empty.
+ * @param visitor The visitor of the indices of the nearest pixels.
+ */
+template <typename Pixels, typename Visitor>
+inline void forEachNearestPixel(const Pixel &pixel, const Pixels &pixels, const Visitor &visitor)
+{
+    float minDistance = squaredDistance(pixel, pixels[0]);
+    for (size_t j = 1; j < pixels.size(); ++j)
+    {
+        minDistance = std::min(minDistance, squaredDistance(pixel, pixels[j]));
+    }
+    for (size_t j = 0; j < pixels.size(); ++j)
+    {
+        if (squaredDistance(pixel, pixels[j]) == minDistance)
+        {
+            visitor(j);
+        }
+    }
+}
+
+/**
+ * @brief Raises the given base to a non negative integer power known at compile time, using
+ *        repeated squaring which the compiler unrolls into a few multiplications.
+ * @tparam Power The power.
+ * @param base The base.
+ * @return The base raised to the power.
+ */
+template <int Power>
+inline float integerPower(const float base)
+{
+    static_assert(Power >= 0, "The power must be non negative");
+    return integerPower<Power / 2>(base * base) * ((Power % 2 == 1) ? base : 1.0f);
+}
+
+/**
+ * @brief Raises the given base to the power 0.
+ * @param base The base.
+ * @return 1.
+ */
+template <>
+inline float integerPower<0>(const float)
+{
+    return 1.0f;
+}
+
+
+/*-----=  Class Definitions  =-----*/
+
+
+/**
+ * @brief The default weighted function, w(x,y) = 1 / (|x-y|^z + epsilon), for any z.
+ */
+class InversePowerWeight
+{
+public:
+    /**
+     * @brief A Constructor for the InversePowerWeight.
+     * @param epsilon The epsilon value of the weighted function.
+     * @param z The z value of the weighted function.
+     */
+    InversePowerWeight(const float epsilon, const float z) : _epsilon(epsilon), _z(z) {}
+
+    /**
+     * @brief Apply the weighted function on the given Pixels.
+     * @param lhs The first pixel.
+     * @param rhs The second pixel.
+     * @return The weighted value of the given pixels.
+     */
+    float operator()(const Pixel &lhs, const Pixel &rhs) const
+    {
+        return 1 / (std::pow(squaredDistance(lhs, rhs), _z / 2) + _epsilon);
+    }
+
+    /**
+     * @brief Returns the epsilon value of the weighted function.
+     * @return The epsilon value of the weighted function.
+     */
+    float getEpsilon() const { return _epsilon; }
+
+    /**
+     * @brief Returns the z value of the weighted function.
+     * @return The z value of the weighted function.
+     */
+    float getZ() const { return _z; }
+
+private:
+    float _epsilon;  // The epsilon value of the weighted function.
+    float _z;  // The z value of the weighted function.
+
+};
+
+/**
+ * @brief The default weighted function, w(x,y) = 1 / (|x-y|^z + epsilon), for an integer z
+ *        known at compile time, so |x-y|^z is folded into a few multiplications (and a square
+ *        root for an odd z) instead of a call to pow.
+ * @tparam Z The z value of the weighted function.
+ */
+template <int Z>
+class IntegerInversePowerWeight
+{
+public:
+    /**
+     * @brief A Constructor for the IntegerInversePowerWeight.
+     * @param epsilon The epsilon value of the weighted function.
+     */
+    explicit IntegerInversePowerWeight(const float epsilon) : _epsilon(epsilon) {}
+
+    /**
+     * @brief Apply the weighted function on the given Pixels.
+     * @param lhs The first pixel.
+     * @param rhs The second pixel.
+     * @return The weighted value of the given pixels.
+     */
+    float operator()(const Pixel &lhs, const Pixel &rhs) const
+    {
+        const float distance = squaredDistance(lhs, rhs);
+        const float power = (Z % 2 == 0) ? integerPower<Z / 2>(distance) :
+                                           integerPower<Z>(std::sqrt(distance));
+        return 1 / (power + _epsilon);
+    }
+
+    /**
+     * @brief Returns the epsilon value of the weighted function.
+     * @return The epsilon value of the weighted function.
+     */
+    float getEpsilon() const { return _epsilon; }
+
+    /**
+     * @brief Returns the z value of the weighted function.
+     * @return The z value of the weighted function.
+     */
+    float getZ() const { return (float) Z; }
+
+private:
+    float _epsilon;  // The epsilon value of the weighted function.
+
+};
+
+/**
+ * @brief The gaussian weighted function, w(x,y) = exp(-|x-y|^2 / (2 * sigma^2)).
+ */
+class GaussianWeight
+{
+public:
+    /**
+     * @brief A Constructor for the GaussianWeight.
+     * @param sigma The standard deviation of the weighted function.
+     */
+    explicit GaussianWeight(const float sigma) : _scale(-1 / (2 * sigma * sigma)) {}
+
+    /**
+     * @brief Apply the weighted function on the given Pixels.
+     * @param lhs The first pixel.
+     * @param rhs The second pixel.
+     * @return The weighted value of the given pixels.
+     */
+    float operator()(const Pixel &lhs, const Pixel &rhs) const
+    {
+        return std::exp(squaredDistance(lhs, rhs) * _scale);
+    }
+
+private:
+    float _scale;  // The factor of the squared distance in the exponent, -1 / (2 * sigma^2).
+
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file WeightTable.cpp
+ * @author Itai Tagar
+ *
+ * @brief A file for the WeightTable Class implementation.
+ */
+
+
+/*-----=  Includes  =-----*/
+
+
+#include "WeightTable.h"
+
+
+/*-----=  Class Implementation  =-----*/
+
+
+/**
+ * @brief A Default Constructor for the WeightTable which creates an empty table.
+ */
+WeightTable::WeightTable() : _rows(0), _cols(0)
+{
+
+}
+
+/**
+ * @brief Returns the memory used by the weights of the table.
+ * @return The number of bytes of the weights.
+ */
+size_t WeightTable::getMemorySize() const
+{
+    return _weights.size() * sizeof(float);
+}
+
+/**
+ * @brief Returns whether a table for a box of the given size is small enough to be built.
+ * @param rows The number of rows in the box of the pixels.
+ * @param cols The number of columns in the box of the pixels.
+ * @return true if the table has at most MAX_WEIGHT_TABLE_ENTRIES weights, false otherwise.
+ */
+bool WeightTable::fits(const int rows, const int cols)
+{
+    return (size_t) rows * cols <= MAX_WEIGHT_TABLE_ENTRIES;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file WeightTable.h
+ * @author Itai Tagar
+ *
+ * @brief A header file for the WeightTable Class.
+ */
+
+
+#ifndef WEIGHTTABLE_H
+#define WEIGHTTABLE_H
+
+
+/*-----=  Includes  =-----*/
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <cassert>
+#include <vector>
+#include "Pixel.h"
+
+
+/*-----=  Definitions  =-----*/
+
+
+/**
+ * @def MAX_WEIGHT_TABLE_ENTRIES 16777216
+ * @brief A Macro that sets the maximal number of weights in a table (64MB of floats).
+ */
+#define MAX_WEIGHT_TABLE_ENTRIES 16777216
+
+
+/*-----=  Class Declaration  =-----*/
+
+
+/**
+ * @brief A Class representing a lookup table of a weighted function, keyed by the absolute
+ *        offsets (|dx|,|dy|) between two pixels. The pixels sit on the integer grid, so two
+ *        pixels inside a box of the given size have one of rows * cols offsets, and the
+ *        weight of every offset is computed once instead of for every pair of pixels.
+ *        The table is a weighted function itself (see WeightFunctions.h), and it is valid
+ *        only for weighted functions which depend on (|dx|,|dy|) alone, as all the weighted
+ *        functions in WeightFunctions.h do.
+ */
+class WeightTable
+{
+public:
+    /**
+     * @brief A Default Constructor for the WeightTable which creates an empty table.
+     */
+    WeightTable();
+
+    /**
+     * @brief A Constructor for the WeightTable, which computes the weight of every offset.
+     * @tparam WeightFunction The type of the weighted function, see WeightFunctions.h.
+     * @param weightedFunction The weighted function to tabulate.
+     * @param rows The number of rows in the box of the pixels, i.e. the maximal |dx| + 1.
+     * @param cols The number of columns in the box of the pixels, i.e. the maximal |dy| + 1.
+     */
+    template <typename WeightFunction>
+    WeightTable(const WeightFunction &weightedFunction, const int rows, const int cols) :
+            _weights((size_t) rows * cols), _rows(rows), _cols(cols)
+    {
+        for (int dx = 0; dx < rows; ++dx)
+        {
+            for (int dy = 0; dy < cols; ++dy)
+            {
+                _weights[(size_t) dx * cols + dy] = weightedFunction(Pixel(), Pixel(dx, dy));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the tabulated weight of the given Pixels.
+     * @param lhs The first pixel.
+     * @param rhs The second pixel.
+     * @return The weighted value of the given pixels.
+     */
+    float operator()(const Pixel &lhs, const Pixel &rhs) const
+    {
+        const int dx = std::abs(lhs.getX() - rhs.getX());
+        const int dy = std::abs(lhs.getY() - rhs.getY());
+        assert(dx < _rows && dy < _cols);
+        return _weights[(size_t) dx * _cols + dy];
+    }
+
+    /**
+     * @brief Returns the number of rows in the table, i.e. the maximal |dx| + 1.
+     * @return The number of rows in the table.
+     */
+    int getRows() const { return _rows; }
+
+    /**
+     * @brief Returns the number of columns in the table, i.e. the maximal |dy| + 1.
+     * @return The number of columns in the table.
+     */
+    int getCols() const { return _cols; }
+
+    /**
+     * @brief Returns the memory used by the weights of the table.
+     * @return The number of bytes of the weights.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Returns whether a table for a box of the given size is small enough to be built.
+     * @param rows The number of rows in the box of the pixels.
+     * @param cols The number of columns in the box of the pixels.
+     * @return true if the table has at most MAX_WEIGHT_TABLE_ENTRIES weights, false otherwise.
+     */
+    static bool fits(const int rows, const int cols);
+
+private:
+    std::vector<float> _weights;  // The weights, row-major by |dx| and then |dy|.
+    int _rows;  // The number of rows in the table.
+    int _cols;  // The number of columns in the table.
+
+};
+
+
+#endif
\ No newline at end of file